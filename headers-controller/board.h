@@ -0,0 +1,274 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef BOARD_H_INCLUDED
+#define BOARD_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * services shared by the controlling modules in order to address a web relay array:
+ * - the URLs of its commands and of its status query (they are composed once, when the description
+ *   of the array is initialized);
+ * - composition of the URL that sets every relay at once (only for the models that support it);
+ * - download and incremental parse of the html response;
+ * - the share of every easy handle of the process (the cache of the resolved names, the TLS sessions
+ *   and, unless several threads may perform transfers, the connections);
+ * - the scheme of the URLs (http unless the arrays are addressed through https);
+ * the services bound to libcurl (the handles, the share, the scheme and the resolution) are not built
+ * with WRC_NATIVE_HTTP: the built-in transport (see http.h) feeds the response through \a B_feed
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <curl/curl.h>
+#include "wrctrl.h"
+#include "status.h"
+#include "parser.h"
+#include "parser_constants.h"
+#include "model.h"
+
+#define B_ABORTTHRESH     4096L  // minimum number of bytes, left to be downloaded, that causes a transfer to be aborted
+#define B_MAXSZSTR_HOST   254U  // maximum size of the string that contains a host: a name, an IPv4 address or a bracketed IPv6 address (the null character is included)
+#define B_MAXSZSTR_PRT      6U  // maximum size of the string that contains a port number (the null character is included)
+#define B_MAXSZSTR_URL     ((B_MAXSZSTR_HOST) + (B_MAXSZSTR_PRT) + (D_MAXLEN_PATH) + 1U) // maximum size of the string that contains a URL
+#define B_NUMURL           ((P_CST_NUMREL) * 2U + 1U)  // number of URLs composed for each array: two commands for each relay and the status query
+#define B_IDXSTAT          ((P_CST_NUMREL) * 2U)       // index of the URL of the status query
+
+typedef struct B_board {
+// model of the web relay array and its descriptor
+   enum r_mCodes b_hwMod;
+   const D_model* b_pMod;
+// size of the URL prefix (the null character is not included). The prefix is
+// either <host>/ or <host>/<port>/
+   size_t b_lenPref;
+// length of the host, the first part of the prefix
+   size_t b_lenHost;
+// the host is a name (it is neither an IPv4 nor an IPv6 address)
+   bool b_fName;
+// URL prefix (null-terminated)
+   char b_strPref[B_MAXSZSTR_URL];
+// the null-terminated URLs of the commands (the URL that turns relay i off, whose identifier
+// starts from zero, is at index 2 * i; the one that turns it on follows) and of the status query
+// (at index B_IDXSTAT). The URL of a relay that the model lacks is empty
+   char b_urls[B_NUMURL][B_MAXSZSTR_URL];
+} B_board;
+
+// the user-defined data CURLOPT_WRITEDATA
+typedef struct B_dl_data {
+// the incremental parse of the html response
+   P_respState b_resp;
+// the easy handle that performs the transfer (null with WRC_NATIVE_HTTP)
+   CURL* b_pHan;
+// number of bytes received
+   curl_off_t b_numRecv;
+// the transfer has been aborted because the status of every relay was known
+   bool b_fAborted;
+} B_dl_data;
+
+// the measurements of a transfer
+typedef struct B_xferInfo {
+// time (microseconds) elapsed from the beginning of the transfer until the name was resolved, the
+// connection was established, the first byte of the response was received and the transfer was over
+   long long b_lookupTime;
+   long long b_connTime;
+   long long b_ttfbTime;
+   long long b_totTime;
+// number of bytes of the response that have been received (the header is not included)
+   long long b_numRecv;
+// the status of every relay has been read from the response
+   bool b_fParsed;
+// the transfer opened a connection (otherwise, a kept-alive connection has been reused) and performed
+// a TLS handshake on it
+   bool b_fNewConn;
+   bool b_fHandshake;
+} B_xferInfo;
+
+/** \brief initializes the description of a web relay array
+ * \param[out] b_pBoard the description that is to be initialized
+ * \param[in] b_szStr_IPv4 size of the string holding the host (see \a B_chkHost )
+ * \param[in] b_str_IPv4 string holding the host
+ * \param[in] b_szStr_port size of the string holding a port number
+ * \param[in] b_str_port string holding a port number
+ * \param[in] b_hwMod model of the web relay array
+ * \return error code
+ * \attention the strings HAVE TO BE null-terminated. Their content is checked only for consistency
+ *
+ * the URLs of every command and of the status query are composed. One of the following error
+ * codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_incChArr ;
+ * \a wRC_Cd_invP
+ */
+int B_initBoard(B_board* restrict b_pBoard,
+                size_t b_szStr_IPv4, const char* const b_str_IPv4,
+                size_t b_szStr_port, const char* const b_str_port,
+                enum r_mCodes b_hwMod);
+
+/** \brief checks the host of a web relay array
+ * \param[in] b_lenStr length of the host
+ * \param[in] b_str the host (it does not need to be null-terminated)
+ * \return false unless the host is either:
+ *         - an IPv4 address (four decimal numbers, separated by dots);
+ *         - an IPv6 address enclosed within square brackets;
+ *         - a name: labels of letters, digits and - (which neither begins nor ends a label) separated
+ *           by dots, at most 63 characters per label and 253 characters in total
+ */
+bool B_chkHost(size_t b_lenStr, const char* b_str);
+
+/** \brief the URL that conveys a command to a web relay array
+ * \param[in] b_pBoard description of the web relay array
+ * \param[in] b_pComm a parsed command (it HAS TO either address a relay or be a status query)
+ * \return the null-terminated URL (it belongs to the description of the web relay array)
+ */
+const char* B_getUrl(const B_board* restrict b_pBoard,
+                     const P_out* restrict b_pComm);
+
+/** \brief composes the URL that sets the status of every relay of a web relay array with a single request
+ * \param[in] b_pBoard description of the web relay array
+ * \param[in] b_stat the status that is to be set
+ * \param[out] b_strUrl array that will hold the null-terminated URL
+ * \return false if the model has no such command (nothing is composed)
+ *
+ * the path is the prefix described by the model (for instance, FFE0 for the KMTronic) followed by
+ * a two-digit hexadecimal number whose least significant bit stands for relay 1
+ */
+bool B_renderMaskUrl(const B_board* restrict b_pBoard,
+                     r_stat b_stat,
+                     char b_strUrl[static B_MAXSZSTR_URL]);
+
+/** \brief sets the options shared by every transfer towards a web relay array
+ * \param[in] b_pHan an easy handle
+ * \param[in] b_pDlData the data that will receive the html response
+ * \return the code of the first curl service that failed (CURLE_OK otherwise)
+ *
+ * the html response is parsed while it is downloaded. Once the status of every relay is known,
+ * the transfer is aborted if either the size of the response is unknown or more than
+ * B_ABORTTHRESH bytes are still to be downloaded (otherwise, the rest of the response is
+ * downloaded without being parsed, so that the connection can be kept alive). The handle joins the
+ * share of the process, if it has been created (see \a B_initShare ), and follows the scheme of the
+ * process (see \a B_setTls )
+ */
+CURLcode B_prepHandle(CURL* b_pHan,
+                      B_dl_data* b_pDlData);
+
+/** \brief sets the limits of an attempt
+ * \param[in] b_pHan an easy handle
+ * \param[in] b_pPolicy the policy of the request
+ * \param[in] b_remain time (milliseconds) left before the deadline of the request (zero if the request
+ *            has no deadline)
+ * \return the code of the first curl service that failed (CURLE_OK otherwise)
+ */
+CURLcode B_setLimits(CURL* b_pHan,
+                     const L_policy* restrict b_pPolicy,
+                     unsigned long b_remain);
+
+/** \brief checks the consistency of a policy
+ * \return false if a delay exceeds L_MAX_DEADLINE, if the connection timeout is zero, if the minimum
+ *         transfer rate lacks its duration or if there are too many retries
+ */
+bool B_chkPolicy(const L_policy* restrict b_pPolicy);
+
+/** \brief the outcome of an attempt allows a retry
+ * \param[in] b_libCode the code returned by curl once the attempt was over (see \a B_chkResult )
+ * \param[in] b_resCode the response code (meaningful only if \a b_libCode is CURLE_OK)
+ *
+ * a failure to connect or to exchange data, a timeout and a server error (5xx) are transient
+ */
+bool B_isTransient(CURLcode b_libCode,
+                   long b_resCode);
+
+/** \brief the delay that precedes a retry (exponential backoff with full jitter)
+ * \param[in] b_pPolicy the policy of the request
+ * \param[in] b_numRetry number of retries already performed
+ * \param[in,out] b_pSeed state of the pseudo-random generator (it cannot be zero)
+ * \return the delay (milliseconds)
+ */
+unsigned long B_backoff(const L_policy* restrict b_pPolicy,
+                        unsigned b_numRetry,
+                        uint32_t* restrict b_pSeed);
+
+/** \brief prepares the download data for a new transfer
+ * \param[out] b_pDlData the download data
+ * \param[in] b_pBoard description of the web relay array
+ */
+void B_resetDlData(B_dl_data* b_pDlData,
+                   const B_board* restrict b_pBoard);
+
+/** \brief delivers a part of the html response to the incremental parse
+ * \param[in,out] b_pDlData the download data of the transfer
+ * \param[in] b_len number of bytes
+ * \param[in] b_buf the bytes
+ * \param[in] b_lenCont length of the whole response (-1 if it is not known)
+ * \return false if the transfer has to be aborted (see \a B_prepHandle ); \a b_fAborted is set
+ */
+bool B_feed(B_dl_data* b_pDlData,
+            size_t b_len, const char* b_buf,
+            long long b_lenCont);
+
+/** \brief reads the measurements of a transfer that is over
+ * \param[in] b_pHan the easy handle that performed the transfer
+ * \param[in] b_pDlData the download data of the transfer
+ * \param[out] b_pInfo the measurements (a time that cannot be read is zero)
+ */
+void B_readXferInfo(CURL* b_pHan,
+                    const B_dl_data* b_pDlData,
+                    B_xferInfo* restrict b_pInfo);
+
+/** \brief the outcome of a transfer
+ * \param[in] b_libCode the code returned by curl once the transfer was over
+ * \param[in] b_pDlData the download data of the transfer
+ * \return CURLE_OK if the transfer was aborted on purpose; \a b_libCode otherwise
+ */
+CURLcode B_chkResult(CURLcode b_libCode,
+                     const B_dl_data* b_pDlData);
+
+/** \brief creates the share of every easy handle of the process
+ * \param[in] b_fConn the share holds the connections as well
+ * \return false if the share cannot be created
+ * \attention curl HAS TO be initialized. libcurl does not support connections shared among threads:
+ *            \a b_fConn HAS TO be false if several threads may perform transfers
+ *
+ * the handles prepared by \a B_prepHandle share the cache of the resolved names (libcurl keeps a name
+ * for 60 s), so that a name is resolved once for every handle instead of once per handle, and the
+ * TLS sessions, so that a new connection towards an https array resumes the session of a previous
+ * one (abbreviated handshake). When the connections are shared, a connection outlives the handle
+ * that opened it and is reused by the next handle that addresses the same array. The share is
+ * protected by locks: the handles may be used by several threads. Only the first invocation creates
+ * the share (the following ones ignore \a b_fConn )
+ */
+bool B_initShare(bool b_fConn);
+
+/** \brief destroys the share of the process (nothing is done if it has not been created)
+ * \attention every handle that joined it HAS TO be cleaned up; the share cannot be created again
+ */
+void B_cleanupShare(void);
+
+/** \brief selects the scheme of the URLs of every web relay array of the process
+ * \param[in] b_fTls true addresses the arrays through https (http otherwise, the default)
+ * \param[in] b_pathCA file holding the certificates that verify the arrays (null for the bundle of
+ *            libcurl); it is meaningful only through https and HAS TO outlive every handle
+ * \attention it HAS TO be invoked before any handle is prepared
+ *
+ * the URLs do not hold their scheme: it is set by \a B_prepHandle
+ */
+void B_setTls(bool b_fTls,
+              const char* const b_pathCA);
+
+/** \brief resolves the host of a web relay array into the share of the process
+ * \param[in] b_pBoard description of the web relay array
+ * \param[in] b_connTimeout maximum duration (milliseconds) of the resolution and of the connection
+ * \return the code of the curl service that failed (CURLE_OK otherwise)
+ *
+ * libcurl resolves a name only on its way to a connection: a connection is established and closed
+ * at once, no request being sent (through https, the handshake stores the TLS session within the
+ * share). CURLE_COULDNT_RESOLVE_HOST means that the name is not known; a
+ * failure to connect does not prevent the name from being cached
+ */
+CURLcode B_resolve(const B_board* restrict b_pBoard,
+                   unsigned long b_connTimeout);
+
+#endif // BOARD_H_INCLUDED
@@ -0,0 +1,110 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef CACHE_H_INCLUDED
+#define CACHE_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * a cache of the last status read from each web relay array. An entry is valid for a
+ * configurable time (TTL) after it has been stored; the web relay arrays are identified
+ * by their URL prefix
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "status.h"
+#include "board.h"
+
+#define C_MAX_TTL  86400000UL  // maximum TTL (milliseconds)
+
+typedef struct C_entry {
+// URL prefix of the web relay array (null-terminated)
+   char c_strPref[B_MAXSZSTR_URL];
+// model of the web relay array
+   enum r_mCodes c_hwMod;
+// the last status read
+   r_stat c_stat;
+// instant (monotonic clock, nanoseconds) at which the status has been read
+   uint64_t c_tStamp;
+// the entry holds a status
+   bool c_fValid;
+} C_entry;
+
+typedef struct C_cache {
+   C_entry* c_entries;
+   size_t c_numEntries;
+   size_t c_cap;
+// validity (nanoseconds) of an entry. A null TTL disables the cache
+   uint64_t c_ttl;
+// number of lookups that have been satisfied by the cache
+   unsigned long c_numHit;
+// number of lookups that have not been satisfied by the cache
+   unsigned long c_numMiss;
+} C_cache;
+
+/** \brief initializes an empty cache
+ * \param[out] c_pCache the cache
+ * \param[in] c_ttl validity (milliseconds) of an entry (zero disables the cache)
+ */
+void C_init(C_cache* restrict c_pCache,
+            unsigned long c_ttl);
+
+/** \brief searches the status of a web relay array
+ * \param[in,out] c_pCache the cache
+ * \param[in] c_pBoard the web relay array
+ * \param[out] c_pStat the status (it is not modified on a miss)
+ * \param[out] c_pAge time (nanoseconds) elapsed since the status has been read (it may be null)
+ * \return true on a hit (a valid entry whose TTL has not elapsed)
+ *
+ * every lookup performed by an enabled cache updates either the hit or the miss counter
+ */
+bool C_lookup(C_cache* restrict c_pCache,
+              const B_board* restrict c_pBoard,
+              r_stat* restrict c_pStat,
+              uint64_t* restrict c_pAge);
+
+/** \brief searches the status of a web relay array regardless of the TTL (the counters are not updated)
+ * \param[in] c_pCache the cache
+ * \param[in] c_pBoard the web relay array
+ * \param[in] c_maxAge maximum time (nanoseconds) elapsed since the status has been read
+ * \param[out] c_pStat the status (it is not modified if there is no suitable entry)
+ * \param[out] c_pAge time (nanoseconds) elapsed since the status has been read (it may be null)
+ * \return true if a valid entry, not older than \a c_maxAge , exists
+ */
+bool C_peek(const C_cache* restrict c_pCache,
+            const B_board* restrict c_pBoard,
+            uint64_t c_maxAge,
+            r_stat* restrict c_pStat,
+            uint64_t* restrict c_pAge);
+
+/** \brief stores the status just read from a web relay array
+ * \param[in,out] c_pCache the cache
+ * \param[in] c_pBoard the web relay array
+ * \param[in] c_stat the status
+ * \return error code
+ *
+ * the status is stored even by a disabled cache (it may be needed by \a C_peek ).
+ * One of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_heapManFail
+ */
+int C_update(C_cache* restrict c_pCache,
+             const B_board* restrict c_pBoard,
+             r_stat c_stat);
+
+/** \brief discards the status of a web relay array (it has to be invoked once the status is unknown,
+ *         for instance, after a failed command)
+ */
+void C_invalidate(C_cache* restrict c_pCache,
+                  const B_board* restrict c_pBoard);
+
+/** \brief releases the resources of a cache
+ */
+void C_cleanup(C_cache* restrict c_pCache);
+
+#endif // CACHE_H_INCLUDED
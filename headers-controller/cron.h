@@ -0,0 +1,218 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef CRON_H_INCLUDED
+#define CRON_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * the entries of a schedule: a cron expression (evaluated in local time), a web relay array, a set
+ * of relays and the action performed on them. Every instant of the wall clock is expressed in
+ * nanoseconds since the epoch.
+ * A schedule table runs the entries of a schedule through an engine (see engine.h) owned by the
+ * caller, whose call-back has to hand every completed target over to \a T_complete
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+#include "board.h"
+#include "engine.h"
+#include "sched.h"
+#include "metrics.h"
+#include "parser_constants.h"
+
+#define T_MAXYEARS  8  // an expression that does not match any instant within this number of years is never due
+#define T_MAXLATE   60000000000ULL  // delay (nanoseconds) beyond which an occurrence of an entry is not run
+
+// the actions of an entry
+enum T_actions {T_act_on,     /**< the relays are turned on */
+                T_act_off,    /**< the relays are turned off */
+                T_act_pulse,  /**< the relays are turned on, then turned off once the duration has elapsed */
+                T_act_num     /**< number of actions */
+               };
+
+// a cron expression: one bit for each value of each field
+typedef struct T_spec {
+// minutes (0 - 59), hours (0 - 23), days of the month (1 - 31), months (1 - 12) and days of the week
+// (0 - 6, Sunday being 0)
+   uint64_t t_mins;
+   uint32_t t_hours;
+   uint32_t t_doms;
+   uint16_t t_mons;
+   uint8_t t_dows;
+// the day of the month or the day of the week is *: if both fields are restricted, a day matches
+// either one of them
+   bool t_fAnyDom;
+   bool t_fAnyDow;
+} T_spec;
+
+typedef struct T_entry {
+   T_spec t_spec;
+// position of the web relay array (starting from one)
+   size_t t_idxBoard;
+// the relays (bit i stands for relay i + 1)
+   unsigned char t_relays;
+   enum T_actions t_act;
+// duration (milliseconds) of a pulse
+   unsigned long t_dur;
+} T_entry;
+
+struct T_job;
+
+// a command of an entry of a schedule table (one for each relay)
+typedef struct T_command {
+// the target processed by the engine (it HAS TO be the first member)
+   E_target t_targ;
+   struct T_job* t_pJob;
+} T_command;
+
+// an entry of a schedule table
+typedef struct T_job {
+   T_entry t_ent;
+// line of the schedule that holds the entry
+   size_t t_numLine;
+   T_command t_cmds[P_CST_NUMREL];
+   unsigned t_numCmd;
+// number of commands that are not over (a pulse is over once the relay has been turned off)
+   unsigned t_numPend;
+// the next occurrence (seconds of the wall clock)
+   time_t t_tDue;
+   bool t_fDue;
+// number of runs, missed occurrences and failed commands
+   unsigned long t_numRun;
+   unsigned long t_numMissed;
+   unsigned long t_numFail;
+// largest delay (microseconds) of a run in regards to its due instant
+   uint64_t t_maxDrift;
+} T_job;
+
+typedef struct T_table {
+// the entries (allocated on the heap)
+   T_job* t_jobs;
+   size_t t_numJob;
+// the next occurrence of every entry (wall clock): a single event for each entry
+   S_heap t_due;
+// the turn off commands of the pulses (monotonic clock)
+   S_heap t_offs;
+// the metrics of the runs (the requests are recorded by the caller)
+   M_registry t_reg;
+// first error that occurred while queuing an event
+   int t_errCode;
+} T_table;
+
+/** \brief current instant of the wall clock
+ */
+uint64_t T_now(void);
+
+/** \brief parses a cron expression
+ * \param[out] t_pSpec the parsed expression
+ * \param[in] t_lenStrSpec length of the expression
+ * \param[in] t_strSpec the expression (it does not need to be null-terminated)
+ * \return error code
+ *
+ * the expression holds five fields separated by spaces: minute, hour, day of the month, month and
+ * day of the week (7 stands for Sunday as well). A field is a list of items separated by commas,
+ * each item being *, a value or a range (<first>-<last>), optionally followed by /<step>. The
+ * shorthands @yearly (@annually), @monthly, @weekly, @daily (@midnight) and @hourly are accepted.
+ * No message is printed. One of the following error codes will be returned:
+ * - \a wRC_Cd_noError ;
+ * - \a wRC_Cd_invP ;
+ * - \a wRC_Cd_wrI
+ */
+int T_parseSpec(T_spec* restrict t_pSpec,
+                size_t t_lenStrSpec, const char* const t_strSpec);
+
+/** \brief parses an entry of a schedule
+ * \param[out] t_pEntry the parsed entry
+ * \param[in] t_lenLine length of the line
+ * \param[in] t_line the line (it does not need to be null-terminated)
+ * \return error code
+ *
+ * the line has the following structure (the fields are separated by spaces):
+ * <cron expression> <array> <relay-ID>{,<relay-ID>} on|off|<duration>[<unit>]
+ * where <array> is the position of the web relay array (starting from one) and a duration (see
+ * \a P_parseDuration ) stands for a pulse. No message is printed. One of the following error codes
+ * will be returned:
+ * - \a wRC_Cd_noError ;
+ * - \a wRC_Cd_invP ;
+ * - \a wRC_Cd_wrI
+ */
+int T_parseEntry(T_entry* restrict t_pEntry,
+                 size_t t_lenLine, const char* const t_line);
+
+/** \brief the first instant matched by a cron expression that follows a given instant
+ * \param[in] t_pSpec the expression
+ * \param[in] t_after the given instant
+ * \param[out] t_pNext the first instant (the beginning of a minute, in local time)
+ * \return false if the expression does not match any instant within \a T_MAXYEARS years
+ *
+ * a local time skipped by a change of daylight saving time is not matched; a local time repeated
+ * by such a change is matched once
+ */
+bool T_next(const T_spec* restrict t_pSpec,
+            time_t t_after,
+            time_t* restrict t_pNext);
+
+/** \brief reads a schedule and computes the first occurrence of each entry
+ * \param[out] t_pTab the schedule table (released by \a T_cleanup , even if an error is returned)
+ * \param[in] t_pathSched path of the schedule
+ * \param[in] t_numBoard number of web relay arrays
+ * \param[in] t_boards the web relay arrays the entries refer to
+ * \return error code
+ *
+ * empty lines and lines beginning with # are ignored; an entry that is never due is not valid. One
+ * of the following error codes may be returned (the error message is printed on stderr):
+ * - \a wRC_Cd_noError ;
+ * - \a wRC_Cd_heapManFail ;
+ * - \a wRC_Cd_wrPPar (the schedule cannot be read or holds no entry) ;
+ * - \a wRC_Cd_wrI (an entry is not valid)
+ */
+int T_load(T_table* restrict t_pTab,
+           const char* const t_pathSched,
+           size_t t_numBoard, const B_board t_boards[]);
+
+/** \brief runs the occurrences that are due and starts the turn off commands that are due
+ * \param[in,out] t_pTab a loaded schedule table
+ * \param[in,out] t_pEng the engine of the table
+ *
+ * an occurrence is missed (a notice is printed on stderr) if it cannot be run within \a T_MAXLATE
+ * of its due instant or if the previous run of its entry is not over. An error that occurs while
+ * queuing an event is stored within \a t_errCode
+ */
+void T_run(T_table* restrict t_pTab,
+           E_engine* restrict t_pEng);
+
+/** \brief time (milliseconds) until the earliest event of the table, at most \a t_maxWait
+ */
+int T_waitTime(const T_table* restrict t_pTab,
+               int t_maxWait);
+
+/** \brief accounts for a completed target and schedules the turn off command of a pulse
+ * \param[in,out] t_pTab the schedule table
+ * \param[in] t_pTarg a target submitted by the table
+ */
+void T_complete(T_table* restrict t_pTab,
+                E_target* t_pTarg);
+
+/** \brief starts every scheduled turn off command at once, so that no relay is left on
+ */
+void T_stop(T_table* restrict t_pTab,
+            E_engine* restrict t_pEng);
+
+/** \brief prints the runs, missed occurrences, failures and next run of each entry
+ */
+void T_view(const T_table* restrict t_pTab,
+            FILE* t_pStream);
+
+/** \brief releases a schedule table
+ * \attention the engine HAS TO be cleaned up first, since its pending targets belong to the table
+ */
+void T_cleanup(T_table* restrict t_pTab);
+
+#endif // CRON_H_INCLUDED
@@ -1,6 +1,6 @@
 /**************************************/
 /* Author: Pavlo Nykolyn              */
-/* Last modification date: 21/05/2023 */
+/* Last modification date: 17/10/2026 */
 /**************************************/
 
 #ifndef CTRL_H_INCLUDED
@@ -9,43 +9,317 @@
 /**
  * \file
  * \author Pavlo Nykolyn
- * interface for the controlling services
+ * interface for the controlling services. If WRC_NATIVE_HTTP is defined, only the single, the mask and
+ * the iterative sessions are built (the other ones rely on the engine, hence on libcurl)
  */
 
+#include <stdint.h>
+#include <stdbool.h>
 #include "status.h"
 #include "parser_constants.h"
+#include "wrctrl.h"
+#include "board.h"
+#include "engine.h"
+#include "parser.h"
+#include "output.h"
 
-/** \brief performs a single operation on a relay
+#define RC_UNBOUNDED_STALE  0xFFFFFFFFFFFFFFFFULL  // the known status of an array never becomes stale
+
+// when the latency histograms are printed
+enum rC_latReports {rC_lr_none,    /**< the latency is neither measured nor printed */
+                    rC_lr_signal,  /**< once SIGUSR1 is received */
+                    rC_lr_exit     /**< once SIGUSR1 is received and at the end of the session */
+                   };
+
+// the options of a session (the status cache, the idempotent mode and the latency report apply only
+// to the single and the iterative sessions)
+typedef struct rC_opts {
+// validity (milliseconds) of the status cache (zero disables the cache)
+   unsigned long rC_statTTL;
+// a command that would not change the known status of the relays is not sent
+   bool rC_fIdem;
+// maximum age (nanoseconds) of a known status that allows a command to be skipped (RC_UNBOUNDED_STALE
+// if the status never becomes stale)
+   uint64_t rC_maxStale;
+// when the latency histograms of the requests are printed
+   enum rC_latReports rC_latRep;
+// path of the file that receives the metrics in the Prometheus text format (null disables it)
+   const char* rC_pathMetrics;
+// the format of the outcome of each operation (see output.h)
+   enum O_formats rC_outFmt;
+// the deadline, the timeouts and the retries of every request (see wrctrl.h); the failed attempts
+// are printed on stderr
+   L_policy rC_policy;
+// percentile of the recent durations of an array after which a command is hedged (zero disables
+// hedging; see E_setHedge). It applies only to the sessions driven by the engine
+   unsigned rC_hedgePct;
+// how the commands towards the same array are queued (see E_setQueue). It applies only to the
+// sessions driven by the engine
+   enum E_queueModes rC_qMode;
+// the names of the arrays are resolved before the session starts (see rC_preResolve)
+   bool rC_fPreRes;
+} rC_opts;
+
+/** \brief performs the operations of a list of mnemonic codes, in order, on the relays of an array
  * \param[in] rC_szStr_IPv4 size of the string holding an IPv4 address
  * \param[in] rC_str_IPv4 string holding an IPv4 address
  * \param[in] rC_szStr_port size of the string holding a port number
  * \param[in] rC_szStr_port string holding a port number
- * \param[in] p_strMnemCd string containing the mnemonic code
+ * \param[in] rC_numMnemCd number of mnemonic codes
+ * \param[in] rC_strMnemCds strings containing the mnemonic codes
  * \param[in] rC_hwMod model of the controlled hardware
+ * \param[in] rC_pOpts the options of the session
  * \return error code
  * \attention the string holding the IPv4 address is checked only for consistency. The validity of
  *            what it holds HAS TO BE ensured by the caller
  *            \par
  *            the strings HAVE TO BE null-terminated
  *
- * one of the following error codes may be returned:
+ * every code is parsed before any request is sent. A single easy handle is used for every code,
+ * so that the connection towards the array is kept alive; the response code and the duration of
+ * each request are printed on stdout. A failed request does not prevent the next ones; in such a
+ * case, the error code of the last failure is returned.
+ * The status read by every successful request is stored within the status cache: a status query
+ * (\a oAct_status ) issued within the TTL is answered by the cache. The hit and miss counters of an
+ * enabled cache are printed on stdout at the end.
+ * In the idempotent mode, a code that would not change the known status of its relay (a status not
+ * older than \a rC_maxStale ) is skipped; the number of skipped codes is printed on stdout at the end.
+ * Unless \a rC_latRep is \a rC_lr_none , the breakdown of each request (name lookup, connection, first
+ * byte, total and bytes received) is printed on stdout and recorded within the latency histograms of
+ * the array. The histograms are printed on stderr once SIGUSR1 is received (as soon as the current
+ * request is over) and, for \a rC_lr_exit , at the end.
+ * If \a rC_pathMetrics is not null, the metrics of the requests (see metrics.h) are written to it at
+ * the end; the file is replaced atomically.
+ * Unless \a rC_outFmt is \a O_fmt_text , a single record per code (see output.h) is written on stdout
+ * in place of the messages, the summaries and the breakdown of each request.
+ * One of the following error codes may be returned:
  * \a wRC_Cd_noError ;
+ * \a wRC_Cd_heapManFail ;
  * \a wRC_Cd_incChArr ;
  * \a wRC_Cd_wrI ;
  * \a wRC_Cd_curl
  */
 int rC_doSingleOperation(size_t rC_szStr_IPv4, const char* const rC_str_IPv4,
                          size_t rC_szStr_port, const char* const rC_str_port,
-                         const char rC_strMnemCd[static P_CST_MAXSZSTR_MNEMCD],
-                         enum r_mCodes rC_hwMod);
+                         size_t rC_numMnemCd,
+                         const char rC_strMnemCds[][P_CST_MAXSZSTR_MNEMCD],
+                         enum r_mCodes rC_hwMod,
+                         const rC_opts* restrict rC_pOpts);
+
+/** \brief sets the status of every relay of an array
+ * \param[in] rC_szStr_IPv4 size of the string holding an IPv4 address
+ * \param[in] rC_str_IPv4 string holding an IPv4 address
+ * \param[in] rC_szStr_port size of the string holding a port number
+ * \param[in] rC_str_port string holding a port number
+ * \param[in] rC_hwMod model of the controlled hardware
+ * \param[in] rC_stat the status that is to be set
+ * \param[in] rC_pOpts the options of the session (only the format of the output and the metrics file apply)
+ * \return error code
+ *
+ * the whole change is conveyed by a single request if the model supports it (KMTronic). Otherwise,
+ * the status of the relays is read and only the relays whose status differs are commanded (NC800).
+ * The outcome of the last request and the number of requests that have been sent are printed on
+ * stdout (or a single record, whose command is mask:<relays 1 to 8>). If \a rC_pathMetrics is not null,
+ * the measurements of the last request are written to it at the end. One of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_heapManFail ;
+ * \a wRC_Cd_incChArr ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_curl ;
+ * \a wRC_Cd_resp
+ */
+int rC_doMaskOperation(size_t rC_szStr_IPv4, const char* const rC_str_IPv4,
+                       size_t rC_szStr_port, const char* const rC_str_port,
+                       enum r_mCodes rC_hwMod,
+                       r_stat rC_stat,
+                       const rC_opts* restrict rC_pOpts);
 
 /** \brief same as \a rC_doSingleOperation but, provides a command line that supports multiple commands;
  *         \a quit has to be used to terminate the interactive session. There is no need to provide a
- *         mnemonic code
+ *         mnemonic code. The command \a status reads the status of the relays. The metrics file is
+ *         written after each request and the output is always meant for a person
  * \attention \a wRC_Cd_wrI is dealt with internally
  */
 int rC_doMultipleOperations(size_t rC_szStr_IPv4, const char* const rC_str_IPv4,
                             size_t rC_szStr_port, const char* const rC_str_port,
-                            enum r_mCodes rC_hwMod);
+                            enum r_mCodes rC_hwMod,
+                            const rC_opts* restrict rC_pOpts);
+
+/** \brief performs the commands of several targets concurrently (each target addresses a web relay array)
+ * \param[in] rC_numTarg number of targets
+ * \param[in,out] rC_targs the targets (each one HAS TO refer to an initialized web relay array and hold a parsed command)
+ * \param[in] rC_maxInFlight maximum number of concurrent transfers
+ * \param[in] rC_pOpts the options of the session (only the metrics file and the format of the output apply)
+ * \return error code
+ *
+ * the results of each target (or its record, whose sequence number is the position of the target) are
+ * printed on stdout as soon as they are available. The metrics file is written (atomically) at the end.
+ * A failed target does not prevent the other ones; the error code of the last failure is returned.
+ * One of the following
+ * error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_heapManFail ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_curl ;
+ * \a wRC_Cd_resp
+ */
+int rC_doConcurrentOperations(size_t rC_numTarg, E_target rC_targs[],
+                              unsigned rC_maxInFlight,
+                              const rC_opts* restrict rC_pOpts);
+
+/** \brief performs the commands of a script on the relays of an array (batch session)
+ * \param[in] rC_szStr_IPv4 size of the string holding an IPv4 address
+ * \param[in] rC_str_IPv4 string holding an IPv4 address
+ * \param[in] rC_szStr_port size of the string holding a port number
+ * \param[in] rC_str_port string holding a port number
+ * \param[in] rC_hwMod model of the controlled hardware
+ * \param[in] rC_pathScript path of the script (if it is null, the script is read from stdin)
+ * \param[in] rC_pathGroups path of the file that describes the groups (null if there is none)
+ * \param[in] rC_maxInFlight maximum number of concurrent transfers
+ * \param[in] rC_pOpts the options of the session (only the metrics file and the format of the output apply)
+ * \return error code
+ *
+ * each line of the script holds a command of the iterative session; empty lines and lines beginning
+ * with # are ignored, quit ends the script. The script is read in blocks and the commands are
+ * performed concurrently (at most \a rC_maxInFlight transfers), provided that the commands on the same
+ * relay are performed in the order of the script; a status query waits for every previous command and
+ * every following command waits for it. A single result line per command is printed on stdout, in the
+ * order of the script:
+ * <line> <command> <outcome> <duration> <status>
+ * where <command> is either on<relay-ID>, off<relay-ID> or status, <outcome> is either a response code,
+ * curl:<curl error code> or input (the line is not valid), <duration> is expressed in milliseconds and
+ * <status> holds the status of relays 1 to 8 (1 stands for on). A field that is not available is
+ * replaced by -. Unless \a rC_outFmt is \a O_fmt_text , a record (whose sequence number is the line)
+ * replaces each result line and the summary is not printed. A command followed by @<name> is sent
+ * to every member of the group (see \a G_parseGroup ), once every previous command is over, and the
+ * following commands wait for it; a result line per member, whose last field is the array, is printed
+ * in the order of the group and followed by the aggregate (the records share the line as sequence
+ * number). If \a rC_pathGroups is not null and \a rC_hwMod is \a r_numMod , no array is described and
+ * every command has to be addressed to a group. A failed command does not prevent the next ones; the error code of the last failure
+ * is returned. The metrics file is written (atomically) at most once per second while the script is
+ * running and at the end. One of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_heapManFail ;
+ * \a wRC_Cd_wrPPar (either the script or the groups cannot be read);
+ * \a wRC_Cd_incChArr ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_curl ;
+ * \a wRC_Cd_resp ;
+ * \a wRC_Cd_wrI
+ */
+int rC_doBatchOperations(size_t rC_szStr_IPv4, const char* const rC_str_IPv4,
+                         size_t rC_szStr_port, const char* const rC_str_port,
+                         enum r_mCodes rC_hwMod,
+                         const char* const rC_pathScript,
+                         const char* const rC_pathGroups,
+                         unsigned rC_maxInFlight,
+                         const rC_opts* restrict rC_pOpts);
+
+/** \brief pulses several relays of several web relay arrays (each relay is turned on, then turned off once
+ *         the duration of its pulse has elapsed)
+ * \param[in] rC_numBoard number of web relay arrays
+ * \param[in] rC_boards the web relay arrays (each one HAS TO be initialized)
+ * \param[in] rC_numPulse number of pulses
+ * \param[in] rC_pulses the pulses (every pulse is applied to every array)
+ * \param[in] rC_maxInFlight maximum number of concurrent transfers
+ * \param[in] rC_pOpts the options of the session (only the metrics file and the format of the output apply)
+ * \return error code
+ *
+ * the pulses overlap: every turn on command is sent at once and each turn off command is scheduled
+ * (on the monotonic clock) when the related turn on command completes. Once every pulse is over, the
+ * following data are printed on stdout for each pulse:
+ * - the width (the time elapsed between the completion of the turn on and turn off commands);
+ * - the jitter (the delay between the instant at which the turn off command was due and the
+ *   instant at which it was started);
+ * - the last status of the relays;
+ * unless \a rC_outFmt is \a O_fmt_text , a record is written as soon as each command completes (its
+ * sequence number identifies the pulse) in place of the report. The metrics file is written (atomically) at most once per second while the pulses are running and at
+ * the end. A failed command does not prevent the other ones (a turn off command is sent even if its turn
+ * on command failed); the error code of the last failure is returned. One of the following error codes
+ * may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_heapManFail ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_curl ;
+ * \a wRC_Cd_resp
+ */
+int rC_doPulseOperations(size_t rC_numBoard, const B_board rC_boards[],
+                         size_t rC_numPulse, const P_pulse rC_pulses[],
+                         unsigned rC_maxInFlight,
+                         const rC_opts* restrict rC_pOpts);
+
+/** \brief serves the commands of several web relay arrays on a Unix domain socket, until SIGINT or
+ *         SIGTERM is received
+ * \param[in] rC_numBoard number of web relay arrays
+ * \param[in] rC_boards the web relay arrays (each one HAS TO be initialized)
+ * \param[in] rC_pathSock path of the socket (a stale socket is replaced, the socket is removed at the end)
+ * \param[in] rC_maxInFlight maximum number of concurrent transfers
+ * \param[in] rC_pOpts the options of the session (only the metrics file and the format of the output apply)
+ * \return error code
+ *
+ * the connections towards the arrays are established at start-up and kept open, so that a command
+ * costs a single HTTP round trip. Each line sent by a client is a request:
+ * - <array> <mnemonic code>, where <array> is the position of the array (starting from one);
+ * - metrics: the metrics of the daemon in the Prometheus text format, terminated by # EOF;
+ * - quit: the connection is closed once the pending responses have been sent;
+ * the response to a command is a record (\a O_fmt_raw , unless \a rC_outFmt selects another machine
+ * format) whose sequence number is the position of the request within the connection. The requests
+ * are processed concurrently, hence the responses may not follow the order of the requests. One of
+ * the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_heapManFail ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_wrPPar (the socket could not be created) ;
+ * \a wRC_Cd_curl
+ */
+int rC_doDaemonOperations(size_t rC_numBoard, const B_board rC_boards[],
+                          const char* const rC_pathSock,
+                          unsigned rC_maxInFlight,
+                          const rC_opts* restrict rC_pOpts);
+
+/** \brief runs the entries of a schedule on several web relay arrays, until SIGINT or SIGTERM is received
+ * \param[in] rC_numBoard number of web relay arrays
+ * \param[in] rC_boards the web relay arrays (each one HAS TO be initialized)
+ * \param[in] rC_pathSched path of the schedule (see \a T_parseEntry ; empty lines and lines beginning
+ *                         with # are ignored)
+ * \param[in] rC_maxInFlight maximum number of concurrent transfers
+ * \param[in] rC_pOpts the options of the session (only the metrics file and the format of the output apply)
+ * \return error code
+ *
+ * the next occurrence of each entry (in local time) is queued within a binary min-heap ordered by the
+ * wall clock, the turn off commands of the pulses within one ordered by the monotonic clock: hundreds
+ * of entries cost a single process and a few comparisons per run. An occurrence is missed if it
+ * cannot be run within a minute of its due instant (the process was stopped or the wall clock moved
+ * forward) or if the previous run of its entry is not over. The drift (the delay of each run) and
+ * the missed occurrences are exported along with the metrics of the requests and printed on stderr,
+ * along with the latency histograms, once SIGUSR1 is received. Unless \a rC_outFmt is \a O_fmt_text ,
+ * a record is written as soon as each command completes (its sequence number is the line of the
+ * entry). On exit, the relays that are being pulsed are turned off at once. One of the following
+ * error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_heapManFail ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_wrPPar (the schedule cannot be read or holds no entry) ;
+ * \a wRC_Cd_wrI (an entry is not valid) ;
+ * \a wRC_Cd_curl
+ */
+int rC_doCronOperations(size_t rC_numBoard, const B_board rC_boards[],
+                        const char* const rC_pathSched,
+                        unsigned rC_maxInFlight,
+                        const rC_opts* restrict rC_pOpts);
+
+/** \brief resolves the names of several arrays into the share of the process (see \a B_resolve )
+ * \param[in] rC_numBoard number of arrays
+ * \param[in] rC_boards the arrays
+ * \param[in] rC_pOpts the options of the session (only the connection timeout and the format of the
+ *            output apply)
+ *
+ * each name is resolved once; the addresses are skipped. A name that cannot be resolved is reported
+ * on stderr, while the session is not prevented (its commands towards the name fail as usual). If
+ * \a rC_outFmt is \a O_fmt_text , the number of names, the failures and the duration are printed on
+ * stdout
+ */
+void rC_preResolve(size_t rC_numBoard, const B_board rC_boards[],
+                   const rC_opts* restrict rC_pOpts);
 
 #endif // CTRL_H_INCLUDED
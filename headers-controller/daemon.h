@@ -0,0 +1,144 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef DAEMON_H_INCLUDED
+#define DAEMON_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * a daemon that serves the commands of several web relay arrays on a Unix domain socket. Its clients
+ * send a request per line and receive a record per command; the commands are processed by an engine
+ * (see engine.h) owned by the caller, whose call-back has to hand every completed target over to
+ * \a N_complete
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "board.h"
+#include "engine.h"
+#include "metrics.h"
+#include "output.h"
+
+#define N_MAXCLI    32U  // maximum number of clients connected at once
+#define N_MAXREQ  1024U  // maximum number of requests processed at once
+#define N_SZIN     256U  // size of the buffer that holds the requests of a client that have not been processed
+#define N_NOCLI   ((size_t) -1)  // a request that does not come from a client (the warm-up of a connection)
+
+// a client of a daemon
+typedef struct N_client {
+// the connection (-1 if the slot is free)
+   int n_fd;
+// incremented whenever the slot is released: the responses of a former client are discarded
+   unsigned n_gen;
+// the requests that have not been processed
+   char n_in[N_SZIN];
+   size_t n_lenIn;
+// the responses that have not been sent (n_posOut characters have been sent)
+   char* n_out;
+   size_t n_lenOut;
+   size_t n_posOut;
+   size_t n_capOut;
+// number of requests received (the sequence number of the last one) and being processed
+   size_t n_numReq;
+   size_t n_numPend;
+// no request is read anymore (end of the input or quit); the connection is closed once every
+// response has been sent
+   bool n_fQuit;
+// the rest of an overlong request has to be discarded
+   bool n_fSkip;
+} N_client;
+
+// a request of a daemon
+typedef struct N_request {
+// the target processed by the engine (it HAS TO be the first member)
+   E_target n_targ;
+// the client that sent the request (N_NOCLI for a warm-up) and its generation
+   size_t n_idxCli;
+   unsigned n_gen;
+// sequence number of the request
+   size_t n_seq;
+// the next free request of the pool
+   struct N_request* n_pNextFree;
+} N_request;
+
+typedef struct N_daemon {
+// the format of the responses
+   enum O_formats n_fmt;
+   size_t n_numBoard;
+   const B_board* n_boards;
+// the metrics of the requests (recorded by the caller)
+   M_registry n_reg;
+// the listening socket and its path
+   int n_lsn;
+   const char* n_pathSock;
+   N_client n_clis[N_MAXCLI];
+   size_t n_numCli;
+// the pool of requests and its free list
+   N_request* n_reqs;
+   N_request* n_pFree;
+// counters reported at the end
+   unsigned long n_numAcc;
+   unsigned long n_numReq;
+} N_daemon;
+
+/** \brief initializes a daemon and creates its listening socket
+ * \param[out] n_pDmn the daemon (released by \a N_cleanup , even if an error is returned)
+ * \param[in] n_numBoard number of web relay arrays
+ * \param[in] n_boards the web relay arrays (each one HAS TO be initialized)
+ * \param[in] n_pathSock path of the socket (a stale socket is replaced, the socket is removed by \a N_cleanup )
+ * \param[in] n_fmt the format of the responses (\a O_fmt_text stands for \a O_fmt_raw )
+ * \return error code
+ *
+ * one of the following error codes may be returned (the error message is printed on stderr):
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_heapManFail ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_wrPPar (the socket could not be created)
+ */
+int N_init(N_daemon* restrict n_pDmn,
+           size_t n_numBoard, const B_board n_boards[],
+           const char* const n_pathSock,
+           enum O_formats n_fmt);
+
+/** \brief submits a status query to each web relay array, so that its connection is established at once
+ * \param[in,out] n_pDmn an initialized daemon
+ * \param[in,out] n_pEng the engine of the daemon
+ *
+ * the outcome of each query is printed on stdout by \a N_complete
+ */
+void N_warmUp(N_daemon* restrict n_pDmn,
+              E_engine* restrict n_pEng);
+
+/** \brief waits for the activity of either the clients or the engine (at most \a n_timeout
+ *         milliseconds) and processes it: the connections are accepted, the requests are read and
+ *         submitted to the engine and the pending responses are sent
+ * \return error code
+ *
+ * a client is not read while the pool of requests is empty or its buffer is full. One of the following
+ * error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_curl
+ */
+int N_step(N_daemon* restrict n_pDmn,
+           E_engine* restrict n_pEng,
+           int n_timeout);
+
+/** \brief sends the response to a completed target and releases its request
+ * \param[in,out] n_pDmn the daemon
+ * \param[in] n_pTarg a target submitted by the daemon
+ *
+ * the response to a client that has gone away is discarded
+ */
+void N_complete(N_daemon* restrict n_pDmn,
+                E_target* n_pTarg);
+
+/** \brief closes the clients and the listening socket and releases the pool of requests and the metrics
+ * \attention the engine HAS TO be cleaned up first, since its pending targets belong to the pool
+ */
+void N_cleanup(N_daemon* restrict n_pDmn);
+
+#endif // DAEMON_H_INCLUDED
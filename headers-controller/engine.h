@@ -0,0 +1,293 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef ENGINE_H_INCLUDED
+#define ENGINE_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * an engine that drives the commands of several web relay arrays concurrently (it relies upon
+ * the multi interface of libcurl). Every target is bounded by the policy of the engine (see
+ * \a L_policy ): a transient failure is retried once its backoff has elapsed, without blocking
+ * the other targets.
+ * Hedging is opt-in: an attempt that has not been answered within a percentile of the recent
+ * durations of its array is duplicated on a fresh connection and the first answer is taken (the
+ * commands are absolute, hence a duplicate is harmless).
+ * The targets of the same array may be serialized (an array that serves a single connection at a
+ * time is never sent two requests at once); a queued relay command may then be superseded by a
+ * later command on the same relay (last writer wins)
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <curl/curl.h>
+#include "wrctrl.h"
+#include "board.h"
+#include "parser.h"
+#include "sched.h"
+
+#define E_DEF_MAXINFLIGHT    8U  // default maximum number of concurrent transfers
+#define E_MAX_MAXINFLIGHT  256U  // upper bound of the maximum number of concurrent transfers
+#define E_HEDGE_WINDOW      64U  // number of recent durations of each array from which the delay of a hedge is drawn
+#define E_HEDGE_MINSAMP     16U  // an array is not hedged until this number of durations has been measured
+#define E_MIN_HEDGEPCT      50U  // bounds of the percentile that delays a hedge
+#define E_MAX_HEDGEPCT      99U
+
+// how the targets of the same web relay array are queued
+enum E_queueModes {E_qm_none,      /**< the targets of an array are sent concurrently */
+                   E_qm_serial,    /**< a single target of an array is processed at a time, in order of submission */
+                   E_qm_coalesce,  /**< as E_qm_serial; moreover, a queued relay command is superseded by a later
+                                        command on the same relay, unless a status query lies between them */
+                   E_qm_num        /**< number of modes */
+                  };
+
+typedef struct E_target {
+// web relay array that has to be commanded (it may be shared among several targets)
+   const B_board* e_pBoard;
+// parsed command
+   P_out e_comm;
+// RESULTS
+// error code of the operation
+   int e_errCode;
+// curl error code (meaningful only if e_errCode is wRC_Cd_curl)
+   CURLcode e_libCode;
+// response code of the request
+   long e_resCode;
+// status of the relays (meaningful only if e_resCode is 200)
+   r_stat e_stat;
+// measurements of the transfer (meaningful only if the transfer has been started)
+   B_xferInfo e_info;
+// the attempts of the command, the last one being described by the fields above as well
+   unsigned e_numAttempt;
+   L_attempt e_attempts[L_MAXATTEMPTS];
+// an attempt of the command has been hedged; the hedge answered first (e_info describes the hedge)
+   bool e_fHedged;
+   bool e_fHedgeWon;
+// the command has been superseded while it was queued (no request has been sent; see E_qm_coalesce)
+   bool e_fCoalesced;
+// time (nanoseconds) elapsed from the submission until the first attempt
+   uint64_t e_queueTime;
+// number of targets of the same array that were ahead of the target once it was submitted (only
+// for a serialized engine)
+   size_t e_depth;
+// INTERNAL DATA (managed by the engine)
+// instant (monotonic clock) at which the target has been submitted
+   uint64_t e_tSubmit;
+// instant (monotonic clock) at which the first attempt and the current attempt started
+   uint64_t e_tStart;
+   uint64_t e_tAttempt;
+// instant (monotonic clock) at which the current attempt is hedged (zero if it is not)
+   uint64_t e_tHedge;
+   CURL* e_pHan;
+// the URL of the command (it belongs to the description of the web relay array)
+   const char* e_strUrl;
+   B_dl_data e_dlData;
+// the hedge of the current attempt (null if it has not been sent)
+   CURL* e_pHedge;
+   B_dl_data e_hedgeDl;
+// links of either the FIFO of queued targets, the queue of an array or the list of active targets
+   struct E_target* e_pNext;
+   struct E_target* e_pPrev;
+} E_target;
+
+// invoked each time a target has been processed (its results are valid)
+typedef void (*E_doneCb)(E_target* e_pTarg,
+                         void* e_uD);
+
+// the state of the engine that concerns a web relay array (identified by its URL prefix)
+typedef struct E_perBoard {
+// the first description of the array that has been met
+   const B_board* e_pBoard;
+// the recent durations (microseconds) of the answered attempts, a circular buffer (recorded only
+// if hedging is enabled)
+   uint32_t e_durs[E_HEDGE_WINDOW];
+   unsigned e_numDur;
+   unsigned e_next;
+// a target of the array is being processed; the targets that wait for it (FIFO, only for a
+// serialized engine)
+   bool e_fBusy;
+   E_target* e_pHead;
+   E_target* e_pTail;
+   size_t e_depth;
+} E_perBoard;
+
+typedef struct E_engine {
+   CURLM* e_pMHan;
+// maximum number of concurrent transfers
+   unsigned e_maxInFlight;
+// current number of concurrent transfers
+   unsigned e_numInFlight;
+// targets whose transfer is active
+   E_target* e_pActive;
+// targets waiting for a free transfer slot (FIFO)
+   E_target* e_pHead;
+   E_target* e_pTail;
+// targets waiting for their backoff to elapse, ordered by the instant of their retry
+   S_heap e_retries;
+// the limits of the commands
+   L_policy e_policy;
+// state of the generator of the jitter of the backoff
+   uint32_t e_seed;
+// percentile of the recent durations of an array after which an attempt is hedged (zero disables
+// hedging)
+   unsigned e_hedgePct;
+// how the targets of the same array are queued
+   enum E_queueModes e_qMode;
+// the state of each array (an array is added once it is needed)
+   E_perBoard* e_boards;
+   size_t e_numBoards;
+   size_t e_capBoards;
+   E_doneCb e_doneCb;
+   void* e_uD;
+} E_engine;
+
+/** \brief initializes an engine
+ * \param[out] e_pEng the engine that is to be initialized
+ * \param[in] e_maxInFlight maximum number of concurrent transfers (it has to belong to [1, E_MAX_MAXINFLIGHT])
+ * \param[in] e_doneCb call-back invoked for each processed target (it may be null)
+ * \param[in] e_uD user-defined data passed to the call-back
+ * \return error code
+ *
+ * the policy of the engine is the default one (see \a L_defPolicy ). One of the following error
+ * codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_curl
+ */
+int E_init(E_engine* restrict e_pEng,
+           unsigned e_maxInFlight,
+           E_doneCb e_doneCb,
+           void* e_uD);
+
+/** \brief sets the policy of the targets submitted afterwards
+ * \param[in,out] e_pEng an initialized engine
+ * \param[in] e_pPolicy the policy (it is copied; see \a L_setPolicy for its constraints)
+ * \return error code
+ *
+ * one of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_invP
+ */
+int E_setPolicy(E_engine* restrict e_pEng,
+                const L_policy* restrict e_pPolicy);
+
+/** \brief enables or disables hedging
+ * \param[in,out] e_pEng an initialized engine
+ * \param[in] e_hedgePct the percentile (it has to belong to [E_MIN_HEDGEPCT, E_MAX_HEDGEPCT]; zero
+ *            disables hedging)
+ * \return error code
+ *
+ * once hedging is enabled, the durations of the answered attempts are recorded for each array. An
+ * attempt that lasts longer than the given percentile of the last E_HEDGE_WINDOW durations of its
+ * array (at least E_HEDGE_MINSAMP of them) is duplicated on a fresh connection; the first request
+ * that is answered wins and the other one is aborted. A failed request whose twin is still running
+ * is ignored. A hedge does not take a transfer slot. One of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_invP
+ */
+int E_setHedge(E_engine* restrict e_pEng,
+               unsigned e_hedgePct);
+
+/** \brief sets how the targets of the same web relay array are queued
+ * \param[in,out] e_pEng an initialized engine without pending targets
+ * \param[in] e_qMode the mode
+ * \return error code
+ *
+ * a coalesced target is processed at once: it is notified before the target that superseded it is
+ * over. One of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_invP
+ */
+int E_setQueue(E_engine* restrict e_pEng,
+               enum E_queueModes e_qMode);
+
+/** \brief submits a target. The transfer is started as soon as a slot is available
+ * \param[in,out] e_pEng an initialized engine
+ * \param[in,out] e_pTarg the target (it HAS TO remain valid until it has been processed)
+ * \return error code
+ * \attention a target that cannot be started is processed immediately; its error code
+ *            describes the failure (\a wRC_Cd_heapManFail if the array of a serialized engine
+ *            could not be tracked)
+ *
+ * one of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_invP
+ */
+int E_submit(E_engine* restrict e_pEng,
+             E_target* e_pTarg);
+
+/** \brief waits for network activity (at most \a e_timeout milliseconds) and processes the completed transfers
+ * \return error code
+ *
+ * one of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_curl
+ */
+int E_step(E_engine* restrict e_pEng,
+           int e_timeout);
+
+/** \brief same as \a E_step but, the wait is also interrupted by the activity of other file descriptors
+ * \param[in,out] e_pEng an initialized engine
+ * \param[in] e_timeout maximum time (milliseconds) spent waiting
+ * \param[in,out] e_extraFds the file descriptors and the events that are awaited (the events that
+ *                 occurred are returned through \a revents )
+ * \param[in] e_numExtra number of file descriptors
+ * \return error code
+ *
+ * one of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_curl
+ */
+int E_stepFds(E_engine* restrict e_pEng,
+              int e_timeout,
+              struct curl_waitfd e_extraFds[],
+              unsigned e_numExtra);
+
+/** \brief sets the number of connections kept alive by an engine once their transfers are over
+ * \param[in,out] e_pEng an initialized engine
+ * \param[in] e_numConn number of connections (by default, libcurl keeps four connections for each
+ *                      transfer in progress, hence an idle engine may close them)
+ * \return error code
+ *
+ * one of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_curl
+ */
+int E_keepConns(E_engine* restrict e_pEng,
+                unsigned e_numConn);
+
+/** \brief number of targets that have not been processed yet
+ */
+size_t E_pending(const E_engine* restrict e_pEng);
+
+/** \brief aborts every pending target and releases the resources of an engine
+ */
+void E_cleanup(E_engine* restrict e_pEng);
+
+/** \brief processes an array of targets, keeping at most \a e_maxInFlight transfers active
+ * \param[in] e_pPolicy the policy of the targets (null selects the default one)
+ * \param[in] e_hedgePct the percentile that delays a hedge (zero disables hedging; see \a E_setHedge )
+ * \param[in] e_qMode how the targets of the same array are queued (see \a E_setQueue )
+ * \return error code
+ *
+ * the error code of each target is stored within the target itself. One of the following
+ * error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_heapManFail ;
+ * \a wRC_Cd_curl
+ */
+int E_run(size_t e_numTarg, E_target e_targs[],
+          unsigned e_maxInFlight,
+          const L_policy* restrict e_pPolicy,
+          unsigned e_hedgePct,
+          enum E_queueModes e_qMode,
+          E_doneCb e_doneCb,
+          void* e_uD);
+
+#endif // ENGINE_H_INCLUDED
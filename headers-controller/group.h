@@ -0,0 +1,77 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef GROUP_H_INCLUDED
+#define GROUP_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * the named groups of web relay arrays. A command addressed to a group (<command> @<name>) is sent
+ * to every member of the group
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "board.h"
+
+#define G_MAXLEN_NAME  31U  // maximum length of the name of a group
+#define G_PREFIX       '@'  // precedes the name of a group within a command
+
+typedef struct G_group {
+// name of the group (null-terminated)
+   char g_name[G_MAXLEN_NAME + 1];
+// the members (allocated on the heap)
+   B_board* g_boards;
+   size_t g_numBoard;
+} G_group;
+
+/** \brief parses a group
+ * \param[out] g_pGroup the parsed group (released by \a G_cleanup )
+ * \param[in] g_lenLine length of the line
+ * \param[in] g_line the line (it does not need to be null-terminated)
+ * \return error code
+ *
+ * the line has the following structure (the fields are separated by spaces):
+ * <name> <array>{ <array>}
+ * where <name> is made of letters, digits, - and _ and <array> is <host>;[<port>];<model> (as for
+ * the --targets key; see \a B_chkHost ). No message is printed. One of the following error codes will be returned:
+ * - \a wRC_Cd_noError ;
+ * - \a wRC_Cd_invP ;
+ * - \a wRC_Cd_wrI ;
+ * - \a wRC_Cd_heapManFail
+ */
+int G_parseGroup(G_group* restrict g_pGroup,
+                 size_t g_lenLine, const char* const g_line);
+
+/** \brief splits a command addressed to a group
+ * \param[in] g_lenLine length of the line
+ * \param[in] g_line the line (it does not need to be null-terminated)
+ * \param[out] g_pLenComm length of the command (the trailing spaces are excluded)
+ * \param[out] g_ppName the name of the group (it belongs to the line)
+ * \param[out] g_pLenName length of the name
+ * \return false if the last field of the line is not preceded by \a G_PREFIX (the outputs are not
+ *         modified)
+ */
+bool G_splitComm(size_t g_lenLine, const char* g_line,
+                 size_t* restrict g_pLenComm,
+                 const char** g_ppName,
+                 size_t* restrict g_pLenName);
+
+/** \brief looks for a group
+ * \param[in] g_numGroup number of groups
+ * \param[in] g_groups the groups
+ * \param[in] g_lenName length of the name
+ * \param[in] g_strName the name (it does not need to be null-terminated)
+ * \return the group (CST_PVOID if there is none)
+ */
+const G_group* G_find(size_t g_numGroup, const G_group g_groups[],
+                      size_t g_lenName, const char* const g_strName);
+
+/** \brief releases the members of a group
+ */
+void G_cleanup(G_group* restrict g_pGroup);
+
+#endif // GROUP_H_INCLUDED
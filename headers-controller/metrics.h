@@ -0,0 +1,249 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef METRICS_H_INCLUDED
+#define METRICS_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * metrics of the requests sent to each web relay array:
+ * - counters of requests, response codes other than 200, curl errors (by CURLcode), responses whose
+ *   status could not be parsed and bytes received;
+ * - the last status of the relays;
+ * - latency histograms. The phases of a request (name lookup, connection, first byte, total) are
+ *   recorded within log-linear histograms (HDR-style): each power of two is split into M_NUMSUB linear
+ *   buckets, hence the relative error of a percentile does not exceed 1 / M_NUMSUB;
+ * the metrics can be printed as a report or exported in the Prometheus text format. The web relay
+ * arrays are identified by their URL prefix. A registry may also hold the runs of the entries of a
+ * schedule: the number of runs, the number of missed occurrences and the drift (the delay of each
+ * run in regards to its due instant). When the requests towards an array are serialized, the time
+ * spent by a request waiting for the array, the largest number of requests ahead of a request and
+ * the number of commands superseded before being sent (coalesced) are recorded as well. The requests
+ * that opened a connection, and those among them that performed a TLS handshake, are counted apart
+ * from the requests served by a kept-alive connection
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "status.h"
+#include "board.h"
+
+#define M_SUBBITS   5U                                          // bits of the linear part of a bucket
+#define M_NUMSUB    (1U << (M_SUBBITS))                         // number of linear buckets of each power of two
+#define M_MAXMSB    39U                                         // most significant bit of the largest value (about twelve days, in microseconds)
+#define M_NUMBUCK   (((M_MAXMSB) - (M_SUBBITS) + 2U) * (M_NUMSUB))  // number of buckets of a histogram
+#define M_NUMLIBCD  128U                                        // number of curl error codes that are counted separately (the larger ones share the last counter)
+#define M_NUMRESCD    8U                                        // number of slots of the response codes other than 200 (the last one is shared by the codes that do not fit, as code 0)
+
+// the phases of a request (each one is measured from the beginning of the request)
+enum M_phases {M_ph_lookup,  /**< the name has been resolved */
+               M_ph_conn,    /**< the connection has been established */
+               M_ph_ttfb,    /**< the first byte of the response has been received */
+               M_ph_total,   /**< the request is over */
+               M_ph_num      /**< number of phases */
+              };
+
+typedef struct M_hist {
+// number of recorded values
+   uint64_t m_num;
+// smallest and largest recorded values (microseconds)
+   uint64_t m_min;
+   uint64_t m_max;
+// sum of the recorded values (microseconds)
+   uint64_t m_sum;
+   uint32_t m_counts[M_NUMBUCK];
+} M_hist;
+
+// the measurements of a single request
+typedef struct M_sample {
+// duration (microseconds) of each phase
+   long long m_times[M_ph_num];
+// number of bytes of the response that have been received
+   long long m_numBytes;
+// curl error code (CURLE_OK if the request yielded a response code)
+   int m_libCode;
+// response code
+   long m_resCode;
+// status of the relays (meaningful only if m_resCode is 200 and m_fParsed is true)
+   r_stat m_stat;
+// the status of every relay has been read from the response
+   bool m_fParsed;
+// number of attempts that failed and have been retried (the measurements describe the last attempt)
+   unsigned m_numRetry;
+// the request has been hedged; the hedge answered first
+   bool m_fHedged;
+   bool m_fHedgeWon;
+// the command has been superseded before being sent (only m_depth is meaningful)
+   bool m_fCoalesced;
+// the request opened a connection (otherwise, a kept-alive connection has been reused) and performed
+// a TLS handshake on it
+   bool m_fNewConn;
+   bool m_fHandshake;
+// time (microseconds) elapsed from the submission until the first attempt (a negative value is not
+// recorded)
+   long long m_queueTime;
+// number of requests towards the same array that were ahead of the request
+   unsigned long m_depth;
+} M_sample;
+
+// a response code other than 200 and the number of its occurrences
+typedef struct M_resCount {
+   long m_resCode;
+   unsigned long m_num;
+} M_resCount;
+
+typedef struct M_board {
+// URL prefix of the web relay array (null-terminated)
+   char m_strPref[B_MAXSZSTR_URL];
+// model of the web relay array
+   enum r_mCodes m_hwMod;
+// number of requests
+   unsigned long m_numReq;
+// number of requests that did not yield a response code
+   unsigned long m_numFail;
+// number of retries (see L_policy)
+   unsigned long m_numRetry;
+// number of hedged requests and of hedges that answered first (see E_setHedge)
+   unsigned long m_numHedge;
+   unsigned long m_numHedgeWon;
+// number of commands superseded before being sent (see E_qm_coalesce)
+   unsigned long m_numCoal;
+// number of requests that opened a connection, that performed a TLS handshake and that have been
+// answered through a kept-alive connection
+   unsigned long m_numConn;
+   unsigned long m_numHandshake;
+   unsigned long m_numReuse;
+// largest number of requests that were ahead of a request
+   unsigned long m_maxDepth;
+// number of requests that failed within curl, for each curl error code
+   unsigned long m_numLibErr[M_NUMLIBCD];
+// response codes other than 200: m_numResCd distinct codes, the last slot gathers the codes that do not fit
+   M_resCount m_resCounts[M_NUMRESCD];
+   unsigned m_numResCd;
+// number of responses (code 200) whose status could not be parsed
+   unsigned long m_numParseFail;
+// number of bytes received
+   uint64_t m_numBytes;
+// the last status read from the array
+   r_stat m_stat;
+   bool m_fStat;
+   M_hist m_hists[M_ph_num];
+// time (microseconds) spent by each request before its first attempt
+   M_hist m_queue;
+} M_board;
+
+// the runs of the entries of a schedule
+typedef struct M_sched {
+// number of runs and of occurrences that have not been run
+   unsigned long m_numRun;
+   unsigned long m_numMissed;
+// delay (microseconds) of each run
+   M_hist m_drift;
+} M_sched;
+
+typedef struct M_registry {
+   M_board* m_boards;
+   size_t m_numBoards;
+   size_t m_cap;
+// the runs of a schedule (meaningful only if m_fSched is true)
+   M_sched m_sched;
+   bool m_fSched;
+} M_registry;
+
+/** \brief initializes an empty registry
+ * \param[out] m_pReg the registry
+ */
+void M_init(M_registry* restrict m_pReg);
+
+/** \brief records the measurements of a request sent to a web relay array
+ * \param[in,out] m_pReg the registry
+ * \param[in] m_pBoard the web relay array
+ * \param[in] m_pSample the measurements (a negative duration is not recorded)
+ * \return error code
+ *
+ * one of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_heapManFail (the measurements are lost)
+ */
+int M_record(M_registry* restrict m_pReg,
+             const B_board* restrict m_pBoard,
+             const M_sample* restrict m_pSample);
+
+/** \brief records a run of an entry of a schedule
+ * \param[in,out] m_pReg the registry
+ * \param[in] m_drift delay (microseconds) of the run in regards to its due instant
+ */
+void M_recordRun(M_registry* restrict m_pReg,
+                 uint64_t m_drift);
+
+/** \brief records the occurrences of an entry of a schedule that have not been run
+ * \param[in,out] m_pReg the registry
+ * \param[in] m_numMissed number of occurrences
+ */
+void M_recordMissed(M_registry* restrict m_pReg,
+                    unsigned long m_numMissed);
+
+/** \brief records a value within a histogram
+ * \param[in,out] m_pHist the histogram
+ * \param[in] m_val the value (microseconds). A value that exceeds the range is clamped
+ */
+void M_recordValue(M_hist* restrict m_pHist,
+                   uint64_t m_val);
+
+/** \brief the value below which a fraction of the recorded values lies
+ * \param[in] m_pHist the histogram
+ * \param[in] m_quant the fraction (it belongs to [0, 1])
+ * \return the upper bound (microseconds) of the bucket that holds the value (zero if the histogram is empty)
+ */
+uint64_t M_quantile(const M_hist* restrict m_pHist,
+                    double m_quant);
+
+/** \brief the smallest value held by a bucket
+ * \param[in] m_idx index of the bucket
+ * \return the value (microseconds)
+ */
+uint64_t M_lowerBound(size_t m_idx);
+
+/** \brief prints the number of requests, the number of bytes and the percentiles of each phase of
+ *         every web relay array held by a registry
+ * \param[in] m_pReg the registry
+ * \param[in] m_pStream the stream that receives the report
+ */
+void M_dump(const M_registry* restrict m_pReg,
+            FILE* m_pStream);
+
+/** \brief writes the metrics of every web relay array held by a registry in the Prometheus text format
+ * \param[in] m_pReg the registry
+ * \param[in] m_path path of the file (for instance, within the directory of the textfile collector of
+ *                   the node exporter)
+ * \return error code
+ *
+ * the file is replaced atomically: the metrics are written (and synchronized) to a temporary file of
+ * the same directory that is then renamed. One of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_heapManFail ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_wrPPar (the file cannot be written)
+ */
+int M_writeProm(const M_registry* restrict m_pReg,
+                const char* const m_path);
+
+/** \brief prints the metrics of every web relay array held by a registry in the Prometheus text format
+ * \param[in] m_pReg the registry
+ * \param[in] m_pStream the stream that receives the metrics
+ * \return false if an output error occurred
+ */
+bool M_printProm(const M_registry* restrict m_pReg,
+                 FILE* m_pStream);
+
+/** \brief releases the resources of a registry (it can be initialized again)
+ * \param[in,out] m_pReg the registry
+ */
+void M_cleanup(M_registry* restrict m_pReg);
+
+#endif // METRICS_H_INCLUDED
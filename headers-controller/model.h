@@ -0,0 +1,57 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef MODEL_H_INCLUDED
+#define MODEL_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * the registry of the supported models of web relay arrays. Each model is described once: the
+ * controlling modules never test the model itself, they read its descriptor
+ */
+
+#include <stdbool.h>
+#include "status.h"
+#include "parser.h"
+#include "parser_constants.h"
+
+#define D_MAXLEN_PATH  10U  // maximum length of the path of a command or of a status query (the URL prefix is not included)
+
+typedef struct D_model {
+// name of the model (accepted by --model and --targets; reported by the output and the metrics)
+   const char* d_name;
+// number of relays (at most P_CST_NUMREL)
+   unsigned d_numRel;
+// the URL prefix holds the port (<host>/<port>/). Otherwise, it is <host>/ (<host> is a host name, an IPv4
+// address or a bracketed IPv6 address)
+   bool d_fPort;
+// the path of the command that turns off (first column) or on (second column) each relay
+   const char* d_comm[P_CST_NUMREL][2];
+// the path of the status query (an empty path stands for the main page)
+   const char* d_stat;
+// the prefix of the path that sets every relay at once (it is followed by a two-digit hexadecimal
+// mask whose least significant bit stands for relay 1). CST_PVOID if the model has no such command
+   const char* d_mask;
+// number of relays of each row of the front panel: only the first row that holds a relay that is
+// on is described (zero if every relay is always described)
+   unsigned d_szRow;
+// the parser of the html response
+   P_respFeeder d_feed;
+} D_model;
+
+/** \brief the descriptor of a model
+ * \param[in] d_hwMod model of the web relay array
+ * \return the descriptor (CST_PVOID if the model is not supported)
+ */
+const D_model* D_getModel(enum r_mCodes d_hwMod);
+
+/** \brief obtains a model from its name
+ * \param[in] d_strName the name (null-terminated)
+ * \return the model (\a r_numMod if the name is not supported)
+ */
+enum r_mCodes D_findModel(const char* const d_strName);
+
+#endif // MODEL_H_INCLUDED
@@ -0,0 +1,82 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef OUTPUT_H_INCLUDED
+#define OUTPUT_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * machine-readable records of the operations performed on the web relay arrays. A record is
+ * formatted within a buffer and written by a single system call, so that the records of a session
+ * (or of several processes appending to the same file) are never interleaved
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "status.h"
+#include "board.h"
+
+#define O_MAXSZCOMM   16U   // maximum size of the string that describes a command (the null character is included)
+#define O_MAXSZREC   512U   // maximum size of a formatted record
+
+// the formats of the output of a session
+enum O_formats {O_fmt_text,  /**< messages meant for a person (a record is not used) */
+                O_fmt_json,  /**< a JSON object per line */
+                O_fmt_tsv,   /**< tab-separated values, the status being a string of 0 and 1 */
+                O_fmt_raw,   /**< space-separated values, the duration in microseconds and the status in hexadecimal */
+                O_fmt_num    /**< number of formats */
+               };
+
+// the outcome of an operation
+typedef struct O_record {
+// sequence number of the operation within the session (the line of the script for a batch session)
+   size_t o_seq;
+// the web relay array (null if the operation does not refer to a known array)
+   const B_board* o_pBoard;
+// the command (for instance, on3, off3, status or mask:10100000). A null string stands for a command
+// that could not be parsed
+   const char* o_strComm;
+// response code (zero if no request has been sent or no response has been received)
+   long o_resCode;
+// curl error code (CURLE_OK if the request yielded a response code)
+   int o_libCode;
+// duration (microseconds) of the request (negative if no request has been sent)
+   long long o_time;
+// status of the relays (meaningful only if o_fStat is true)
+   r_stat o_stat;
+   bool o_fStat;
+// number of attempts of the request (meaningful only if a request has been sent; zero stands for one)
+   unsigned o_numAttempt;
+} O_record;
+
+/** \brief describes a command of a web relay array
+ * \param[in] o_pComm the command (either a relay command or a status query)
+ * \param[out] o_strComm the description (on<relay-ID>, off<relay-ID> or status)
+ */
+void O_describeComm(const P_out* restrict o_pComm,
+                    char o_strComm[static O_MAXSZCOMM]);
+
+/** \brief formats a record
+ * \param[in] o_fmt the format (it cannot be \a O_fmt_text )
+ * \param[in] o_pRec the record
+ * \param[out] o_strRec the formatted record (null-terminated, the new line character is included)
+ * \return length of the formatted record (zero if the format is not supported)
+ */
+size_t O_format(enum O_formats o_fmt,
+                const O_record* restrict o_pRec,
+                char o_strRec[static O_MAXSZREC]);
+
+/** \brief formats a record and writes it on a file descriptor by a single system call
+ * \param[in] o_fmt the format (nothing is written for \a O_fmt_text )
+ * \param[in] o_pRec the record
+ * \param[in] o_fd the file descriptor
+ * \return false if the record could not be written
+ */
+bool O_emit(enum O_formats o_fmt,
+            const O_record* restrict o_pRec,
+            int o_fd);
+
+#endif // OUTPUT_H_INCLUDED
@@ -0,0 +1,81 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef SCHED_H_INCLUDED
+#define SCHED_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * a queue of timed events (a binary min-heap ordered by deadline). Every instant is expressed in
+ * nanoseconds of the monotonic clock
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define S_NSPERMS  1000000ULL  // nanoseconds per millisecond
+
+typedef struct S_event {
+// instant at which the event is due
+   uint64_t s_deadline;
+// user-defined data
+   void* s_pData;
+} S_event;
+
+typedef struct S_heap {
+   S_event* s_evts;
+// number of queued events
+   size_t s_numEvts;
+// capacity of the array of events
+   size_t s_cap;
+} S_heap;
+
+/** \brief current instant of the monotonic clock
+ */
+uint64_t S_now(void);
+
+/** \brief initializes an empty queue
+ */
+void S_init(S_heap* restrict s_pHeap);
+
+/** \brief queues an event
+ * \return error code
+ *
+ * one of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_heapManFail
+ */
+int S_push(S_heap* restrict s_pHeap,
+           uint64_t s_deadline,
+           void* s_pData);
+
+/** \brief copies the earliest event without removing it
+ * \return false if the queue is empty
+ */
+bool S_peek(const S_heap* restrict s_pHeap,
+            S_event* restrict s_pEvt);
+
+/** \brief removes the earliest event
+ * \param[out] s_pEvt the removed event (it may be null)
+ * \return false if the queue is empty
+ */
+bool S_pop(S_heap* restrict s_pHeap,
+           S_event* restrict s_pEvt);
+
+/** \brief milliseconds (rounded up) until the earliest event is due
+ * \param[in] s_maxWait value returned if the queue is empty
+ * \return zero if the earliest event is already due
+ */
+int S_waitTime(const S_heap* restrict s_pHeap,
+               int s_maxWait);
+
+/** \brief releases the resources of a queue
+ */
+void S_cleanup(S_heap* restrict s_pHeap);
+
+#endif // SCHED_H_INCLUDED
@@ -1,6 +1,6 @@
 /**************************************/
 /* Author: Pavlo Nykolyn              */
-/* Last modification date: 23/01/2023 */
+/* Last modification date: 17/10/2026 */
 /**************************************/
 
 #ifndef STATUS_H_INCLUDED
@@ -30,6 +30,8 @@ enum r_mCodes {r_kmTronic,  /**< KMTronic web relay */
 #define R_ON_7     0x04
 #define R_ON_8     0x08
 #define R_DEF      0x00  // DEFAULT state: All relays are off
+// ON status of the relay whose identifier (starting from zero) is r_rID
+#define R_ON_MASK(r_rID)  ((r_stat) ((r_rID) < 4 ? 0x10U << (r_rID) : 0x01U << ((r_rID) - 4)))
 // only for NC800
 #define R_1R_MASK  0xF0  // mask for the relays positioned on the first row
 #define R_2R_MASK  0x0F  // mask for the relays positioned on the second row
@@ -1,6 +1,6 @@
 /**************************************/
 /* Author: Pavlo Nykolyn              */
-/* Last modification date: 17/01/2023 */
+/* Last modification date: 17/10/2026 */
 /**************************************/
 
 #ifndef ERR_CODES_H_INCLUDED
@@ -13,7 +13,7 @@
  */
 
 #define WRC_CDS_NUMCRITERR     1  // number of critical errors
-#define WRC_CDS_NUMNONCRITERR  5  // number of non-critical errors
+#define WRC_CDS_NUMNONCRITERR  6  // number of non-critical errors
 
 enum {wRC_Cd_heapManFail = -WRC_CDS_NUMCRITERR, /**< heap manipulation failure */
       wRC_Cd_noError = 0,                       /**< no error */
@@ -21,6 +21,7 @@ enum {wRC_Cd_heapManFail = -WRC_CDS_NUMCRITERR, /**< heap manipulation failure *
       wRC_Cd_incChArr,                          /**< inconsistent character array (either its size is non-zero and the array is not valid or the opposite is true) */
       wRC_Cd_invP,                              /**< a function parameter is not valid */
       wRC_Cd_curl,                              /**< curl encountered an error condition */
+      wRC_Cd_resp,                              /**< a web relay array answered with a response code other than 200 */
       wRC_Cd_wrI = WRC_CDS_NUMNONCRITERR,       /**< the user provided the wrong input in the iterative session */
      };
 
@@ -1,6 +1,6 @@
 /**************************************/
 /* Author: Pavlo Nykolyn              */
-/* Last modification date: 24/01/2023 */
+/* Last modification date: 17/10/2026 */
 /**************************************/
 
 #ifndef ERR_MESSAGES_H_INCLUDED
@@ -19,6 +19,13 @@
 #define WRC_MSG_WRPPAR       "[ERR] wrong program parameter\n"
 #define WRC_MSG_WRUSRI       "[ERR] wrong user input\n"
 #define WRC_MSG_UNSCEH       "[ERR] unsuccessful creation of a curl easy handle\n"
+#define WRC_MSG_UNSCMH       "[ERR] unsuccessful management of a curl multi handle\n"
+#define WRC_MSG_NOSCRIPT     "[ERR] unable to open the script\n"
+#define WRC_MSG_NOMETRICS    "[ERR] unable to write the metrics file\n"
+#define WRC_MSG_NOOUTPUT     "[ERR] unable to write a record\n"
+#define WRC_MSG_NOSOCKET     "[ERR] unable to listen on the socket\n"
+#define WRC_MSG_NOSCHED      "[ERR] unable to read the schedule (or it holds no entry)\n"
+#define WRC_MSG_NOGROUPS     "[ERR] unable to read the groups (or none is defined)\n"
 #define WRC_MSG_HLPROT       "[ERR] libcurl does not supported at least one required protocol\n"
 
 #endif // ERR_MESSAGES_H_INCLUDED
@@ -0,0 +1,109 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef HTTP_H_INCLUDED
+#define HTTP_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * the built-in transport (the alternative to libcurl selected by WRC_NATIVE_HTTP): a minimal HTTP/1.1
+ * client that covers exactly the requests sent to a web relay array, a GET of a URL without scheme
+ * (<host>/<path>) on port 80. The connection is kept alive among the requests and each step (connection,
+ * transmission, reception) is bounded through non-blocking sockets. The responses may be delimited by
+ * their length, chunked or delimited by the end of the connection. The outcome of a request is described
+ * by the codes of libcurl (only its header is needed), so that the controlling modules do not tell the
+ * two transports apart
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <curl/curl.h>
+
+#define H_MAXSZHOST    256U  // maximum size of the string that contains a host (the null character is included)
+#define H_SZBUF       8192U  // size of the buffer that receives a response (the header has to fit within it)
+#define H_PORT         "80"  // the arrays are addressed on the default port of http
+
+/** \brief receives a part of the body of a response
+ * \param[in] h_uD the user-defined data given to \a H_get
+ * \param[in] h_len number of bytes
+ * \param[in] h_buf the bytes
+ * \param[in] h_lenCont length of the whole body (-1 if it is not known)
+ * \return false aborts the request (the connection is closed and CURLE_WRITE_ERROR is returned)
+ */
+typedef bool (*H_sink)(void* h_uD,
+                       size_t h_len, const char* h_buf,
+                       long long h_lenCont);
+
+// a connection towards a web relay array
+typedef struct H_conn {
+// the socket (-1 if there is no connection)
+   int h_fd;
+// the host the connection leads to (null-terminated)
+   char h_host[H_MAXSZHOST];
+// the bytes received and not yet consumed lie in [h_pos, h_len)
+   size_t h_pos;
+   size_t h_len;
+   char h_buf[H_SZBUF];
+} H_conn;
+
+// the limits of a request (milliseconds; zero disables a limit)
+typedef struct H_limits {
+// the whole request
+   unsigned long h_timeout;
+// the establishment of a connection
+   unsigned long h_connTimeout;
+// the time spent waiting for data of the response
+   unsigned long h_idleTimeout;
+} H_limits;
+
+// the measurements of a request
+typedef struct H_times {
+// time (microseconds) elapsed from the beginning of the request until the name was resolved, the
+// connection was established, the first byte of the response was received and the request was over
+   long long h_lookupTime;
+   long long h_connTime;
+   long long h_ttfbTime;
+   long long h_totTime;
+// the request opened a connection (otherwise, the kept-alive connection has been reused)
+   bool h_fNewConn;
+} H_times;
+
+/** \brief initializes a connection (no socket is opened)
+ */
+void H_init(H_conn* restrict h_pConn);
+
+/** \brief performs a GET request
+ * \param[in,out] h_pConn the connection (it is opened, or opened again if it leads to another host or
+ *                it has been closed by the array)
+ * \param[in] h_strUrl the null-terminated URL (<host>/<path>, the host being either a name, an IPv4
+ *            address or a bracketed IPv6 address)
+ * \param[in] h_pLimits the limits of the request
+ * \param[in] h_sink the receiver of the body
+ * \param[in] h_uD the user-defined data of \a h_sink
+ * \param[out] h_pResCode the response code (zero if no response has been received)
+ * \param[out] h_pTimes the measurements
+ * \return CURLE_OK once the whole body has been received; otherwise, the libcurl code that describes
+ *         the failure (for instance, CURLE_COULDNT_RESOLVE_HOST, CURLE_COULDNT_CONNECT,
+ *         CURLE_OPERATION_TIMEDOUT, CURLE_SEND_ERROR, CURLE_RECV_ERROR, CURLE_GOT_NOTHING,
+ *         CURLE_PARTIAL_FILE, CURLE_WEIRD_SERVER_REPLY or CURLE_WRITE_ERROR)
+ *
+ * a request that fails on a kept-alive connection before any byte of the response is received is sent
+ * once more on a new connection (the array may have closed it meanwhile). The connection is closed
+ * if the request fails or if the array does not keep it alive
+ */
+CURLcode H_get(H_conn* restrict h_pConn,
+               const char* const h_strUrl,
+               const H_limits* restrict h_pLimits,
+               H_sink h_sink,
+               void* h_uD,
+               long* restrict h_pResCode,
+               H_times* restrict h_pTimes);
+
+/** \brief closes a connection (nothing is done if it is not open)
+ */
+void H_close(H_conn* restrict h_pConn);
+
+#endif // HTTP_H_INCLUDED
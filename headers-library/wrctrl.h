@@ -0,0 +1,206 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef WRCTRL_H_INCLUDED
+#define WRCTRL_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * interface of libwrctrl: the control of web relay arrays from within a process. Each web relay
+ * array is addressed through a handle; the services:
+ * - are reentrant and thread-safe (the requests on the same handle are serialized, the requests on
+ *   different handles may be performed concurrently);
+ * - do not perform any console I/O;
+ * - return the error codes defined within err_codes.h
+ * A request is bounded by the policy of its handle (see \a L_policy ): an attempt that fails because
+ * of the network or of a server error is retried, after an exponential backoff with jitter, as long
+ * as the deadline of the request allows it (the commands are absolute, hence they can be repeated)
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "status.h"
+#include "err_codes.h"
+
+// a web relay array (opaque)
+typedef struct L_board L_board;
+
+#define L_MAXATTEMPTS       8U     // maximum number of attempts of a request (the first one and its retries)
+#define L_DEF_DEADLINE   5000UL    // default deadline (milliseconds) of a request
+#define L_DEF_CONNTIME   1000UL    // default maximum duration (milliseconds) of the establishment of a connection
+#define L_DEF_LOWSPEED      1UL    // default minimum transfer rate (bytes per second)
+#define L_DEF_LOWTIME       2UL    // default time (seconds) below the minimum transfer rate that aborts an attempt
+#define L_DEF_MAXRETRY      2U     // default maximum number of retries of a request
+#define L_DEF_BACKOFF     100UL    // default base delay (milliseconds) of the backoff
+#define L_DEF_MAXBACKOFF 1000UL    // default maximum delay (milliseconds) of the backoff
+#define L_MAX_DEADLINE   86400000UL // upper bound (milliseconds) of a deadline and of the other delays
+
+// the description of a web relay array used by the controlling modules (see board.h)
+struct B_board;
+
+// the limits of the requests performed on a handle
+typedef struct L_policy {
+// maximum duration (milliseconds) of a request, every attempt and every backoff included (zero
+// disables the deadline)
+   unsigned long l_deadline;
+// maximum duration (milliseconds) of the establishment of a connection
+   unsigned long l_connTimeout;
+// an attempt whose transfer rate stays below l_lowSpeed bytes per second for l_lowTime seconds is
+// aborted (zero disables the limit)
+   unsigned long l_lowSpeed;
+   unsigned long l_lowTime;
+// maximum number of retries of a request (smaller than L_MAXATTEMPTS)
+   unsigned l_maxRetry;
+// the delay before retry n (starting from zero) is drawn uniformly from
+// [0, min(l_maxBackoff, l_backoff * 2^n)] milliseconds
+   unsigned long l_backoff;
+   unsigned long l_maxBackoff;
+} L_policy;
+
+// the outcome of an attempt
+typedef struct L_attempt {
+// response code (zero if no response has been received)
+   long l_resCode;
+// code returned by the curl service that failed (CURLE_OK otherwise)
+   int l_libCode;
+// duration (microseconds) of the attempt
+   long long l_totTime;
+} L_attempt;
+
+// the outcome of a request
+typedef struct L_result {
+// response code (zero if no response has been received)
+   long l_resCode;
+// code returned by the curl service that failed (CURLE_OK otherwise)
+   int l_libCode;
+// status of the relays (R_DEF unless the response code is 200)
+   r_stat l_stat;
+// duration (microseconds) of the request
+   long long l_totTime;
+// time (microseconds) elapsed from the beginning of the request until the name was resolved, the
+// connection was established and the first byte of the response was received (the first two are
+// almost null if a kept-alive connection has been reused)
+   long long l_lookupTime;
+   long long l_connTime;
+   long long l_ttfbTime;
+// number of bytes of the response that have been received (the header is not included)
+   long long l_numRecv;
+// the status of every relay has been read from the response
+   bool l_fParsed;
+// the last attempt opened a connection (otherwise, the kept-alive connection has been reused) and
+// performed a TLS handshake on it
+   bool l_fNewConn;
+   bool l_fHandshake;
+// the attempts of the request, the last one being described by the fields above as well
+   unsigned l_numAttempt;
+   L_attempt l_attempts[L_MAXATTEMPTS];
+} L_result;
+
+/** \brief opens a handle towards a web relay array
+ * \param[out] l_ppBoard the handle (it is null if an error occurs)
+ * \param[in] l_szStr_IPv4 size of the string holding the host (an IPv4 address, a name or a bracketed
+ *            IPv6 address)
+ * \param[in] l_str_IPv4 string holding the host
+ * \param[in] l_szStr_port size of the string holding a port number
+ * \param[in] l_str_port string holding a port number
+ * \param[in] l_hwMod model of the web relay array
+ * \return error code
+ * \attention the strings HAVE TO BE null-terminated. Their content is checked only for consistency
+ *
+ * curl is initialized by the first invocation. The connection towards the array is kept alive among
+ * the requests performed on the same handle; the handles share the cache of the resolved names and the
+ * TLS sessions (a new connection through https resumes the session of a previous one). If the library
+ * is built with WRC_NATIVE_HTTP, the requests are performed by the built-in transport (see http.h)
+ * through http only and nothing is initialized. The policy of the handle is the default one (see
+ * \a L_defPolicy ). One of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_heapManFail ;
+ * \a wRC_Cd_incChArr ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_curl
+ */
+int L_openBoard(L_board** l_ppBoard,
+                size_t l_szStr_IPv4, const char* const l_str_IPv4,
+                size_t l_szStr_port, const char* const l_str_port,
+                enum r_mCodes l_hwMod);
+
+/** \brief fills a policy with the default values (L_DEF_*)
+ */
+void L_defPolicy(L_policy* restrict l_pPolicy);
+
+/** \brief sets the policy of the requests performed on a handle
+ * \param[in] l_pBoard the handle
+ * \param[in] l_pPolicy the policy (it is copied)
+ * \return error code
+ *
+ * one of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_invP (a delay exceeds L_MAX_DEADLINE, the connection timeout is zero or there are too many
+ * retries)
+ */
+int L_setPolicy(L_board* l_pBoard,
+                const L_policy* restrict l_pPolicy);
+
+/** \brief turns a relay either on or off and reads the status of the relays
+ * \param[in] l_pBoard the handle
+ * \param[in] l_rID the relay (zero-based)
+ * \param[in] l_fAct true turns the relay on
+ * \param[out] l_pRes the outcome of the request
+ * \return error code
+ *
+ * one of the following error codes may be returned:
+ * \a wRC_Cd_noError ;
+ * \a wRC_Cd_invP ;
+ * \a wRC_Cd_curl (see \a l_libCode );
+ * \a wRC_Cd_resp (see \a l_resCode )
+ * the error code describes the last attempt
+ */
+int L_sendCommand(L_board* l_pBoard,
+                  unsigned l_rID,
+                  bool l_fAct,
+                  L_result* restrict l_pRes);
+
+/** \brief reads the status of the relays without changing it
+ * \param[in] l_pBoard the handle
+ * \param[out] l_pRes the outcome of the request
+ * \return error code
+ *
+ * the same error codes of \a L_sendCommand may be returned
+ */
+int L_readStat(L_board* l_pBoard,
+               L_result* restrict l_pRes);
+
+/** \brief sets the status of every relay of a web relay array
+ * \param[in] l_pBoard the handle
+ * \param[in] l_stat the status that is to be set
+ * \param[in] l_pCurrStat the current status of the relays (null if it is not known)
+ * \param[out] l_pRes the outcome of the last request
+ * \param[out] l_pNumReq number of requests that have been sent
+ * \return error code
+ *
+ * no request is sent if the current status is known and matches \a l_stat (in such a case, the
+ * response code is zero and \a l_stat is returned as the status of the relays). If the model has a
+ * command that sets every relay at once, a single request is sent. Otherwise, a command is sent for
+ * each relay whose status differs (the current status is read first if it is not known) and the first
+ * failure stops the sequence. The same error codes of \a L_sendCommand may be returned
+ */
+int L_setMask(L_board* l_pBoard,
+              r_stat l_stat,
+              const r_stat* l_pCurrStat,
+              L_result* restrict l_pRes,
+              unsigned* restrict l_pNumReq);
+
+/** \brief the description of the web relay array addressed by a handle (it does not change while the
+ *         handle is open)
+ */
+const struct B_board* L_getBoard(const L_board* l_pBoard);
+
+/** \brief closes a handle (a null handle is ignored)
+ * \attention no request may be in progress on the handle
+ */
+void L_closeBoard(L_board* l_pBoard);
+
+#endif // WRCTRL_H_INCLUDED
@@ -1,6 +1,6 @@
 /**************************************/
 /* Author: Pavlo Nykolyn              */
-/* Last modification date: 21/05/2023 */
+/* Last modification date: 17/10/2026 */
 /**************************************/
 
 #ifndef PARSER_H_INCLUDED
@@ -14,11 +14,13 @@
  * - web relay response;
  */
 
+#include <stddef.h>
 #include <stdbool.h>
 #include "status.h"
 #include "parser_constants.h"
 
 enum P_oActCds {oAct_quit,    /**< quits an iterative session */
+                oAct_status,  /**< reads the status of the relays (no relay is commanded) */
                 oAct_numOAct  /**< number of other actions */
                };
 
@@ -31,10 +33,54 @@ typedef struct P_out {
    enum P_oActCds p_oAct;
 } P_out;
 
-/** \brief parses an input line
+typedef struct P_pulse {
+// relay that is to be pulsed
+   int p_rID;
+// time (milliseconds) during which the relay stays on
+   unsigned long p_dur;
+} P_pulse;
+
+// states of the automaton that parses the html response of a web relay
+enum P_respStates {P_RS_LINE,  /**< looking for a marker */
+                   P_RS_SKIP,  /**< discarding characters */
+                   P_RS_SEP,   /**< the character that follows a marker */
+                   P_RS_STAT   /**< the status of the relays */
+                  };
+
+struct P_respState;
+
+// the parser of the html response of a model: it consumes a chunk of the response and updates
+// the state of the parse (see \a P_feedResp )
+typedef void (*P_respFeeder)(struct P_respState* restrict p_pState,
+                             size_t p_szChunk, const char* const p_chunk);
+
+// the state of an incremental parse of the html response of a web relay
+typedef struct P_respState {
+// the parser of the response of the model of the web relay
+   P_respFeeder p_feed;
+// current state of the automaton
+   enum P_respStates p_state;
+// number of characters of the current marker (or colour) that have been matched
+   unsigned p_numMatch;
+// number of relays whose status has been read (KMTronic)
+   unsigned p_numRel;
+// identifier of the relay that is being described (NC800)
+   char p_chID;
+// the colour of the relay that is being described is not the one of a relay that is off (NC800)
+   bool p_fDiff;
+// relays that have been described (NC800), one bit for each relay
+   unsigned char p_seen;
+// the status of the relays
+   r_stat p_stat;
+// the status of every relay is known (the rest of the response is not needed)
+   bool p_fDone;
+} P_respState;
+
+/** \brief reads an input line from stdin and parses it (see \a P_parseLine )
  * \param[in,out] p_pIntData a pointer to a structure that will contain information about the parsed command
  * \return an error code
  *
+ * the end of the input is parsed as the quit command;
  * one of the following error codes will be returned:
  * - \a wRC_Cd_noError ;
  * - \a wRC_Cd_invP ;
@@ -42,6 +88,21 @@ typedef struct P_out {
  */
 int P_parseInput(P_out* restrict p_pIntData);
 
+/** \brief parses a line holding a command of the interactive session
+ * \param[in,out] p_pIntData a pointer to a structure that will contain information about the parsed command
+ * \param[in] p_lenLine length of the line
+ * \param[in] p_line the line (it does not need to be null-terminated; it is not modified)
+ * \return an error code
+ *
+ * multiple spaces are coalesced into a single space and leading spaces are ignored. An empty line
+ * is not a valid command. One of the following error codes will be returned:
+ * - \a wRC_Cd_noError ;
+ * - \a wRC_Cd_invP ;
+ * - \a wRC_Cd_wrI
+ */
+int P_parseLine(P_out* restrict p_pIntData,
+                size_t p_lenLine, const char* const p_line);
+
 /**
  * \brief attempts to parse a mnemonic code
  * \param[in,out] p_pIntData a pointer to a structure that will contain information about the parsed mnemonic code
@@ -49,7 +110,8 @@ int P_parseInput(P_out* restrict p_pIntData);
  * \return error code
  * \warning the caller HAS TO ignore the data of the parsed mnemonic code in case an error is returned
  *
- * one of the following error codes will be returned:
+ * besides the codes that command a relay, the code status (\a oAct_status ) reads the status of the relays.
+ * One of the following error codes will be returned:
  * - \a wRC_Cd_noError ;
  * - \a wRC_Cd_invP ;
  * - \a wRC_Cd_wrI
@@ -57,21 +119,107 @@ int P_parseInput(P_out* restrict p_pIntData);
 int P_parseMnemCode(P_out* restrict p_pIntData,
                     const char p_strMnemCd[static P_CST_MAXSZSTR_MNEMCD]);
 
+/**
+ * \brief attempts to parse the description of a pulse
+ * \param[in,out] p_pPulse a pointer to a structure that will contain the parsed pulse
+ * \param[in] p_lenStrPulse length of the description
+ * \param[in] p_strPulse the description (it does not need to be null-terminated)
+ * \return error code
+ *
+ * the description has the following structure: <relay-ID>:<duration>[<unit>]
+ * where <unit> is one of ms, s (the default unit) or m. The duration shall not exceed
+ * one day. One of the following error codes will be returned:
+ * - \a wRC_Cd_noError ;
+ * - \a wRC_Cd_invP ;
+ * - \a wRC_Cd_wrI
+ */
+int P_parsePulse(P_pulse* restrict p_pPulse,
+                 size_t p_lenStrPulse, const char* const p_strPulse);
+
+/**
+ * \brief attempts to parse a duration
+ * \param[out] p_pDur the duration (milliseconds)
+ * \param[in] p_lenStrDur length of the description
+ * \param[in] p_strDur the description (it does not need to be null-terminated)
+ * \return error code
+ *
+ * the description has the following structure: <digit>{<digit>}[<unit>]
+ * where <unit> is one of ms, s (the default unit) or m. The duration shall not be zero nor exceed
+ * one day. No message is printed. One of the following error codes will be returned:
+ * - \a wRC_Cd_noError ;
+ * - \a wRC_Cd_invP ;
+ * - \a wRC_Cd_wrI
+ */
+int P_parseDuration(unsigned long* restrict p_pDur,
+                    size_t p_lenStrDur, const char* const p_strDur);
+
+/**
+ * \brief attempts to parse the status of every relay of an array
+ * \param[out] p_pStat the parsed status
+ * \param[in] p_lenStrMask length of the description
+ * \param[in] p_strMask the description (it does not need to be null-terminated)
+ * \return error code
+ *
+ * the description holds one character for each relay, from 1 to 8: 1 stands for on and 0 stands
+ * for off (for instance, 10100000 turns on relays 1 and 3 only). One of the following error codes
+ * will be returned:
+ * - \a wRC_Cd_noError ;
+ * - \a wRC_Cd_invP ;
+ * - \a wRC_Cd_wrI
+ */
+int P_parseMask(r_stat* restrict p_pStat,
+                size_t p_lenStrMask, const char* const p_strMask);
+
+/** \brief initializes an incremental parse of the html response of a web relay
+ * \param[out] p_pState the state of the parse
+ * \param[in] p_feed the parser of the response of the model of the web relay
+ */
+void P_initResp(P_respState* restrict p_pState,
+                P_respFeeder p_feed);
+
+/** \brief consumes a chunk of the html response of a web relay
+ * \param[in,out] p_pState the state of the parse
+ * \param[in] p_szChunk size of the chunk
+ * \param[in] p_chunk the chunk (it does not need to be null-terminated)
+ * \return true once the status of every relay is known
+ *
+ * a response may be split in any number of chunks; a marker may span several of them. The
+ * parse is complete once either the Status line (KMTronic) or the eight Relay-0<relay-ID>
+ * markers (NC800) have been consumed: further chunks are ignored. The status of the relays
+ * (\a p_stat) is valid at any time (the status of a relay that has not been described yet
+ * is off)
+ */
+bool P_feedResp(P_respState* restrict p_pState,
+                size_t p_szChunk, const char* const p_chunk);
+
+/** \brief the parser of the html response of the KMTronic web relay (see \a P_respFeeder )
+ *
+ * the response holds a line with the following structure: Status:<sep><0|1><sep><0|1>...
+ */
+void P_feedKMTronicResp(P_respState* restrict p_pState,
+                        size_t p_szChunk, const char* const p_chunk);
+
+/** \brief the parser of the html response of the NC800 (see \a P_respFeeder )
+ *
+ * the status of each relay follows a marker Relay-0<relay-ID>: the relay is on unless the first
+ * colour (#RRGGBB) that follows the marker is #FF0000
+ */
+void P_feedNC800Resp(P_respState* restrict p_pState,
+                     size_t p_szChunk, const char* const p_chunk);
+
 /** \brief parses the html response of a web relay
  * \param[in] p_szStrResp size of the string holding the response
  * \param[in] p_strResp string holding the response
- * \param[in] p_hwMod model of the web relay
+ * \param[in] p_feed the parser of the response of the model of the web relay
  * \return the status of the relay
  *
- * currently, the following web relays are supported:
- * - KMTronic;
- * - NC800;
+ * the whole response is consumed by a single invocation of \a P_feedResp ;
  * the status of the relay labeled one is the most significant bit of the returned value while
  * the status of the relay labeled eight is the least significant bit of the returned value;
  * bit set to 0 -> the relay is close;
  * bit set to 1 -> the relay is open
  */
 r_stat P_parseHtmlResp(size_t p_szStrResp, const char* const p_strResp,
-                       const enum r_mCodes p_hwMod);
+                       P_respFeeder p_feed);
 
 #endif // PARSER_H_INCLUDED
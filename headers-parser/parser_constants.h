@@ -1,6 +1,6 @@
 /***************************************/
 /* Author: Pavlo Nykolyn               */
-/* Last modification date:  21/05/2023 */
+/* Last modification date:  17/10/2026 */
 /***************************************/
 
 #ifndef PARSER_CONSTANTS_H_INCLUDED
@@ -14,5 +14,7 @@
 
 #define P_CST_MAXLEN_MNEMCD    7U                            // maximum length of a mnemonic code
 #define P_CST_MAXSZSTR_MNEMCD  ((P_CST_MAXLEN_MNEMCD) + 1U)  // maximum size of a string holding a mnemonic code
+#define P_CST_NUMREL           8U                            // number of relays of a web relay array
+#define P_CST_MAXDUR_PULSE     86400000UL                    // maximum duration (milliseconds) of a pulse
 
 #endif // PARSER_CONSTANTS_H_INCLUDED
@@ -0,0 +1,63 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#ifndef SCAN_H_INCLUDED
+#define SCAN_H_INCLUDED
+
+/**
+ * \file
+ * \author Pavlo Nykolyn
+ * search kernels used by the parser of the html responses. Several implementations
+ * are available:
+ * - a portable scalar one;
+ * - SSE2 and AVX2 ones (x86 processors only);
+ * the best kernel supported by the processor is selected when the program is loaded
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+
+enum K_kernels {K_scalar,     /**< portable, one byte at a time */
+                K_sse2,       /**< 16 bytes at a time */
+                K_avx2,       /**< 32 bytes at a time */
+                K_numKernels  /**< number of kernels */
+               };
+
+/** \brief selects the kernels used by the search services
+ * \param[in] k_kern the kernel
+ * \return false if the kernel is not supported by the processor (the selection is not changed)
+ * \attention the selection is not synchronized; it is meant to be performed before any parse
+ */
+bool K_select(enum K_kernels k_kern);
+
+/** \brief the kernel currently selected
+ */
+enum K_kernels K_current(void);
+
+/** \brief the name of a kernel (a null pointer is returned for an unknown kernel)
+ */
+const char* K_name(enum K_kernels k_kern);
+
+/** \brief searches a character
+ * \param[in] k_szBuf size of the buffer
+ * \param[in] k_buf the buffer
+ * \param[in] k_ch the character
+ * \return the position of the first occurrence of \a k_ch; \a k_szBuf if there is none
+ */
+size_t K_findCh(size_t k_szBuf, const char* const k_buf,
+                char k_ch);
+
+/** \brief searches a marker
+ * \param[in] k_szBuf size of the buffer
+ * \param[in] k_buf the buffer
+ * \param[in] k_lenMarker length of the marker (it HAS TO be at least 2)
+ * \param[in] k_marker the marker
+ * \return the position of the first complete occurrence of \a k_marker; \a k_szBuf if there is none
+ * \attention an occurrence that is truncated by the end of the buffer is not reported
+ */
+size_t K_findMarker(size_t k_szBuf, const char* const k_buf,
+                    size_t k_lenMarker, const char* const k_marker);
+
+#endif // SCAN_H_INCLUDED
@@ -1,10 +1,13 @@
 # Author: Pavlo Nykolyn
 # parses fields contained within the string:
-# <IPv4>;[<port>];<model>
+# <address>;[<port>];<model>
+# <address> is either an IPv4 address, a host name or an IPv6 address enclosed within square brackets;
 # <model> is the web relay model;
 NF != 3 { print "err:1" }
 # some awk versions may not support the fixed amount of matched characters
-$1 !~ /^[0-9]{1,3}(\.[0-9]{1,3}){3}$/ { print "err:2" }
+$1 ~ /^[0-9.]+$/ && $1 !~ /^[0-9]{1,3}(\.[0-9]{1,3}){3}$/ { print "err:2" }
+$1 ~ /^\[/ && $1 !~ /^\[[0-9A-Fa-f:.]+\]$/ { print "err:2" }
+$1 !~ /^[0-9.]+$/ && $1 !~ /^\[/ && ($1 !~ /^[A-Za-z0-9]([A-Za-z0-9-]*[A-Za-z0-9])?(\.[A-Za-z0-9]([A-Za-z0-9-]*[A-Za-z0-9])?)*$/ || length($1) > 253) { print "err:2" }
 $2 !~ /^[0-9]*$/ { print "err:3" }
 $2 > 65535 { print "err:3" }
 $3 !~ /KMTronic_wr/ && $3 !~ /NC800/ { print "err:4" }
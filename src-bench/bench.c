@@ -0,0 +1,428 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+// a benchmark of the parser. The following cases are measured:
+// - the html pages of a corpus (a directory whose files are named <model>-<description>.html);
+// - synthetic html pages (from 1 KiB up to an oversized page), with and without the status of the relays;
+// - the mnemonic codes (both valid and invalid ones);
+// - the lines of the interactive session (both valid and invalid ones).
+// Each html page is parsed by every search kernel supported by the processor. Every case reports
+// the time spent by a single operation, the throughput and the number of heap allocations
+// (the allocation functions are wrapped by the linker). The results may be compared against a
+// baseline (a previous output of the benchmark): a case that is slower than the tolerance allows
+// or that allocates more than before is a regression and the exit status is non-zero
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "parser.h"
+#include "parser_constants.h"
+#include "scan.h"
+#include "status.h"
+
+#define WRB_MINTIME     100000000ULL  // minimum time (nanoseconds) spent measuring a single case
+#define WRB_BATCH       16U           // number of operations between two readings of the clock
+#define WRB_NUMSIZES    4U            // number of sizes of the synthetic pages
+#define WRB_MAXSZ_NAME  128U          // maximum size of the name of a case
+#define WRB_MAXSZ_PAGE  (16U << 20)   // maximum size of a page of the corpus
+#define WRB_DEF_TOL     25.0          // default tolerance (percentage) against the baseline
+
+#define WRB_OPT_BASE  "--baseline="
+#define WRB_OPT_TOL   "--tolerance="
+
+enum wRB_kinds {wRB_html,
+                wRB_mnem,
+                wRB_line};
+
+typedef struct wRB_case {
+   enum wRB_kinds wRB_kind;
+// model of the web relay array (html pages only)
+   enum r_mCodes wRB_hwMod;
+   size_t wRB_len;
+   const char* wRB_data;
+} wRB_case;
+
+typedef struct wRB_base {
+   char wRB_name[WRB_MAXSZ_NAME];
+   double wRB_ns;
+   double wRB_allocs;
+} wRB_base;
+
+// sizes of the synthetic pages (the last one is larger than any page served by a web relay array)
+// the parser of the response of each model
+static const P_respFeeder wRB_feeds[r_numMod] = {[r_kmTronic] = P_feedKMTronicResp,
+                                                 [r_nc800] = P_feedNC800Resp};
+static const size_t wRB_sizes[WRB_NUMSIZES] = {1024U, 16384U, 262144U, 4194304U};
+static const char* wRB_sizeNames[WRB_NUMSIZES] = {"1K", "16K", "256K", "4M"};
+// a line of the page that does not describe any relay
+static const char wRB_filler[] = "<tr><td class=\"Row\">Refresh the page in order to read the Relays</td></tr>\n";
+// mnemonic codes (the storage has the size required by the parser)
+static const char wRB_mnemCds[][P_CST_MAXSZSTR_MNEMCD] = {"FF0101", "FF0800", "status", "FF0901", "FF01", "garbage"};
+// lines of the interactive session
+static const char* wRB_lines[] = {"turn on 3",
+                                  "   turn    off   8   ",
+                                  "status",
+                                  "quit",
+                                  "turn on 9",
+                                  "switch on 1",
+                                  "quit now",
+                                  ""};
+
+// counters of the heap allocations
+static unsigned long wRB_numAllocs = 0;
+// the results of the operations are accumulated in order to prevent the compiler from discarding them
+static volatile unsigned long wRB_sink = 0;
+// the cases of the baseline
+static wRB_base* wRB_bases = (wRB_base*) 0;
+static size_t wRB_numBases = 0;
+static double wRB_tol = WRB_DEF_TOL;
+static unsigned long wRB_numRegr = 0;
+// descriptor of the standard error while it is redirected
+static int wRB_fdErr = -1;
+
+void* __real_malloc(size_t wRB_sz);
+void* __real_calloc(size_t wRB_num, size_t wRB_sz);
+void* __real_realloc(void* wRB_ptr, size_t wRB_sz);
+
+void* __wrap_malloc(size_t wRB_sz)
+{
+   wRB_numAllocs++;
+   return __real_malloc(wRB_sz);
+}
+
+void* __wrap_calloc(size_t wRB_num, size_t wRB_sz)
+{
+   wRB_numAllocs++;
+   return __real_calloc(wRB_num, wRB_sz);
+}
+
+void* __wrap_realloc(void* wRB_ptr, size_t wRB_sz)
+{
+   wRB_numAllocs++;
+   return __real_realloc(wRB_ptr, wRB_sz);
+}
+
+static unsigned long long wRB_now(void)
+{
+   struct timespec wRB_ts;
+   clock_gettime(CLOCK_MONOTONIC, &wRB_ts);
+   return (unsigned long long) wRB_ts.tv_sec * 1000000000ULL + (unsigned long long) wRB_ts.tv_nsec;
+}
+
+// the parser reports invalid inputs on the standard error: it is silenced while measuring
+static void wRB_silence(bool wRB_fSilent)
+{
+   fflush(stderr);
+   if (wRB_fSilent) {
+      const int wRB_fdNull = open("/dev/null", O_WRONLY);
+      if (wRB_fdNull < 0)
+         return;
+      wRB_fdErr = dup(STDERR_FILENO);
+      dup2(wRB_fdNull, STDERR_FILENO);
+      close(wRB_fdNull);
+   }
+   else if (wRB_fdErr >= 0) {
+      dup2(wRB_fdErr, STDERR_FILENO);
+      close(wRB_fdErr);
+      wRB_fdErr = -1;
+   }
+}
+
+// a single operation (its result is returned)
+static unsigned long wRB_run(const wRB_case* restrict wRB_pCase)
+{
+   P_out wRB_out = {.p_rID = 0, .p_fAct = false, .p_oAct = oAct_numOAct};
+   switch (wRB_pCase -> wRB_kind) {
+      case wRB_html: return P_parseHtmlResp(wRB_pCase -> wRB_len, wRB_pCase -> wRB_data,
+                                            wRB_feeds[wRB_pCase -> wRB_hwMod]);
+      case wRB_mnem: return (unsigned long) P_parseMnemCode(&wRB_out,
+                                                            wRB_pCase -> wRB_data) << 8 | (unsigned long) wRB_out.p_rID;
+      case wRB_line: return (unsigned long) P_parseLine(&wRB_out,
+                                                        wRB_pCase -> wRB_len, wRB_pCase -> wRB_data) << 8 | (unsigned long) wRB_out.p_rID;
+   }
+   return 0;
+}
+
+// compares a case against the baseline (if any)
+static void wRB_compare(const char* wRB_name,
+                        double wRB_ns,
+                        double wRB_allocs)
+{
+   for (size_t i = 0; i < wRB_numBases; i++) {
+      if (strcmp(wRB_bases[i].wRB_name, wRB_name))
+         continue;
+      if (wRB_allocs > wRB_bases[i].wRB_allocs) {
+         fprintf(stderr, "[ERR] %s: %.2f allocations per operation (baseline %.2f)\n",
+                 wRB_name, wRB_allocs, wRB_bases[i].wRB_allocs);
+         wRB_numRegr++;
+      }
+      if (wRB_ns > wRB_bases[i].wRB_ns * (1.0 + wRB_tol / 100.0)) {
+         fprintf(stderr, "[ERR] %s: %.1f ns/op (baseline %.1f, tolerance %.0f%%)\n",
+                 wRB_name, wRB_ns, wRB_bases[i].wRB_ns, wRB_tol);
+         wRB_numRegr++;
+      }
+      return;
+   }
+}
+
+// measures a case and prints a line of the report (the result of the last operation is returned)
+static unsigned long wRB_measure(const char* wRB_name,
+                                 const wRB_case* restrict wRB_pCase)
+{
+   wRB_silence(true);
+   unsigned long wRB_res = wRB_run(wRB_pCase); // warm-up
+   const unsigned long wRB_allocsStart = wRB_numAllocs;
+   unsigned long long wRB_numOps = 0;
+   unsigned long long wRB_elapsed = 0;
+   const unsigned long long wRB_start = wRB_now();
+   do {
+      for (unsigned i = 0; i < WRB_BATCH; i++)
+         wRB_sink += wRB_run(wRB_pCase);
+      wRB_numOps += WRB_BATCH;
+      wRB_elapsed = wRB_now() - wRB_start;
+   } while (wRB_elapsed < WRB_MINTIME);
+   const double wRB_allocs = (double) (wRB_numAllocs - wRB_allocsStart) / (double) wRB_numOps;
+   wRB_silence(false);
+   const double wRB_ns = (double) wRB_elapsed / (double) wRB_numOps;
+   printf("%-44s %9zu %12.1f %10.1f %9.2f %8lx\n",
+          wRB_name, wRB_pCase -> wRB_len, wRB_ns,
+          (double) wRB_pCase -> wRB_len * 1000.0 / wRB_ns,
+          wRB_allocs, wRB_res);
+   wRB_compare(wRB_name,
+               wRB_ns,
+               wRB_allocs);
+   return wRB_res;
+}
+
+// measures an html page with every kernel supported by the processor
+static void wRB_measurePage(const char* wRB_prefix,
+                            const wRB_case* restrict wRB_pCase)
+{
+   char wRB_name[WRB_MAXSZ_NAME];
+   unsigned long wRB_ref = 0;
+   for (enum K_kernels k = K_scalar; k < K_numKernels; k++) {
+      if (!K_select(k))
+         continue;
+      snprintf(wRB_name, WRB_MAXSZ_NAME, "%s/%s", wRB_prefix, K_name(k));
+      const unsigned long wRB_res = wRB_measure(wRB_name,
+                                                wRB_pCase);
+      if (k == K_scalar)
+         wRB_ref = wRB_res;
+      else if (wRB_res != wRB_ref) {
+         fprintf(stderr, "[ERR] %s: the kernel disagrees with the scalar one\n", wRB_name);
+         wRB_numRegr++;
+      }
+   }
+}
+
+// appends filler lines up to (approximately) a size
+static size_t wRB_fill(char* wRB_page, size_t wRB_len, size_t wRB_upTo)
+{
+   const size_t wRB_lenFill = sizeof(wRB_filler) - 1;
+   while (wRB_len + wRB_lenFill <= wRB_upTo) {
+      memcpy(wRB_page + wRB_len, wRB_filler, wRB_lenFill);
+      wRB_len += wRB_lenFill;
+   }
+   return wRB_len;
+}
+
+// composes a page whose description of the relays (if requested) is spread over the page (it is returned by the function)
+static char* wRB_makePage(enum r_mCodes wRB_hwMod,
+                          size_t wRB_szPage,
+                          bool wRB_fStat,
+                          size_t* wRB_pLen)
+{
+   char* wRB_page = malloc(wRB_szPage + 256U);
+   if (!wRB_page)
+      return wRB_page;
+   size_t wRB_len = 0;
+   if (!wRB_fStat)
+      wRB_len = wRB_fill(wRB_page, wRB_len, wRB_szPage);
+   else {
+      switch (wRB_hwMod) {
+         case r_kmTronic: wRB_len = wRB_fill(wRB_page, wRB_len, wRB_szPage - 32U);
+                          wRB_len += sprintf(wRB_page + wRB_len, "Status: 1 0 1 0 0 1 1 0\n");
+                          break;
+         case r_nc800:    for (unsigned i = 0; i < P_CST_NUMREL; i++) {
+                             wRB_len = wRB_fill(wRB_page, wRB_len, (i + 1) * (wRB_szPage / P_CST_NUMREL) - 64U);
+                             wRB_len += sprintf(wRB_page + wRB_len, "<td>Relay-0%u</td><td bgcolor=\"#%s\">&nbsp;</td>\n",
+                                                i + 1, i % 2 ? "FF0000"
+                                                             : "00FF00");
+                          }
+                          break;
+         default:         break;
+      }
+   }
+   wRB_page[wRB_len] = '\0';
+   *wRB_pLen = wRB_len;
+   return wRB_page;
+}
+
+static int wRB_cmpNames(const void* wRB_pFst, const void* wRB_pSnd)
+{
+   return strcmp(*(char* const*) wRB_pFst, *(char* const*) wRB_pSnd);
+}
+
+// measures every page of a corpus (in alphabetical order)
+static int wRB_corpus(const char* wRB_dirPath)
+{
+   DIR* wRB_pDir = opendir(wRB_dirPath);
+   if (!wRB_pDir) {
+      fprintf(stderr, "[ERR] unable to open the corpus %s\n", wRB_dirPath);
+      return EXIT_FAILURE;
+   }
+   char** wRB_names = (char**) 0;
+   size_t wRB_numNames = 0;
+   struct dirent* wRB_pEnt;
+   while ((wRB_pEnt = readdir(wRB_pDir))) {
+      if (wRB_pEnt -> d_name[0] == '.')
+         continue;
+      char** wRB_newNames = realloc(wRB_names, (wRB_numNames + 1) * sizeof(char*));
+      if (!wRB_newNames)
+         break;
+      wRB_names = wRB_newNames;
+      wRB_names[wRB_numNames] = strdup(wRB_pEnt -> d_name);
+      if (wRB_names[wRB_numNames])
+         wRB_numNames++;
+   }
+   closedir(wRB_pDir);
+   qsort(wRB_names, wRB_numNames, sizeof(char*), wRB_cmpNames);
+   char* wRB_page = malloc(WRB_MAXSZ_PAGE);
+   for (size_t n = 0; wRB_page && n < wRB_numNames; n++) {
+      wRB_case wRB_pageCase = {.wRB_kind = wRB_html, .wRB_data = wRB_page};
+      if (!strncmp(wRB_names[n], "kmtronic-", 9))
+         wRB_pageCase.wRB_hwMod = r_kmTronic;
+      else if (!strncmp(wRB_names[n], "nc800-", 6))
+         wRB_pageCase.wRB_hwMod = r_nc800;
+      else {
+         fprintf(stderr, "[NOT] %s: unknown model (skipped)\n", wRB_names[n]);
+         continue;
+      }
+      char wRB_path[4096];
+      snprintf(wRB_path, sizeof(wRB_path), "%s/%s", wRB_dirPath, wRB_names[n]);
+      FILE* wRB_pFile = fopen(wRB_path, "rb");
+      if (!wRB_pFile) {
+         fprintf(stderr, "[NOT] %s: unable to read the page (skipped)\n", wRB_names[n]);
+         continue;
+      }
+      wRB_pageCase.wRB_len = fread(wRB_page, 1, WRB_MAXSZ_PAGE, wRB_pFile);
+      fclose(wRB_pFile);
+      char wRB_prefix[WRB_MAXSZ_NAME];
+      snprintf(wRB_prefix, WRB_MAXSZ_NAME, "corpus/%s", wRB_names[n]);
+      wRB_measurePage(wRB_prefix,
+                      &wRB_pageCase);
+   }
+   free(wRB_page);
+   for (size_t n = 0; n < wRB_numNames; n++)
+      free(wRB_names[n]);
+   free(wRB_names);
+   return EXIT_SUCCESS;
+}
+
+// reads a previous output of the benchmark
+static int wRB_loadBaseline(const char* wRB_path)
+{
+   FILE* wRB_pFile = fopen(wRB_path, "r");
+   if (!wRB_pFile) {
+      fprintf(stderr, "[ERR] unable to read the baseline %s\n", wRB_path);
+      return EXIT_FAILURE;
+   }
+   char wRB_line[512];
+   while (fgets(wRB_line, sizeof(wRB_line), wRB_pFile)) {
+      wRB_base wRB_curr;
+      if (sscanf(wRB_line, "%127s %*s %lf %*s %lf", wRB_curr.wRB_name, &wRB_curr.wRB_ns, &wRB_curr.wRB_allocs) != 3)
+         continue; // the header
+      wRB_base* wRB_newBases = realloc(wRB_bases, (wRB_numBases + 1) * sizeof(wRB_base));
+      if (!wRB_newBases)
+         break;
+      wRB_bases = wRB_newBases;
+      wRB_bases[wRB_numBases] = wRB_curr;
+      wRB_numBases++;
+   }
+   fclose(wRB_pFile);
+   return EXIT_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+   static const enum r_mCodes wRB_models[] = {r_kmTronic, r_nc800};
+   static const char* wRB_modelNames[] = {"kmtronic", "nc800"};
+   const char* wRB_dirCorpus = (const char*) 0;
+   for (int i = 1; i < argc; i++) {
+      if (!strncmp(argv[i], WRB_OPT_BASE, sizeof(WRB_OPT_BASE) - 1)) {
+         if (wRB_loadBaseline(argv[i] + sizeof(WRB_OPT_BASE) - 1))
+            return EXIT_FAILURE;
+      }
+      else if (!strncmp(argv[i], WRB_OPT_TOL, sizeof(WRB_OPT_TOL) - 1))
+         wRB_tol = strtod(argv[i] + sizeof(WRB_OPT_TOL) - 1, (char**) 0);
+      else if (argv[i][0] == '-') {
+         fprintf(stderr, "usage: %s [" WRB_OPT_BASE "<file>] [" WRB_OPT_TOL "<percentage>] [<corpus directory>]\n", argv[0]);
+         return EXIT_FAILURE;
+      }
+      else
+         wRB_dirCorpus = argv[i];
+   }
+   const enum K_kernels wRB_defKern = K_current();
+   printf("%-44s %9s %12s %10s %9s %8s\n",
+          "case", "bytes", "ns/op", "MB/s", "allocs/op", "result");
+   if (wRB_dirCorpus &&
+       wRB_corpus(wRB_dirCorpus))
+      return EXIT_FAILURE;
+   char wRB_prefix[WRB_MAXSZ_NAME];
+   for (size_t m = 0; m < sizeof(wRB_models) / sizeof(wRB_models[0]); m++) {
+      for (size_t s = 0; s < WRB_NUMSIZES; s++) {
+         for (int f = 1; f >= 0; f--) {
+            // the pages without any status are measured only at the largest size (the worst case of the parser)
+            if (!f &&
+                s != WRB_NUMSIZES - 1)
+               continue;
+            wRB_case wRB_pageCase = {.wRB_kind = wRB_html, .wRB_hwMod = wRB_models[m]};
+            char* wRB_page = wRB_makePage(wRB_models[m], wRB_sizes[s],
+                                          f,
+                                          &(wRB_pageCase.wRB_len));
+            if (!wRB_page)
+               return EXIT_FAILURE;
+            wRB_pageCase.wRB_data = wRB_page;
+            snprintf(wRB_prefix, WRB_MAXSZ_NAME, "synthetic/%s-%s%s",
+                     wRB_modelNames[m], f ? ""
+                                          : "nostatus-",
+                     wRB_sizeNames[s]);
+            wRB_measurePage(wRB_prefix,
+                            &wRB_pageCase);
+            free(wRB_page);
+         }
+      }
+   }
+   K_select(wRB_defKern);
+   for (size_t i = 0; i < sizeof(wRB_mnemCds) / sizeof(wRB_mnemCds[0]); i++) {
+      const wRB_case wRB_mnemCase = {.wRB_kind = wRB_mnem, .wRB_len = strlen(wRB_mnemCds[i]), .wRB_data = wRB_mnemCds[i]};
+      snprintf(wRB_prefix, WRB_MAXSZ_NAME, "mnemonic/%s", wRB_mnemCds[i]);
+      wRB_measure(wRB_prefix,
+                  &wRB_mnemCase);
+   }
+   for (size_t i = 0; i < sizeof(wRB_lines) / sizeof(wRB_lines[0]); i++) {
+      const wRB_case wRB_lineCase = {.wRB_kind = wRB_line, .wRB_len = strlen(wRB_lines[i]), .wRB_data = wRB_lines[i]};
+      // the spaces of the line are not part of the name of the case
+      size_t wRB_lenPref = (size_t) snprintf(wRB_prefix, WRB_MAXSZ_NAME, "line/");
+      for (size_t c = 0; wRB_lines[i][c] && wRB_lenPref < WRB_MAXSZ_NAME - 1; c++, wRB_lenPref++)
+         wRB_prefix[wRB_lenPref] = wRB_lines[i][c] == ' ' ? '_'
+                                                          : wRB_lines[i][c];
+      wRB_prefix[wRB_lenPref] = '\0';
+      if (!wRB_lines[i][0])
+         strcpy(wRB_prefix, "line/<empty>");
+      wRB_measure(wRB_prefix,
+                  &wRB_lineCase);
+   }
+   free(wRB_bases);
+   if (wRB_numRegr) {
+      fprintf(stderr, "[ERR] %lu regression(s)\n", wRB_numRegr);
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,194 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+// a benchmark of the start-up of the controller: each binary (for instance, the controller linked
+// against libcurl and the static controller built upon the built-in transport) performs the same
+// one-shot command several times. The binaries take turns, so that a change of the load of the host
+// affects all of them. The wall time of each run (from the creation of the process up to its end) is
+// measured; the first run of each binary warms up the page cache and is not counted. The output of
+// the runs is discarded, a run that does not succeed is counted as a failure
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#define WRS_DEF_RUNS   200U    // default number of runs of each binary
+#define WRS_MAX_RUNS   100000U // maximum number of runs of each binary
+#define WRS_ARG_SEP    "--"    // separates the binaries from the arguments of the command
+
+#define WRS_OPT_RUNS  "--runs="
+
+typedef struct wRS_bin {
+   const char* wRS_path;
+// duration (nanoseconds) of each run
+   unsigned long long* wRS_times;
+   unsigned wRS_numFail;
+} wRS_bin;
+
+// returns the current value of the monotonic clock (nanoseconds)
+static unsigned long long wRS_now(void);
+// runs a binary once, its standard streams being redirected to /dev/null. The duration is stored
+// within *wRS_pTime; the return value is false if the process could not be created or it did not succeed
+static bool wRS_run(char* wRS_argv[],
+                    unsigned long long* restrict wRS_pTime);
+// compares two durations (qsort)
+static int wRS_cmp(const void* wRS_pA,
+                   const void* wRS_pB);
+// prints the statistics of a binary (its durations are sorted)
+static void wRS_report(wRS_bin* restrict wRS_pBin,
+                       unsigned wRS_numRun,
+                       double wRS_refMean);
+
+int main(int argc, char* argv[])
+{
+   unsigned wRS_numRun = WRS_DEF_RUNS;
+   int wRS_first = 1;
+   if (wRS_first < argc &&
+       !strncmp(argv[wRS_first], WRS_OPT_RUNS, sizeof(WRS_OPT_RUNS) - 1)) {
+      wRS_numRun = (unsigned) strtoul(argv[wRS_first] + sizeof(WRS_OPT_RUNS) - 1, (char**) 0, 10);
+      wRS_first++;
+   }
+   int wRS_sep = wRS_first;
+   while (wRS_sep < argc &&
+          strcmp(argv[wRS_sep], WRS_ARG_SEP))
+      wRS_sep++;
+   const size_t wRS_numBin = wRS_sep - wRS_first;
+   if (!wRS_numRun ||
+       wRS_numRun > WRS_MAX_RUNS ||
+       !wRS_numBin ||
+       wRS_sep == argc) {
+      fprintf(stderr, "usage: %s [" WRS_OPT_RUNS "<n>] <binary>... " WRS_ARG_SEP " <arguments of the command>\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+   // the arguments of a run: the binary, the arguments of the command and the null terminator
+   const int wRS_numArg = argc - wRS_sep;
+   char* wRS_argv[wRS_numArg + 1];
+   memcpy(wRS_argv + 1, argv + wRS_sep + 1, (wRS_numArg - 1) * sizeof(char*));
+   wRS_argv[wRS_numArg] = (char*) 0;
+   int wRS_exitCode = EXIT_SUCCESS;
+   wRS_bin* wRS_bins = calloc(wRS_numBin, sizeof(wRS_bin));
+   if (!wRS_bins) {
+      fputs("[ERR] heap management failure\n", stderr);
+      return EXIT_FAILURE;
+   }
+   for (size_t b = 0; b < wRS_numBin; b++) {
+      wRS_bins[b].wRS_path = argv[wRS_first + b];
+      wRS_bins[b].wRS_times = calloc(wRS_numRun, sizeof(unsigned long long));
+      if (!(wRS_bins[b].wRS_times)) {
+         fputs("[ERR] heap management failure\n", stderr);
+         wRS_exitCode = EXIT_FAILURE;
+         goto WRS_MAIN_EXIT;
+      }
+      // the warm-up run: a binary that cannot be run at all stops the benchmark
+      unsigned long long wRS_time = 0;
+      wRS_argv[0] = (char*) wRS_bins[b].wRS_path;
+      if (!wRS_run(wRS_argv,
+                   &wRS_time)) {
+         fprintf(stderr, "[ERR] %s does not succeed\n", wRS_bins[b].wRS_path);
+         wRS_exitCode = EXIT_FAILURE;
+         goto WRS_MAIN_EXIT;
+      }
+   }
+   for (unsigned r = 0; r < wRS_numRun; r++) {
+      for (size_t b = 0; b < wRS_numBin; b++) {
+         wRS_argv[0] = (char*) wRS_bins[b].wRS_path;
+         if (!wRS_run(wRS_argv,
+                      wRS_bins[b].wRS_times + r))
+            wRS_bins[b].wRS_numFail++;
+      }
+   }
+   printf("%-32s %10s %10s %10s %10s %10s %8s %8s\n",
+          "binary", "size (KiB)", "min (ms)", "mean (ms)", "p50 (ms)", "p99 (ms)", "speed-up", "failures");
+   double wRS_refMean = 0.0;
+   for (size_t b = 0; b < wRS_numBin; b++) {
+      wRS_report(wRS_bins + b,
+                 wRS_numRun,
+                 wRS_refMean);
+      if (!b) {
+         for (unsigned r = 0; r < wRS_numRun; r++)
+            wRS_refMean += wRS_bins[b].wRS_times[r];
+         wRS_refMean /= wRS_numRun;
+      }
+      if (wRS_bins[b].wRS_numFail)
+         wRS_exitCode = EXIT_FAILURE;
+   }
+   WRS_MAIN_EXIT:
+   for (size_t b = 0; b < wRS_numBin; b++)
+      free(wRS_bins[b].wRS_times);
+   free(wRS_bins);
+   return wRS_exitCode;
+}
+
+static unsigned long long wRS_now(void)
+{
+   struct timespec wRS_ts;
+   clock_gettime(CLOCK_MONOTONIC, &wRS_ts);
+   return (unsigned long long) wRS_ts.tv_sec * 1000000000ULL + wRS_ts.tv_nsec;
+}
+
+static bool wRS_run(char* wRS_argv[],
+                    unsigned long long* restrict wRS_pTime)
+{
+   const unsigned long long wRS_tStart = wRS_now();
+   const pid_t wRS_pid = fork();
+   if (wRS_pid < 0)
+      return false;
+   if (!wRS_pid) {
+      const int wRS_fdNull = open("/dev/null", O_RDWR);
+      if (wRS_fdNull >= 0) {
+         dup2(wRS_fdNull, STDIN_FILENO);
+         dup2(wRS_fdNull, STDOUT_FILENO);
+         dup2(wRS_fdNull, STDERR_FILENO);
+      }
+      execv(wRS_argv[0], wRS_argv);
+      _exit(127);
+   }
+   int wRS_status = 0;
+   if (waitpid(wRS_pid, &wRS_status, 0) < 0)
+      return false;
+   *wRS_pTime = wRS_now() - wRS_tStart;
+   return WIFEXITED(wRS_status) &&
+          !WEXITSTATUS(wRS_status);
+}
+
+static int wRS_cmp(const void* wRS_pA,
+                   const void* wRS_pB)
+{
+   const unsigned long long wRS_a = *(const unsigned long long*) wRS_pA;
+   const unsigned long long wRS_b = *(const unsigned long long*) wRS_pB;
+   return (wRS_a > wRS_b) - (wRS_a < wRS_b);
+}
+
+static void wRS_report(wRS_bin* restrict wRS_pBin,
+                       unsigned wRS_numRun,
+                       double wRS_refMean)
+{
+   qsort(wRS_pBin -> wRS_times, wRS_numRun, sizeof(unsigned long long),
+         wRS_cmp);
+   double wRS_mean = 0.0;
+   for (unsigned r = 0; r < wRS_numRun; r++)
+      wRS_mean += wRS_pBin -> wRS_times[r];
+   wRS_mean /= wRS_numRun;
+   struct stat wRS_st;
+   const double wRS_size = stat(wRS_pBin -> wRS_path, &wRS_st) ? 0.0
+                                                               : wRS_st.st_size / 1024.0;
+   // the speed-up is relative to the first binary
+   printf("%-32s %10.0f %10.3f %10.3f %10.3f %10.3f %8.2f %8u\n",
+          wRS_pBin -> wRS_path,
+          wRS_size,
+          wRS_pBin -> wRS_times[0] / 1e6,
+          wRS_mean / 1e6,
+          wRS_pBin -> wRS_times[wRS_numRun / 2] / 1e6,
+          wRS_pBin -> wRS_times[(size_t) (wRS_numRun * 0.99)] / 1e6,
+          wRS_refMean > 0.0 ? wRS_refMean / wRS_mean
+                            : 1.0,
+          wRS_pBin -> wRS_numFail);
+}
@@ -0,0 +1,502 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <curl/curl.h>
+#include "board.h"
+#include "model.h"
+#include "constants.h"
+#include "err_wrapper.h"
+
+#define B_MAXLEN_LABEL  63U  // maximum length of a label of a name
+
+// composes a URL made by the prefix of a web relay array and a path (false if the path is too long)
+static bool b_compose(const B_board* restrict b_pBoard,
+                      const char* const b_path,
+                      char b_strUrl[static B_MAXSZSTR_URL]);
+// checks a name (labels separated by dots)
+static bool b_chkName(size_t b_lenStr, const char* b_str);
+
+#ifndef WRC_NATIVE_HTTP
+// the share of every easy handle of the process and the locks of the data it shares
+static CURLSH* b_pShare = CST_PVOID;
+static pthread_once_t b_onceShare = PTHREAD_ONCE_INIT;
+static pthread_mutex_t b_locks[CURL_LOCK_DATA_LAST];
+// the share holds the connections (read once, by b_initShare)
+static bool b_fShareConn = false;
+// scheme of the URLs of the process
+static const char* b_strScheme = "http";
+// the certificates that verify the arrays through https (null for the bundle of libcurl)
+static const char* b_pathCA = CST_PVOID;
+// creates the share of the process (invoked once)
+static void b_initShare(void);
+// the call-backs CURLSHOPT_LOCKFUNC and CURLSHOPT_UNLOCKFUNC
+static void b_lock(CURL* b_pHan,
+                   curl_lock_data b_data,
+                   curl_lock_access b_access,
+                   void* b_uD);
+static void b_unlock(CURL* b_pHan,
+                     curl_lock_data b_data,
+                     void* b_uD);
+
+// the call-back CURLOPT_WRITEFUNCTION
+static size_t b_dl(char* b_currBuf,
+                   size_t b_chSz, // byte size of each element of b_currBuf (HAS TO BE ONE)
+                   size_t b_currSzBuf,
+                   void* b_uD)
+{
+   if (b_chSz != 1)
+      return ~b_currSzBuf;
+   B_dl_data* b_pDlData = (B_dl_data*) b_uD;
+   curl_off_t b_lenCont = -1;
+   if (curl_easy_getinfo(b_pDlData -> b_pHan,
+                         CURLINFO_CONTENT_LENGTH_DOWNLOAD_T,
+                         &b_lenCont))
+      b_lenCont = -1;
+   return B_feed(b_pDlData,
+                 b_currSzBuf, b_currBuf,
+                 b_lenCont) ? b_currSzBuf
+                            : 0; // the transfer is aborted
+}
+#endif
+
+int B_initBoard(B_board* restrict b_pBoard,
+                size_t b_szStr_IPv4, const char* const b_str_IPv4,
+                size_t b_szStr_port, const char* const b_str_port,
+                enum r_mCodes b_hwMod)
+{
+   if (!b_pBoard)
+      return wRC_Cd_invP;
+   if (((!b_szStr_IPv4 && b_str_IPv4) ||
+        (b_szStr_IPv4 && !b_str_IPv4)) ||
+       ((!b_szStr_port && b_str_port) ||
+        (b_szStr_port && !b_str_port)))
+      return wRC_Cd_incChArr;
+   const size_t b_lenIPv4 = b_str_IPv4 ? strnlen(b_str_IPv4, b_szStr_IPv4)
+                                       : 0;
+   const size_t b_lenPort = b_str_port ? strnlen(b_str_port, b_szStr_port)
+                                       : 0;
+   const D_model* b_pMod = D_getModel(b_hwMod);
+   if (b_lenIPv4 >= B_MAXSZSTR_HOST ||
+       b_lenPort >= B_MAXSZSTR_PRT ||
+       !b_pMod ||
+       b_pMod -> d_numRel > P_CST_NUMREL)
+      return wRC_Cd_invP;
+   memset(b_pBoard, 0, sizeof(B_board));
+   b_pBoard -> b_hwMod = b_hwMod;
+   b_pBoard -> b_pMod = b_pMod;
+   memcpy(b_pBoard -> b_strPref, b_str_IPv4, b_lenIPv4);
+   b_pBoard -> b_strPref[b_lenIPv4] = '/';
+   b_pBoard -> b_lenPref = b_lenIPv4 + 1;
+   b_pBoard -> b_lenHost = b_lenIPv4;
+   b_pBoard -> b_fName = b_lenIPv4 &&
+                         *b_str_IPv4 != '[' &&
+                         strspn(b_str_IPv4, "0123456789.") != b_lenIPv4;
+   if (b_pMod -> d_fPort) {
+      memcpy(b_pBoard -> b_strPref + b_pBoard -> b_lenPref, b_str_port, b_lenPort);
+      b_pBoard -> b_lenPref += b_lenPort;
+      b_pBoard -> b_strPref[b_pBoard -> b_lenPref] = '/';
+      b_pBoard -> b_lenPref++;
+   }
+   // every URL is composed once: a command costs a lookup
+   for (unsigned i = 0; i < b_pMod -> d_numRel; i++)
+      for (unsigned j = 0; j < 2; j++)
+         if (!b_compose(b_pBoard,
+                        b_pMod -> d_comm[i][j],
+                        b_pBoard -> b_urls[2 * i + j]))
+            return wRC_Cd_invP;
+   if (!b_compose(b_pBoard,
+                  b_pMod -> d_stat,
+                  b_pBoard -> b_urls[B_IDXSTAT]))
+      return wRC_Cd_invP;
+   return wRC_Cd_noError;
+}
+
+bool B_chkHost(size_t b_lenStr, const char* b_str)
+{
+   if (!b_lenStr ||
+       b_lenStr >= B_MAXSZSTR_HOST)
+      return false;
+   char b_strHost[B_MAXSZSTR_HOST];
+   memcpy(b_strHost, b_str, b_lenStr);
+   b_strHost[b_lenStr] = '\0';
+   unsigned char b_addr[sizeof(struct in6_addr)];
+   if (*b_strHost == '[') {
+      if (b_lenStr < 3 ||
+          b_strHost[b_lenStr - 1] != ']')
+         return false;
+      b_strHost[b_lenStr - 1] = '\0';
+      return inet_pton(AF_INET6, b_strHost + 1, b_addr) == 1;
+   }
+   // a host made of digits and dots is an address, not a name
+   if (strspn(b_strHost, "0123456789.") == b_lenStr)
+      return inet_pton(AF_INET, b_strHost, b_addr) == 1;
+   return b_chkName(b_lenStr, b_strHost);
+}
+
+const char* B_getUrl(const B_board* restrict b_pBoard,
+                     const P_out* restrict b_pComm)
+{
+   if (b_pComm -> p_oAct == oAct_status)
+      return b_pBoard -> b_urls[B_IDXSTAT];
+   return b_pBoard -> b_urls[2 * b_pComm -> p_rID + (b_pComm -> p_fAct ? 1
+                                                                       : 0)];
+}
+
+bool B_renderMaskUrl(const B_board* restrict b_pBoard,
+                     r_stat b_stat,
+                     char b_strUrl[static B_MAXSZSTR_URL])
+{
+   const char* const b_strMask = b_pBoard -> b_pMod -> d_mask;
+   if (!b_strMask)
+      return false;
+   // the bits of r_stat do not follow the order of the relays
+   unsigned b_mask = 0;
+   for (unsigned i = 0; i < P_CST_NUMREL; i++)
+      if (b_stat & R_ON_MASK(i))
+         b_mask |= 1U << i;
+   memcpy(b_strUrl, b_pBoard -> b_strPref, b_pBoard -> b_lenPref);
+   snprintf(b_strUrl + b_pBoard -> b_lenPref, B_MAXSZSTR_URL - b_pBoard -> b_lenPref, "%s%02X", b_strMask, b_mask);
+   return true;
+}
+
+void B_resetDlData(B_dl_data* b_pDlData,
+                   const B_board* restrict b_pBoard)
+{
+   P_initResp(&(b_pDlData -> b_resp),
+              b_pBoard -> b_pMod -> d_feed);
+   b_pDlData -> b_numRecv = 0;
+   b_pDlData -> b_fAborted = false;
+}
+
+bool B_feed(B_dl_data* b_pDlData,
+            size_t b_len, const char* b_buf,
+            long long b_lenCont)
+{
+   b_pDlData -> b_numRecv += b_len;
+   if (b_pDlData -> b_resp.p_fDone)
+      return true; // draining the rest of the response
+   if (P_feedResp(&(b_pDlData -> b_resp),
+                  b_len, b_buf) &&
+       (b_lenCont < 0 ||
+        b_lenCont - (b_pDlData -> b_numRecv) > B_ABORTTHRESH)) {
+      b_pDlData -> b_fAborted = true;
+      return false;
+   }
+   return true;
+}
+
+#ifndef WRC_NATIVE_HTTP
+CURLcode B_prepHandle(CURL* b_pHan,
+                      B_dl_data* b_pDlData)
+{
+   b_pDlData -> b_pHan = b_pHan;
+   CURLcode b_libCode = curl_easy_setopt(b_pHan,
+                                         CURLOPT_PROTOCOLS,
+                                         CURLPROTO_HTTP | CURLPROTO_HTTPS);
+   if (b_libCode)
+      return b_libCode;
+   // the URLs have no scheme
+   b_libCode = curl_easy_setopt(b_pHan,
+                                CURLOPT_DEFAULT_PROTOCOL,
+                                b_strScheme);
+   if (b_libCode)
+      return b_libCode;
+   if (b_pathCA) {
+      b_libCode = curl_easy_setopt(b_pHan,
+                                   CURLOPT_CAINFO,
+                                   b_pathCA);
+      if (b_libCode)
+         return b_libCode;
+   }
+   if (b_pShare) {
+      b_libCode = curl_easy_setopt(b_pHan,
+                                   CURLOPT_SHARE,
+                                   b_pShare);
+      if (b_libCode)
+         return b_libCode;
+   }
+   b_libCode = curl_easy_setopt(b_pHan,
+                                CURLOPT_WRITEFUNCTION,
+                                b_dl);
+   if (b_libCode)
+      return b_libCode;
+   return curl_easy_setopt(b_pHan,
+                           CURLOPT_WRITEDATA,
+                           (void*) b_pDlData);
+}
+
+void B_readXferInfo(CURL* b_pHan,
+                    const B_dl_data* b_pDlData,
+                    B_xferInfo* restrict b_pInfo)
+{
+   static const CURLINFO b_infos[] = {CURLINFO_NAMELOOKUP_TIME_T,
+                                      CURLINFO_CONNECT_TIME_T,
+                                      CURLINFO_STARTTRANSFER_TIME_T,
+                                      CURLINFO_TOTAL_TIME_T};
+   long long* const b_times[] = {&(b_pInfo -> b_lookupTime),
+                                 &(b_pInfo -> b_connTime),
+                                 &(b_pInfo -> b_ttfbTime),
+                                 &(b_pInfo -> b_totTime)};
+   for (size_t i = 0; i < sizeof(b_infos) / sizeof(b_infos[0]); i++) {
+      curl_off_t b_time = 0;
+      if (curl_easy_getinfo(b_pHan,
+                            b_infos[i],
+                            &b_time))
+         b_time = 0;
+      *(b_times[i]) = b_time;
+   }
+   b_pInfo -> b_numRecv = b_pDlData -> b_numRecv;
+   b_pInfo -> b_fParsed = b_pDlData -> b_resp.p_fDone;
+   // a reused connection neither counts as a new one nor measures a handshake
+   long b_numConn = 0;
+   curl_off_t b_tlsTime = 0;
+   if (curl_easy_getinfo(b_pHan,
+                         CURLINFO_NUM_CONNECTS,
+                         &b_numConn))
+      b_numConn = 0;
+   if (curl_easy_getinfo(b_pHan,
+                         CURLINFO_APPCONNECT_TIME_T,
+                         &b_tlsTime))
+      b_tlsTime = 0;
+   b_pInfo -> b_fNewConn = b_numConn > 0;
+   b_pInfo -> b_fHandshake = b_numConn > 0 &&
+                             b_tlsTime > 0;
+}
+
+CURLcode B_setLimits(CURL* b_pHan,
+                     const L_policy* restrict b_pPolicy,
+                     unsigned long b_remain)
+{
+   // curl does not let the connection outlast the whole attempt
+   CURLcode b_libCode = curl_easy_setopt(b_pHan,
+                                         CURLOPT_TIMEOUT_MS,
+                                         (long) b_remain);
+   if (!b_libCode)
+      b_libCode = curl_easy_setopt(b_pHan,
+                                   CURLOPT_CONNECTTIMEOUT_MS,
+                                   (long) b_pPolicy -> l_connTimeout);
+   if (!b_libCode)
+      b_libCode = curl_easy_setopt(b_pHan,
+                                   CURLOPT_LOW_SPEED_LIMIT,
+                                   (long) b_pPolicy -> l_lowSpeed);
+   if (!b_libCode)
+      b_libCode = curl_easy_setopt(b_pHan,
+                                   CURLOPT_LOW_SPEED_TIME,
+                                   b_pPolicy -> l_lowSpeed ? (long) b_pPolicy -> l_lowTime
+                                                           : 0L);
+   return b_libCode;
+}
+#endif
+
+CURLcode B_chkResult(CURLcode b_libCode,
+                     const B_dl_data* b_pDlData)
+{
+   if (b_libCode == CURLE_WRITE_ERROR &&
+       b_pDlData -> b_fAborted)
+      return CURLE_OK;
+   return b_libCode;
+}
+
+bool B_chkPolicy(const L_policy* restrict b_pPolicy)
+{
+   return b_pPolicy -> l_deadline <= L_MAX_DEADLINE &&
+          b_pPolicy -> l_connTimeout &&
+          b_pPolicy -> l_connTimeout <= L_MAX_DEADLINE &&
+          b_pPolicy -> l_lowTime <= L_MAX_DEADLINE / 1000 &&
+          (!(b_pPolicy -> l_lowSpeed) ||
+           b_pPolicy -> l_lowTime) &&
+          b_pPolicy -> l_maxRetry < L_MAXATTEMPTS &&
+          b_pPolicy -> l_backoff <= L_MAX_DEADLINE &&
+          b_pPolicy -> l_maxBackoff <= L_MAX_DEADLINE;
+}
+
+bool B_isTransient(CURLcode b_libCode,
+                   long b_resCode)
+{
+   switch (b_libCode) {
+      case CURLE_OK:                 return b_resCode >= 500 &&
+                                            b_resCode < 600;
+      case CURLE_COULDNT_RESOLVE_HOST:
+      case CURLE_COULDNT_CONNECT:
+      case CURLE_OPERATION_TIMEDOUT:
+      case CURLE_SEND_ERROR:
+      case CURLE_RECV_ERROR:
+      case CURLE_GOT_NOTHING:
+      case CURLE_PARTIAL_FILE:       return true;
+      default:                       return false;
+   }
+}
+
+unsigned long B_backoff(const L_policy* restrict b_pPolicy,
+                        unsigned b_numRetry,
+                        uint32_t* restrict b_pSeed)
+{
+   unsigned long b_cap = b_pPolicy -> l_backoff;
+   for (unsigned i = 0; i < b_numRetry &&
+                        b_cap < b_pPolicy -> l_maxBackoff; i++)
+      b_cap <<= 1;
+   if (b_cap > b_pPolicy -> l_maxBackoff)
+      b_cap = b_pPolicy -> l_maxBackoff;
+   // xorshift32: the attempts of several requests that failed together are spread apart
+   uint32_t b_x = *b_pSeed;
+   b_x ^= b_x << 13;
+   b_x ^= b_x >> 17;
+   b_x ^= b_x << 5;
+   *b_pSeed = b_x;
+   return (unsigned long) (b_x % (b_cap + 1));
+}
+
+#ifndef WRC_NATIVE_HTTP
+bool B_initShare(bool b_fConn)
+{
+   // read by the first invocation only: the share is created once
+   b_fShareConn = b_fConn;
+   pthread_once(&b_onceShare, b_initShare);
+   return b_pShare != CST_PVOID;
+}
+
+void B_cleanupShare(void)
+{
+   if (!b_pShare)
+      return;
+   curl_share_cleanup(b_pShare);
+   b_pShare = CST_PVOID;
+}
+
+void B_setTls(bool b_fTls,
+              const char* const b_pathFile)
+{
+   b_strScheme = b_fTls ? "https"
+                        : "http";
+   b_pathCA = b_fTls ? b_pathFile
+                     : CST_PVOID;
+}
+
+CURLcode B_resolve(const B_board* restrict b_pBoard,
+                   unsigned long b_connTimeout)
+{
+   CURL* b_pHan = curl_easy_init();
+   if (!b_pHan)
+      return CURLE_FAILED_INIT;
+   CURLcode b_libCode = curl_easy_setopt(b_pHan,
+                                         CURLOPT_DEFAULT_PROTOCOL,
+                                         b_strScheme);
+   if (!b_libCode &&
+       b_pathCA)
+      b_libCode = curl_easy_setopt(b_pHan,
+                                   CURLOPT_CAINFO,
+                                   b_pathCA);
+   if (!b_libCode &&
+       b_pShare)
+      b_libCode = curl_easy_setopt(b_pHan,
+                                   CURLOPT_SHARE,
+                                   b_pShare);
+   if (!b_libCode)
+      b_libCode = curl_easy_setopt(b_pHan,
+                                   CURLOPT_URL,
+                                   b_pBoard -> b_urls[B_IDXSTAT]);
+   if (!b_libCode)
+      b_libCode = curl_easy_setopt(b_pHan,
+                                   CURLOPT_CONNECT_ONLY,
+                                   1L);
+   if (!b_libCode)
+      b_libCode = curl_easy_setopt(b_pHan,
+                                   CURLOPT_CONNECTTIMEOUT_MS,
+                                   (long) b_connTimeout);
+   if (!b_libCode)
+      b_libCode = curl_easy_perform(b_pHan);
+   curl_easy_cleanup(b_pHan);
+   return b_libCode;
+}
+#endif
+
+static bool b_compose(const B_board* restrict b_pBoard,
+                      const char* const b_path,
+                      char b_strUrl[static B_MAXSZSTR_URL])
+{
+   const size_t b_lenPath = strlen(b_path);
+   if (b_pBoard -> b_lenPref + b_lenPath >= B_MAXSZSTR_URL)
+      return false;
+   memcpy(b_strUrl, b_pBoard -> b_strPref, b_pBoard -> b_lenPref);
+   memcpy(b_strUrl + b_pBoard -> b_lenPref, b_path, b_lenPath + 1);
+   return true;
+}
+
+static bool b_chkName(size_t b_lenStr, const char* b_str)
+{
+   size_t b_lenLabel = 0;
+   for (size_t i = 0; i < b_lenStr; i++) {
+      if (b_str[i] == '.') {
+         if (!b_lenLabel ||
+             b_str[i - 1] == '-')
+            return false;
+         b_lenLabel = 0;
+      }
+      else if (isalnum(b_str[i]) ||
+               (b_str[i] == '-' &&
+                b_lenLabel)) {
+         if (++b_lenLabel > B_MAXLEN_LABEL)
+            return false;
+      }
+      else
+         return false;
+   }
+   return b_lenLabel &&
+          b_str[b_lenStr - 1] != '-';
+}
+
+#ifndef WRC_NATIVE_HTTP
+static void b_initShare(void)
+{
+   CURLSH* b_pNew = curl_share_init();
+   if (!b_pNew)
+      return;
+   for (size_t i = 0; i < CURL_LOCK_DATA_LAST; i++)
+      pthread_mutex_init(b_locks + i, CST_PVOID);
+   if (curl_share_setopt(b_pNew,
+                         CURLSHOPT_LOCKFUNC,
+                         b_lock) ||
+       curl_share_setopt(b_pNew,
+                         CURLSHOPT_UNLOCKFUNC,
+                         b_unlock) ||
+       curl_share_setopt(b_pNew,
+                         CURLSHOPT_SHARE,
+                         CURL_LOCK_DATA_DNS) ||
+       curl_share_setopt(b_pNew,
+                         CURLSHOPT_SHARE,
+                         CURL_LOCK_DATA_SSL_SESSION) ||
+       (b_fShareConn &&
+        curl_share_setopt(b_pNew,
+                          CURLSHOPT_SHARE,
+                          CURL_LOCK_DATA_CONNECT))) {
+      curl_share_cleanup(b_pNew);
+      return;
+   }
+   b_pShare = b_pNew;
+}
+
+static void b_lock(CURL* b_pHan,
+                   curl_lock_data b_data,
+                   curl_lock_access b_access,
+                   void* b_uD)
+{
+   // the data are small: readers and writers are not told apart
+   if ((unsigned) b_data < CURL_LOCK_DATA_LAST)
+      pthread_mutex_lock(b_locks + b_data);
+}
+
+static void b_unlock(CURL* b_pHan,
+                     curl_lock_data b_data,
+                     void* b_uD)
+{
+   if ((unsigned) b_data < CURL_LOCK_DATA_LAST)
+      pthread_mutex_unlock(b_locks + b_data);
+}
+#endif
@@ -0,0 +1,118 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "cache.h"
+#include "sched.h"
+#include "constants.h"
+#include "err_wrapper.h"
+
+#define C_INITCAP  4U  // initial capacity of the array of entries
+
+// the entry of a web relay array (a null pointer is returned if there is none)
+static C_entry* c_find(const C_cache* restrict c_pCache,
+                       const B_board* restrict c_pBoard);
+
+void C_init(C_cache* restrict c_pCache,
+            unsigned long c_ttl)
+{
+   memset(c_pCache, 0, sizeof(C_cache));
+   c_pCache -> c_ttl = (uint64_t) c_ttl * S_NSPERMS;
+}
+
+bool C_lookup(C_cache* restrict c_pCache,
+              const B_board* restrict c_pBoard,
+              r_stat* restrict c_pStat,
+              uint64_t* restrict c_pAge)
+{
+   if (!(c_pCache -> c_ttl))
+      return false;
+   const C_entry* c_pEntry = c_find(c_pCache, c_pBoard);
+   const uint64_t c_now = S_now();
+   if (!c_pEntry ||
+       !(c_pEntry -> c_fValid) ||
+       c_now - c_pEntry -> c_tStamp > c_pCache -> c_ttl) {
+      c_pCache -> c_numMiss++;
+      return false;
+   }
+   c_pCache -> c_numHit++;
+   *c_pStat = c_pEntry -> c_stat;
+   if (c_pAge)
+      *c_pAge = c_now - c_pEntry -> c_tStamp;
+   return true;
+}
+
+bool C_peek(const C_cache* restrict c_pCache,
+            const B_board* restrict c_pBoard,
+            uint64_t c_maxAge,
+            r_stat* restrict c_pStat,
+            uint64_t* restrict c_pAge)
+{
+   const C_entry* c_pEntry = c_find(c_pCache, c_pBoard);
+   if (!c_pEntry ||
+       !(c_pEntry -> c_fValid))
+      return false;
+   const uint64_t c_age = S_now() - c_pEntry -> c_tStamp;
+   if (c_age > c_maxAge)
+      return false;
+   *c_pStat = c_pEntry -> c_stat;
+   if (c_pAge)
+      *c_pAge = c_age;
+   return true;
+}
+
+int C_update(C_cache* restrict c_pCache,
+             const B_board* restrict c_pBoard,
+             r_stat c_stat)
+{
+   C_entry* c_pEntry = c_find(c_pCache, c_pBoard);
+   if (!c_pEntry) {
+      if (c_pCache -> c_numEntries == c_pCache -> c_cap) {
+         const size_t c_newCap = c_pCache -> c_cap ? 2 * (c_pCache -> c_cap)
+                                                   : C_INITCAP;
+         C_entry* c_newEntries = realloc(c_pCache -> c_entries, c_newCap * sizeof(C_entry));
+         if (!c_newEntries)
+            return wRC_Cd_heapManFail;
+         c_pCache -> c_entries = c_newEntries;
+         c_pCache -> c_cap = c_newCap;
+      }
+      c_pEntry = c_pCache -> c_entries + c_pCache -> c_numEntries;
+      c_pCache -> c_numEntries++;
+      memcpy(c_pEntry -> c_strPref, c_pBoard -> b_strPref, c_pBoard -> b_lenPref + 1);
+      c_pEntry -> c_hwMod = c_pBoard -> b_hwMod;
+   }
+   c_pEntry -> c_stat = c_stat;
+   c_pEntry -> c_tStamp = S_now();
+   c_pEntry -> c_fValid = true;
+   return wRC_Cd_noError;
+}
+
+void C_invalidate(C_cache* restrict c_pCache,
+                  const B_board* restrict c_pBoard)
+{
+   C_entry* c_pEntry = c_find(c_pCache, c_pBoard);
+   if (c_pEntry)
+      c_pEntry -> c_fValid = false;
+}
+
+void C_cleanup(C_cache* restrict c_pCache)
+{
+   free(c_pCache -> c_entries);
+   memset(c_pCache, 0, sizeof(C_cache));
+}
+
+static C_entry* c_find(const C_cache* restrict c_pCache,
+                       const B_board* restrict c_pBoard)
+{
+   // few web relay arrays are addressed by a single invocation: a linear search suffices
+   for (size_t i = 0; i < c_pCache -> c_numEntries; i++) {
+      C_entry* c_pEntry = c_pCache -> c_entries + i;
+      if (c_pEntry -> c_hwMod == c_pBoard -> b_hwMod &&
+          !strcmp(c_pEntry -> c_strPref, c_pBoard -> b_strPref))
+         return c_pEntry;
+   }
+   return CST_PVOID;
+}
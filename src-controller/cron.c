@@ -0,0 +1,651 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "cron.h"
+#include "parser.h"
+#include "parser_constants.h"
+#include "constants.h"
+#include "err_wrapper.h"
+
+#define T_NUMFIELD    5U  // number of fields of a cron expression
+#define T_FIELD_DOM   2U  // index of the day of the month
+#define T_FIELD_DOW   4U  // index of the day of the week
+#define T_INITCAP    16U  // initial capacity of the array of entries of a schedule table
+#define T_NSPERS      1000000000ULL  // nanoseconds per second
+
+#define T_WRENTRY(t_numLine)  fprintf(stderr, "[ERR] line %zu of the schedule is not valid\n", t_numLine + 0)
+
+// the bounds of the values of each field (the day of the week accepts 7 as Sunday)
+static const unsigned t_minVals[T_NUMFIELD] = {0, 0, 1, 1, 0};
+static const unsigned t_maxVals[T_NUMFIELD] = {59, 23, 31, 12, 7};
+
+// the shorthands of the cron expressions
+static const char* const t_shortNames[] = {"@yearly", "@annually", "@monthly", "@weekly", "@daily", "@midnight", "@hourly"};
+static const char* const t_shortSpecs[] = {"0 0 1 1 *", "0 0 1 1 *", "0 0 1 * *", "0 0 * * 0", "0 0 * * *", "0 0 * * *", "0 * * * *"};
+
+// parses a field of a cron expression (the bits of the matching values are set)
+// returns either wRC_Cd_noError or wRC_Cd_wrI
+static int t_parseField(unsigned t_idxField,
+                        size_t t_lenStrField, const char* t_strField,
+                        uint64_t* restrict t_pBits);
+// parses an unsigned number (at least one digit); the position is moved after the last digit
+static bool t_parseNum(size_t t_lenStr, const char* t_str,
+                       size_t* restrict t_pPos,
+                       unsigned* restrict t_pNum);
+// obtains the next field of a line separated by spaces (false is returned if there is none)
+static bool t_nextField(size_t t_lenLine, const char* t_line,
+                        size_t* restrict t_pPos,
+                        const char** t_ppField,
+                        size_t* restrict t_pLenField);
+// checks whether a day matches the day of the month and the day of the week of an expression
+static bool t_matchDay(const T_spec* restrict t_pSpec,
+                       const struct tm* restrict t_pTm);
+// reads the entries of a schedule into a table (the error message is printed on stderr)
+// returns one of the error codes of T_load
+static int t_readJobs(T_table* restrict t_pTab,
+                      FILE* t_pFile,
+                      size_t t_numBoard);
+// runs the occurrence of an entry that is due, unless it is too late (the occurrences that have
+// elapsed are then missed) or the previous run is not over
+static void t_runJob(T_table* restrict t_pTab,
+                     E_engine* restrict t_pEng,
+                     T_job* restrict t_pJob,
+                     uint64_t t_now);
+
+uint64_t T_now(void)
+{
+   struct timespec t_ts;
+   clock_gettime(CLOCK_REALTIME, &t_ts);
+   return (uint64_t) t_ts.tv_sec * 1000000000ULL + (uint64_t) t_ts.tv_nsec;
+}
+
+int T_parseSpec(T_spec* restrict t_pSpec,
+                size_t t_lenStrSpec, const char* const t_strSpec)
+{
+   if (!t_pSpec ||
+       !t_strSpec)
+      return wRC_Cd_invP;
+   const char* t_str = t_strSpec;
+   size_t t_lenStr = t_lenStrSpec;
+   if (t_lenStr &&
+       *t_str == '@') {
+      size_t i = 0;
+      while (i < sizeof(t_shortNames) / sizeof(t_shortNames[0]) &&
+             (strlen(t_shortNames[i]) != t_lenStr ||
+              memcmp(t_shortNames[i], t_str, t_lenStr)))
+         i++;
+      if (i == sizeof(t_shortNames) / sizeof(t_shortNames[0]))
+         return wRC_Cd_wrI;
+      t_str = t_shortSpecs[i];
+      t_lenStr = strlen(t_str);
+   }
+   uint64_t t_bits[T_NUMFIELD] = {0};
+   bool t_fAny[T_NUMFIELD] = {false};
+   size_t t_pos = 0;
+   for (unsigned i = 0; i < T_NUMFIELD; i++) {
+      const char* t_field;
+      size_t t_lenField;
+      if (!t_nextField(t_lenStr, t_str,
+                       &t_pos,
+                       &t_field,
+                       &t_lenField) ||
+          t_parseField(i,
+                       t_lenField, t_field,
+                       t_bits + i))
+         return wRC_Cd_wrI;
+      t_fAny[i] = *t_field == '*';
+   }
+   const char* t_field;
+   size_t t_lenField;
+   if (t_nextField(t_lenStr, t_str,
+                   &t_pos,
+                   &t_field,
+                   &t_lenField))
+      return wRC_Cd_wrI;
+   // Sunday is either 0 or 7
+   if (t_bits[T_FIELD_DOW] & (UINT64_C(1) << 7))
+      t_bits[T_FIELD_DOW] |= 1U;
+   t_pSpec -> t_mins = t_bits[0];
+   t_pSpec -> t_hours = (uint32_t) t_bits[1];
+   t_pSpec -> t_doms = (uint32_t) t_bits[2];
+   t_pSpec -> t_mons = (uint16_t) t_bits[3];
+   t_pSpec -> t_dows = (uint8_t) (t_bits[T_FIELD_DOW] & 0x7FU);
+   t_pSpec -> t_fAnyDom = t_fAny[T_FIELD_DOM];
+   t_pSpec -> t_fAnyDow = t_fAny[T_FIELD_DOW];
+   return wRC_Cd_noError;
+}
+
+int T_parseEntry(T_entry* restrict t_pEntry,
+                 size_t t_lenLine, const char* const t_line)
+{
+   if (!t_pEntry ||
+       !t_line)
+      return wRC_Cd_invP;
+   // the cron expression spans either one field (a shorthand) or five
+   size_t t_pos = 0;
+   const char* t_field;
+   size_t t_lenField;
+   if (!t_nextField(t_lenLine, t_line,
+                    &t_pos,
+                    &t_field,
+                    &t_lenField))
+      return wRC_Cd_wrI;
+   const char* const t_strSpec = t_field;
+   if (*t_field != '@')
+      for (unsigned i = 1; i < T_NUMFIELD; i++)
+         if (!t_nextField(t_lenLine, t_line,
+                          &t_pos,
+                          &t_field,
+                          &t_lenField))
+            return wRC_Cd_wrI;
+   T_entry t_entry;
+   memset(&t_entry, 0, sizeof(T_entry));
+   if (T_parseSpec(&(t_entry.t_spec),
+                   (size_t) (t_field + t_lenField - t_strSpec), t_strSpec))
+      return wRC_Cd_wrI;
+   // <array>
+   size_t t_posField = 0;
+   unsigned t_idxBoard = 0;
+   if (!t_nextField(t_lenLine, t_line,
+                    &t_pos,
+                    &t_field,
+                    &t_lenField) ||
+       !t_parseNum(t_lenField, t_field,
+                   &t_posField,
+                   &t_idxBoard) ||
+       t_posField != t_lenField ||
+       !t_idxBoard)
+      return wRC_Cd_wrI;
+   t_entry.t_idxBoard = t_idxBoard;
+   // <relay-ID>{,<relay-ID>}
+   if (!t_nextField(t_lenLine, t_line,
+                    &t_pos,
+                    &t_field,
+                    &t_lenField) ||
+       !(t_lenField % 2))
+      return wRC_Cd_wrI;
+   for (size_t i = 0; i < t_lenField; i++) {
+      if (i % 2) {
+         if (t_field[i] != ',')
+            return wRC_Cd_wrI;
+         continue;
+      }
+      if (t_field[i] < '1' ||
+          t_field[i] > '0' + (int) P_CST_NUMREL)
+         return wRC_Cd_wrI;
+      t_entry.t_relays |= (unsigned char) (1U << (t_field[i] - '1'));
+   }
+   // on|off|<duration>[<unit>]
+   if (!t_nextField(t_lenLine, t_line,
+                    &t_pos,
+                    &t_field,
+                    &t_lenField))
+      return wRC_Cd_wrI;
+   if (t_lenField == 2 &&
+       !memcmp(t_field, "on", 2))
+      t_entry.t_act = T_act_on;
+   else if (t_lenField == 3 &&
+            !memcmp(t_field, "off", 3))
+      t_entry.t_act = T_act_off;
+   else if (!P_parseDuration(&(t_entry.t_dur),
+                             t_lenField, t_field))
+      t_entry.t_act = T_act_pulse;
+   else
+      return wRC_Cd_wrI;
+   if (t_nextField(t_lenLine, t_line,
+                   &t_pos,
+                   &t_field,
+                   &t_lenField))
+      return wRC_Cd_wrI;
+   *t_pEntry = t_entry;
+   return wRC_Cd_noError;
+}
+
+bool T_next(const T_spec* restrict t_pSpec,
+            time_t t_after,
+            time_t* restrict t_pNext)
+{
+   struct tm t_tm;
+   if (!localtime_r(&t_after, &t_tm))
+      return false;
+   const int t_lastYear = t_tm.tm_year + T_MAXYEARS;
+   // the search starts from the following minute; each unmatched field moves to the beginning of
+   // its next value (mktime normalizes the overflows)
+   t_tm.tm_sec = 0;
+   t_tm.tm_min++;
+   while (true) {
+      t_tm.tm_isdst = -1;
+      const time_t t_curr = mktime(&t_tm);
+      if (t_curr == (time_t) -1 ||
+          t_tm.tm_year > t_lastYear)
+         return false;
+      if (!(t_pSpec -> t_mons & (1U << (t_tm.tm_mon + 1)))) {
+         t_tm.tm_mon++;
+         t_tm.tm_mday = 1;
+         t_tm.tm_hour = 0;
+         t_tm.tm_min = 0;
+      }
+      else if (!t_matchDay(t_pSpec,
+                           &t_tm)) {
+         t_tm.tm_mday++;
+         t_tm.tm_hour = 0;
+         t_tm.tm_min = 0;
+      }
+      else if (!(t_pSpec -> t_hours & (UINT32_C(1) << t_tm.tm_hour))) {
+         t_tm.tm_hour++;
+         t_tm.tm_min = 0;
+      }
+      else if (!(t_pSpec -> t_mins & (UINT64_C(1) << t_tm.tm_min)) ||
+               // a local time repeated by a change of daylight saving time
+               t_curr <= t_after)
+         t_tm.tm_min++;
+      else {
+         *t_pNext = t_curr;
+         return true;
+      }
+   }
+}
+
+int T_load(T_table* restrict t_pTab,
+           const char* const t_pathSched,
+           size_t t_numBoard, const B_board t_boards[])
+{
+   memset(t_pTab, 0, sizeof(T_table));
+   S_init(&(t_pTab -> t_due));
+   S_init(&(t_pTab -> t_offs));
+   M_init(&(t_pTab -> t_reg));
+   if (!t_pathSched ||
+       !t_numBoard ||
+       !t_boards) {
+      fputs(WRC_MSG_INVPAR, stderr);
+      return wRC_Cd_invP;
+   }
+   FILE* t_pFile = fopen(t_pathSched, "r");
+   if (!t_pFile) {
+      fputs(WRC_MSG_NOSCHED, stderr);
+      return wRC_Cd_wrPPar;
+   }
+   int t_errCode = t_readJobs(t_pTab,
+                              t_pFile,
+                              t_numBoard);
+   fclose(t_pFile);
+   if (t_errCode)
+      return t_errCode;
+   // the commands refer to their entry: the array of entries does not move anymore
+   for (size_t i = 0; i < t_pTab -> t_numJob; i++) {
+      T_job* t_pJob = t_pTab -> t_jobs + i;
+      for (unsigned j = 0; j < P_CST_NUMREL; j++) {
+         if (!(t_pJob -> t_ent.t_relays & (1U << j)))
+            continue;
+         T_command* t_pCmd = t_pJob -> t_cmds + t_pJob -> t_numCmd++;
+         t_pCmd -> t_pJob = t_pJob;
+         t_pCmd -> t_targ.e_pBoard = t_boards + t_pJob -> t_ent.t_idxBoard - 1;
+         t_pCmd -> t_targ.e_comm.p_rID = (int) j;
+         t_pCmd -> t_targ.e_comm.p_oAct = oAct_numOAct;
+      }
+      if (!t_errCode)
+         t_errCode = S_push(&(t_pTab -> t_due),
+                            (uint64_t) t_pJob -> t_tDue * T_NSPERS,
+                            (void*) t_pJob);
+   }
+   if (t_errCode)
+      fputs(WRC_MSG_HEAPMANFAIL, stderr);
+   return t_errCode;
+}
+
+void T_run(T_table* restrict t_pTab,
+           E_engine* restrict t_pEng)
+{
+   // running the entries that are due
+   S_event t_evt;
+   const uint64_t t_wall = T_now();
+   while (S_peek(&(t_pTab -> t_due), &t_evt) &&
+          t_evt.s_deadline <= t_wall) {
+      S_pop(&(t_pTab -> t_due), CST_PVOID);
+      T_job* t_pJob = (T_job*) t_evt.s_pData;
+      t_runJob(t_pTab,
+               t_pEng,
+               t_pJob,
+               t_wall);
+      t_pJob -> t_fDue = T_next(&(t_pJob -> t_ent.t_spec),
+                                t_pJob -> t_tDue,
+                                &(t_pJob -> t_tDue));
+      if (!(t_pJob -> t_fDue)) {
+         fprintf(stderr, "[NOT] line %zu of the schedule is not due anymore\n", t_pJob -> t_numLine);
+         continue;
+      }
+      const int t_errCode = S_push(&(t_pTab -> t_due),
+                                   (uint64_t) t_pJob -> t_tDue * T_NSPERS,
+                                   (void*) t_pJob);
+      if (t_errCode &&
+          !(t_pTab -> t_errCode))
+         t_pTab -> t_errCode = t_errCode;
+   }
+   // starting the turn off commands that are due
+   const uint64_t t_now = S_now();
+   while (S_peek(&(t_pTab -> t_offs), &t_evt) &&
+          t_evt.s_deadline <= t_now) {
+      S_pop(&(t_pTab -> t_offs), CST_PVOID);
+      T_command* t_pCmd = (T_command*) t_evt.s_pData;
+      t_pCmd -> t_targ.e_comm.p_fAct = false;
+      E_submit(t_pEng, &(t_pCmd -> t_targ));
+   }
+}
+
+int T_waitTime(const T_table* restrict t_pTab,
+               int t_maxWait)
+{
+   int t_wait = S_waitTime(&(t_pTab -> t_offs), t_maxWait);
+   S_event t_evt;
+   if (S_peek(&(t_pTab -> t_due), &t_evt)) {
+      const uint64_t t_wall = T_now();
+      const uint64_t t_waitDue = t_evt.s_deadline > t_wall ? (t_evt.s_deadline - t_wall + S_NSPERMS - 1) / S_NSPERMS
+                                                           : 0;
+      if (t_waitDue < (uint64_t) t_wait)
+         t_wait = (int) t_waitDue;
+   }
+   return t_wait;
+}
+
+void T_complete(T_table* restrict t_pTab,
+                E_target* t_pTarg)
+{
+   // the target is the first member of its command
+   T_job* t_pJob = ((T_command*) t_pTarg) -> t_pJob;
+   if (!(t_pTarg -> e_fCoalesced) &&
+       (t_pTarg -> e_errCode == wRC_Cd_curl ||
+        t_pTarg -> e_resCode != 200))
+      t_pJob -> t_numFail++;
+   if (t_pJob -> t_ent.t_act == T_act_pulse &&
+       t_pTarg -> e_comm.p_fAct) {
+      // the turn off command is scheduled even if the turn on command failed (the state of the
+      // relay is unknown and the command is absolute)
+      const int t_errCode = S_push(&(t_pTab -> t_offs),
+                                   S_now() + (uint64_t) t_pJob -> t_ent.t_dur * S_NSPERMS,
+                                   (void*) t_pTarg);
+      if (t_errCode &&
+          !(t_pTab -> t_errCode))
+         t_pTab -> t_errCode = t_errCode;
+      return;
+   }
+   t_pJob -> t_numPend--;
+}
+
+void T_stop(T_table* restrict t_pTab,
+            E_engine* restrict t_pEng)
+{
+   S_event t_evt;
+   while (S_pop(&(t_pTab -> t_offs), &t_evt)) {
+      T_command* t_pCmd = (T_command*) t_evt.s_pData;
+      t_pCmd -> t_targ.e_comm.p_fAct = false;
+      E_submit(t_pEng, &(t_pCmd -> t_targ));
+   }
+}
+
+void T_view(const T_table* restrict t_pTab,
+            FILE* t_pStream)
+{
+   for (size_t i = 0; i < t_pTab -> t_numJob; i++) {
+      const T_job* t_pJob = t_pTab -> t_jobs + i;
+      fprintf(t_pStream, "[INF] line %zu of the schedule: %lu run(s), %lu missed occurrence(s), %lu failed command(s), maximum drift %.3f ms",
+              t_pJob -> t_numLine, t_pJob -> t_numRun, t_pJob -> t_numMissed, t_pJob -> t_numFail,
+              t_pJob -> t_maxDrift / 1000.0);
+      struct tm t_tm;
+      char t_strDue[32];
+      if (t_pJob -> t_fDue &&
+          localtime_r(&(t_pJob -> t_tDue), &t_tm) &&
+          strftime(t_strDue, sizeof(t_strDue), "%Y-%m-%d %H:%M", &t_tm))
+         fprintf(t_pStream, ", next run %s\n", t_strDue);
+      else
+         fputc('\n', t_pStream);
+   }
+   fflush(t_pStream);
+}
+
+void T_cleanup(T_table* restrict t_pTab)
+{
+   S_cleanup(&(t_pTab -> t_due));
+   S_cleanup(&(t_pTab -> t_offs));
+   M_cleanup(&(t_pTab -> t_reg));
+   free(t_pTab -> t_jobs);
+   t_pTab -> t_jobs = CST_PVOID;
+   t_pTab -> t_numJob = 0;
+}
+
+static int t_parseField(unsigned t_idxField,
+                        size_t t_lenStrField, const char* t_strField,
+                        uint64_t* restrict t_pBits)
+{
+   const unsigned t_minVal = t_minVals[t_idxField];
+   const unsigned t_maxVal = t_maxVals[t_idxField];
+   uint64_t t_bits = 0;
+   size_t t_pos = 0;
+   while (true) {
+      // *, <value> or <first>-<last>, optionally followed by /<step>
+      unsigned t_first = t_minVal;
+      unsigned t_last = t_maxVal;
+      unsigned t_step = 1;
+      if (t_pos < t_lenStrField &&
+          t_strField[t_pos] == '*')
+         t_pos++;
+      else {
+         if (!t_parseNum(t_lenStrField, t_strField,
+                         &t_pos,
+                         &t_first))
+            return wRC_Cd_wrI;
+         t_last = t_first;
+         if (t_pos < t_lenStrField &&
+             t_strField[t_pos] == '-') {
+            t_pos++;
+            if (!t_parseNum(t_lenStrField, t_strField,
+                            &t_pos,
+                            &t_last))
+               return wRC_Cd_wrI;
+         }
+         // <value>/<step> stands for <value>-<maximum>/<step>
+         else if (t_pos < t_lenStrField &&
+                  t_strField[t_pos] == '/')
+            t_last = t_maxVal;
+      }
+      if (t_pos < t_lenStrField &&
+          t_strField[t_pos] == '/') {
+         t_pos++;
+         if (!t_parseNum(t_lenStrField, t_strField,
+                         &t_pos,
+                         &t_step) ||
+             !t_step)
+            return wRC_Cd_wrI;
+      }
+      if (t_first < t_minVal ||
+          t_last > t_maxVal ||
+          t_first > t_last)
+         return wRC_Cd_wrI;
+      for (unsigned i = t_first; i <= t_last; i += t_step)
+         t_bits |= UINT64_C(1) << i;
+      if (t_pos == t_lenStrField)
+         break;
+      if (t_strField[t_pos] != ',')
+         return wRC_Cd_wrI;
+      t_pos++;
+   }
+   *t_pBits = t_bits;
+   return wRC_Cd_noError;
+}
+
+static bool t_parseNum(size_t t_lenStr, const char* t_str,
+                       size_t* restrict t_pPos,
+                       unsigned* restrict t_pNum)
+{
+   size_t t_pos = *t_pPos;
+   unsigned t_num = 0;
+   while (t_pos < t_lenStr &&
+          isdigit(t_str[t_pos])) {
+      t_num = 10 * t_num + (unsigned) (t_str[t_pos] - '0');
+      // no field accepts a value that large
+      if (t_num > 1000)
+         return false;
+      t_pos++;
+   }
+   if (t_pos == *t_pPos)
+      return false;
+   *t_pPos = t_pos;
+   *t_pNum = t_num;
+   return true;
+}
+
+static bool t_nextField(size_t t_lenLine, const char* t_line,
+                        size_t* restrict t_pPos,
+                        const char** t_ppField,
+                        size_t* restrict t_pLenField)
+{
+   size_t t_pos = *t_pPos;
+   while (t_pos < t_lenLine &&
+          isspace(t_line[t_pos]))
+      t_pos++;
+   if (t_pos == t_lenLine) {
+      *t_pPos = t_pos;
+      return false;
+   }
+   const size_t t_start = t_pos;
+   while (t_pos < t_lenLine &&
+          !isspace(t_line[t_pos]))
+      t_pos++;
+   *t_pPos = t_pos;
+   *t_ppField = t_line + t_start;
+   *t_pLenField = t_pos - t_start;
+   return true;
+}
+
+static bool t_matchDay(const T_spec* restrict t_pSpec,
+                       const struct tm* restrict t_pTm)
+{
+   const bool t_fDom = (t_pSpec -> t_doms & (UINT32_C(1) << t_pTm -> tm_mday)) != 0;
+   const bool t_fDow = (t_pSpec -> t_dows & (1U << t_pTm -> tm_wday)) != 0;
+   if (t_pSpec -> t_fAnyDom)
+      return t_fDow;
+   if (t_pSpec -> t_fAnyDow)
+      return t_fDom;
+   return t_fDom || t_fDow;
+}
+
+static int t_readJobs(T_table* restrict t_pTab,
+                      FILE* t_pFile,
+                      size_t t_numBoard)
+{
+   char* t_buf = CST_PVOID;
+   size_t t_szBuf = 0;
+   size_t t_numLine = 0;
+   size_t t_cap = 0;
+   int t_errCode = wRC_Cd_noError;
+   const time_t t_now = time(CST_PVOID);
+   ssize_t t_lenRead;
+   while ((t_lenRead = getline(&t_buf, &t_szBuf, t_pFile)) >= 0) {
+      t_numLine++;
+      const char* t_line = t_buf;
+      size_t t_lenLine = (size_t) t_lenRead;
+      if (t_lenLine &&
+          t_line[t_lenLine - 1] == '\n')
+         t_lenLine--;
+      // empty lines and comments are ignored
+      while (t_lenLine &&
+             isspace(*t_line)) {
+         t_line++;
+         t_lenLine--;
+      }
+      if (!t_lenLine ||
+          *t_line == '#')
+         continue;
+      if (t_pTab -> t_numJob == t_cap) {
+         const size_t t_newCap = t_cap ? 2 * t_cap
+                                       : T_INITCAP;
+         T_job* t_newJobs = realloc(t_pTab -> t_jobs, t_newCap * sizeof(T_job));
+         if (!t_newJobs) {
+            fputs(WRC_MSG_HEAPMANFAIL, stderr);
+            t_errCode = wRC_Cd_heapManFail;
+            goto T_READJOBS_EXIT;
+         }
+         t_pTab -> t_jobs = t_newJobs;
+         t_cap = t_newCap;
+      }
+      T_job* t_pJob = t_pTab -> t_jobs + t_pTab -> t_numJob;
+      memset(t_pJob, 0, sizeof(T_job));
+      t_pJob -> t_numLine = t_numLine;
+      // an entry that is never due is not valid either
+      if (T_parseEntry(&(t_pJob -> t_ent),
+                       t_lenLine, t_line) ||
+          t_pJob -> t_ent.t_idxBoard > t_numBoard ||
+          !T_next(&(t_pJob -> t_ent.t_spec),
+                  t_now,
+                  &(t_pJob -> t_tDue))) {
+         T_WRENTRY(t_pJob -> t_numLine);
+         t_errCode = wRC_Cd_wrI;
+         goto T_READJOBS_EXIT;
+      }
+      t_pJob -> t_fDue = true;
+      t_pTab -> t_numJob++;
+   }
+   if (ferror(t_pFile) ||
+       !(t_pTab -> t_numJob)) {
+      fputs(WRC_MSG_NOSCHED, stderr);
+      t_errCode = wRC_Cd_wrPPar;
+   }
+   T_READJOBS_EXIT:
+   free(t_buf);
+   return t_errCode;
+}
+
+static void t_runJob(T_table* restrict t_pTab,
+                     E_engine* restrict t_pEng,
+                     T_job* restrict t_pJob,
+                     uint64_t t_now)
+{
+   uint64_t t_drift = t_now - (uint64_t) t_pJob -> t_tDue * T_NSPERS;
+   if (t_drift >= T_MAXLATE) {
+      // the process has been stopped or the wall clock has moved forward: the occurrences that
+      // are too late are skipped (the last one becomes the reference of the next occurrence), while
+      // the latest one is run if it is still within the limit
+      const uint64_t t_late = t_drift;
+      unsigned long t_numMissed = 1;
+      time_t t_tNext;
+      while (T_next(&(t_pJob -> t_ent.t_spec),
+                    t_pJob -> t_tDue,
+                    &t_tNext) &&
+             (uint64_t) t_tNext * T_NSPERS <= t_now) {
+         t_pJob -> t_tDue = t_tNext;
+         if (t_now - (uint64_t) t_tNext * T_NSPERS < T_MAXLATE)
+            break;
+         t_numMissed++;
+      }
+      t_pJob -> t_numMissed += t_numMissed;
+      M_recordMissed(&(t_pTab -> t_reg),
+                     t_numMissed);
+      fprintf(stderr, "[NOT] line %zu of the schedule: %lu occurrence(s) missed (%.3f s late)\n", t_pJob -> t_numLine, t_numMissed,
+              (double) t_late / T_NSPERS);
+      t_drift = t_now - (uint64_t) t_pJob -> t_tDue * T_NSPERS;
+      if (t_drift >= T_MAXLATE)
+         return;
+   }
+   if (t_pJob -> t_numPend) {
+      t_pJob -> t_numMissed++;
+      M_recordMissed(&(t_pTab -> t_reg),
+                     1);
+      fprintf(stderr, "[NOT] line %zu of the schedule: an occurrence is missed (the previous run is not over)\n", t_pJob -> t_numLine);
+      return;
+   }
+   t_pJob -> t_numRun++;
+   if (t_drift / 1000 > t_pJob -> t_maxDrift)
+      t_pJob -> t_maxDrift = t_drift / 1000;
+   M_recordRun(&(t_pTab -> t_reg),
+               t_drift / 1000);
+   for (unsigned i = 0; i < t_pJob -> t_numCmd; i++) {
+      E_target* t_pTarg = &(t_pJob -> t_cmds[i].t_targ);
+      t_pTarg -> e_comm.p_fAct = t_pJob -> t_ent.t_act != T_act_off;
+      t_pJob -> t_numPend++;
+      E_submit(t_pEng, t_pTarg);
+   }
+}
@@ -1,267 +1,535 @@
 /**************************************/
 /* Author: Pavlo Nykolyn              */
-/* Last modification date: 21/05/2023 */
+/* Last modification date: 17/10/2026 */
 /**************************************/
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <signal.h>
+#include <unistd.h>
+#include <time.h>
 #include <curl/curl.h>
 #include "ctrl.h"
+#include "board.h"
+#include "engine.h"
+#include "sched.h"
+#include "cache.h"
+#include "metrics.h"
+#include "output.h"
+#include "cron.h"
+#include "group.h"
+#include "model.h"
+#include "daemon.h"
+#include "wrctrl.h"
 #include "parser.h"
 #include "constants.h"
 #include "err_wrapper.h"
 
-#define RC_MAXNUMCHS  1500L  // maximum number of characters that will be downloaded by curl
-#define RC_SZCOMM_KMT    6U  // length of a KMTronic web relay command
-#define RC_SZCOMM_NC8    2U  // length of a NC800 web relay command
+#define RC_MAXWAIT_PULSE  1000  // maximum time (milliseconds) spent waiting for network activity by the pulse scheduler
+#define RC_MAXWAIT_BATCH  1000  // maximum time (milliseconds) spent waiting for network activity by a batch session
+#define RC_BATCH_WINDOW   1024U  // maximum number of commands of a batch session held at once
+#define RC_BATCH_SZBUF   65536U  // size of the buffer that holds the script of a batch session
+#define RC_BATCH_ALLREL   0xFFU  // every relay is involved by a status query
+#define RC_METRICS_PERIOD 1000U  // minimum time (milliseconds) between two writes of the metrics file by a long-running session
+#define RC_MAXWAIT_DAEMON 1000   // maximum time (milliseconds) spent waiting for activity by a daemon
+#define RC_MAXWAIT_CRON   1000   // maximum time (milliseconds) spent waiting by a cron session (a change of the wall clock is noticed within this time)
+// states of a command of a batch session
+#define RC_BS_QUEUED  0U  // waiting for the commands it depends upon
+#define RC_BS_ACTIVE  1U  // the transfer is in progress
+#define RC_BS_DONE    2U  // the result is known (either the transfer is over or the line is not valid)
 
 #define RC_CURLERRCODE(rC_curlCode)  fprintf(stderr, "[NOT] A curl service returned error code: %d\n", rC_curlCode + 0)
+#define RC_WRGROUP(rC_numLine)       fprintf(stderr, "[ERR] line %zu of the groups is not valid\n", rC_numLine + 0)
 
-// the user-defined data CURLOPT_WRITEDATA
-typedef struct rC_html_buf {
-// effective size of the buffer
-   size_t rC_szBuf;
-// HAS TO BE ASSIGNED TO A VALID ARRAY OF RC_MAXNUMCHS + 1 CHARACTERS BEFORE ANY ATTEMPT TO READ ANYTHING
-  char* rC_buf;
-} rC_html_buf;
-
-// the call-back CURLOPT_WRITEFUNCTION
-static size_t rC_dl(char* rC_currBuf,
-                    size_t rC_chSz, // byte size of each element of rC_currBuf (HAS TO BE ONE)
-                    size_t rC_currSzBuf,
-                    void* rC_uD)
-{
-   if (rC_chSz != 1)
-      return ~rC_currSzBuf;
-   rC_html_buf* rC_pBuf = (rC_html_buf*) rC_uD;
-   if ((rC_pBuf -> rC_szBuf) + rC_currSzBuf > RC_MAXNUMCHS)
-      return ~rC_currSzBuf;
-   memcpy(((rC_pBuf -> rC_buf) + (rC_pBuf -> rC_szBuf)), rC_currBuf, rC_currSzBuf);
-   rC_pBuf -> rC_szBuf += rC_currSzBuf;
-   return rC_currSzBuf;
-}
-
-// prints on stdout the status of each relay
-// WRAPPER
+// the state of a pulse
+typedef struct rC_pulse {
+// the command (turn on, then turn off)
+   E_target rC_targ;
+// requested duration (nanoseconds)
+   uint64_t rC_dur;
+// instants (monotonic clock) at which:
+// - the turn on command was completed;
+// - the turn off command was due;
+// - the turn off command was started;
+// - the turn off command was completed
+   uint64_t rC_tOnDone;
+   uint64_t rC_tOffDue;
+   uint64_t rC_tOffStart;
+   uint64_t rC_tOffDone;
+// results of the turn on command
+   int rC_onErrCode;
+   long rC_onResCode;
+} rC_pulse;
+
+// the user-defined data of the engine call-back used by the pulse scheduler
+typedef struct rC_pulseSess {
+   S_heap rC_heap;
+// the metrics of the requests
+   M_registry rC_reg;
+// the options of the session and the pulses (a pulse is identified by its position)
+   const rC_opts* rC_pOpts;
+   const rC_pulse* rC_states;
+// first error that occurred while queuing an event
+   int rC_errCode;
+// error code of the last failed command (either a turn on or a turn off command)
+   int rC_lastFail;
+} rC_pulseSess;
+
+// the user-defined data of the engine call-back used by a concurrent session
+typedef struct rC_concSess {
+// the metrics of the requests
+   M_registry rC_reg;
+// the options of the session and the targets (a target is identified by its position)
+   const rC_opts* rC_pOpts;
+   const E_target* rC_targs;
+// error code of the last failed target
+   int rC_lastFail;
+} rC_concSess;
+
+// a command of a batch session
+typedef struct rC_batchCmd {
+// the target processed by the engine (it HAS TO be the first member)
+   E_target rC_targ;
+// line of the script that holds the command
+   size_t rC_numLine;
+// error code of the parse of the line
+   int rC_errCode;
+// relays involved by the command
+   r_stat rC_mask;
+   unsigned char rC_state;
+// instants (monotonic clock) at which the transfer was started and completed
+   uint64_t rC_tStart;
+   uint64_t rC_tDone;
+} rC_batchCmd;
+
+// the script of a batch session (read in blocks)
+typedef struct rC_script {
+   FILE* rC_pFile;
+   char rC_buf[RC_BATCH_SZBUF];
+// number of valid characters of the buffer
+   size_t rC_len;
+// position of the first character that has not been consumed
+   size_t rC_pos;
+// number of lines read so far
+   size_t rC_numLine;
+// the end of the file has been reached
+   bool rC_fEOF;
+// the rest of an overlong line has to be discarded
+   bool rC_fSkip;
+} rC_script;
+
+// the user-defined data of the engine call-back used by a cron session
+typedef struct rC_cronSess {
+   T_table rC_tab;
+   const rC_opts* rC_pOpts;
+} rC_cronSess;
+
+// a dump of the latency histograms has been requested (SIGUSR1)
+static volatile sig_atomic_t rC_fDumpLat = 0;
+#ifndef WRC_NATIVE_HTTP
+// a daemon has to stop (SIGINT or SIGTERM)
+static volatile sig_atomic_t rC_fStop = 0;
+#endif
+
+// prints on stdout the status of each relay (as described by the model)
 static void rC_viewStat(const r_stat rC_stat,
                         enum r_mCodes);
-static void rC_viewStat_KMTronic(const r_stat rC_stat);
-static void rC_viewStat_NC800(const r_stat rC_stat);
-
-// the first column holds the off commands for each relay. The second column
-// holds the on commands
-// commands for the KMTronic web relay
-static const char* rC_KMTronic_comm[8][2] = {{"FF0100", "FF0101"},
-                                             {"FF0200", "FF0201"},
-                                             {"FF0300", "FF0301"},
-                                             {"FF0400", "FF0401"},
-                                             {"FF0500", "FF0501"},
-                                             {"FF0600", "FF0601"},
-                                             {"FF0700", "FF0701"},
-                                             {"FF0800", "FF0801"}};
-// commands for the NC800 web relay
-static const char* rC_nc800_comm[8][2] = {{"00", "01"},
-                                          {"02", "03"},
-                                          {"04", "05"},
-                                          {"06", "07"},
-                                          {"08", "09"},
-                                          {"10", "11"},
-                                          {"12", "13"},
-                                          {"14", "15"}};
+// opens a handle towards a web relay array and sets its policy (the error message is printed on
+// stderr)
+// returns one of the error codes of L_openBoard
+static int rC_open(L_board** rC_ppBoard,
+                   size_t rC_szStr_IPv4, const char* const rC_str_IPv4,
+                   size_t rC_szStr_port, const char* const rC_str_port,
+                   enum r_mCodes rC_hwMod,
+                   const L_policy* restrict rC_pPolicy);
+// performs a parsed command (or a status query) through a handle. A response code other than 200
+// is not an error
+// returns one of the following error codes:
+// - wRC_Cd_noError;
+// - wRC_Cd_curl (the curl error code is printed on stderr)
+static int rC_exchange(L_board* rC_pBoard,
+                       const P_out* restrict rC_pComm,
+                       L_result* restrict rC_pRes);
+// prints on stderr the attempts of a request that failed and have been retried (the last attempt is
+// reported by the caller)
+static void rC_viewAttempts(const char* const rC_strComm,
+                            unsigned rC_numAttempt,
+                            const L_attempt rC_attempts[]);
+// stores the outcome of an exchange within the status cache: the status of a successful exchange
+// is stored while the status of a failed one is discarded
+// returns one of the following error codes:
+// - wRC_Cd_noError;
+// - wRC_Cd_heapManFail (the error message is printed on stderr)
+static int rC_storeStat(C_cache* restrict rC_pCache,
+                        const B_board* restrict rC_pBoard,
+                        int rC_errCode,
+                        long rC_resCode,
+                        r_stat rC_stat);
+// checks whether a command would not change the known status of the relays (idempotent mode only)
+// the known status and its age are returned through rC_pStat and rC_pAge
+static bool rC_isRedundant(const C_cache* restrict rC_pCache,
+                           const B_board* restrict rC_pBoard,
+                           const P_out* restrict rC_pComm,
+                           const rC_opts* restrict rC_pOpts,
+                           r_stat* restrict rC_pStat,
+                           uint64_t* restrict rC_pAge);
+// the handler of SIGUSR1 (a dump of the latency histograms is requested)
+static void rC_onSignal(int rC_sig);
+// installs the handler of SIGUSR1 if the latency is measured. The interrupted reads are restarted
+static void rC_initLatency(const rC_opts* restrict rC_pOpts);
+// records the measurements of an exchange within the metrics (if either the latency report or the
+// metrics file is enabled) and prints the breakdown on stdout (if the latency report is enabled). A
+// failed allocation is reported on stderr but it does not stop the session
+static void rC_recordLatency(M_registry* restrict rC_pReg,
+                             const B_board* restrict rC_pBoard,
+                             const rC_opts* restrict rC_pOpts,
+                             int rC_errCode,
+                             const L_result* restrict rC_pRes);
+// prints the latency histograms on stderr if a dump has been requested
+static void rC_chkDumpLatency(const M_registry* restrict rC_pReg);
+#ifndef WRC_NATIVE_HTTP
+// records the measurements of a target processed by the engine within the metrics
+static void rC_recordTarget(M_registry* restrict rC_pReg,
+                            const E_target* restrict rC_pTarg);
+#endif
+// writes the metrics file (a null path disables it). If rC_pTLast is null, the file is written at
+// once; otherwise, it is written only if RC_METRICS_PERIOD has elapsed since the instant held by
+// rC_pTLast (which is then updated). A failure is reported on stderr but it does not stop the session
+static void rC_publish(const M_registry* restrict rC_pReg,
+                       const char* const rC_path,
+                       uint64_t* restrict rC_pTLast);
+// writes the record of an operation on stdout (a failure is reported on stderr)
+static void rC_emit(const rC_opts* restrict rC_pOpts,
+                    const O_record* restrict rC_pRec);
+#ifndef WRC_NATIVE_HTTP
+// writes the record of a target processed by the engine on stdout
+static void rC_emitTarget(const rC_opts* restrict rC_pOpts,
+                          size_t rC_seq,
+                          const E_target* restrict rC_pTarg);
+// prints on stdout the number of hedged commands of each array (only if hedging is enabled and the
+// output is meant for a person)
+static void rC_viewHedges(const M_registry* restrict rC_pReg,
+                          const rC_opts* restrict rC_pOpts);
+// prints on stdout, for each array, the coalesced commands, the largest queue depth and the
+// queueing delay (only if the commands are queued and the output is meant for a person)
+static void rC_viewQueues(const M_registry* restrict rC_pReg,
+                          const rC_opts* restrict rC_pOpts);
+#endif
+// prints on stdout the counters of an enabled status cache and the number of skipped commands
+static void rC_viewCache(const C_cache* restrict rC_pCache,
+                         const rC_opts* restrict rC_pOpts,
+                         unsigned long rC_numSkip);
+#ifndef WRC_NATIVE_HTTP
+// the engine call-back of the pulse scheduler: a completed turn on command schedules the
+// turn off command of the same relay
+static void rC_pulseDone(E_target* rC_pTarg,
+                         void* rC_uD);
+// prints on stdout the report of a pulse
+static void rC_viewPulse(const rC_pulse* restrict rC_pPulse);
+// prints on stdout the results of a target processed by the engine
+static void rC_viewTarget(E_target* rC_pTarg,
+                          void* rC_uD);
+// obtains the next line of a script (false is returned once the script is over). The line is not
+// null-terminated and remains valid until the next invocation
+static bool rC_nextLine(rC_script* restrict rC_pScript,
+                        const char** rC_ppLine,
+                        size_t* restrict rC_pLenLine);
+// the engine call-back of a batch session
+static void rC_batchDone(E_target* rC_pTarg,
+                         void* rC_uD);
+// prints on stdout the result line of a command of a batch session (or its record)
+static void rC_viewBatchCmd(const rC_batchCmd* restrict rC_pCmd,
+                            const rC_opts* restrict rC_pOpts);
+// the handler of SIGINT and SIGTERM (a daemon or a cron session has to stop)
+static void rC_onStop(int rC_sig);
+// installs the handler of SIGINT and SIGTERM (a blocking call is interrupted)
+static void rC_initStop(void);
+// the engine call-back of a daemon
+static void rC_daemonDone(E_target* rC_pTarg,
+                          void* rC_uD);
+// the engine call-back of a cron session
+static void rC_cronDone(E_target* rC_pTarg,
+                        void* rC_uD);
+// reads the groups of a batch session
+// returns one of the following error codes (the error message is printed on stderr):
+// - wRC_Cd_noError;
+// - wRC_Cd_heapManFail;
+// - wRC_Cd_wrPPar (the file cannot be read or holds no group);
+// - wRC_Cd_wrI (a group is not valid or its name is repeated)
+static int rC_loadGroups(const char* const rC_pathGroups,
+                         G_group** rC_pGroups,
+                         size_t* restrict rC_pNumGroup);
+// sends a command of a batch session to every member of a group (at most rC_maxInFlight transfers
+// at once) and prints a result per member followed by the aggregate. The outcome of the line (the
+// error code of the last member that failed) is stored in rC_pLineErr; the returned error code
+// concerns the engine (the error message is printed on stderr)
+static int rC_fanOut(const G_group* restrict rC_pGroup,
+                     const P_out* restrict rC_pComm,
+                     size_t rC_numLine,
+                     unsigned rC_maxInFlight,
+                     M_registry* restrict rC_pReg,
+                     const rC_opts* restrict rC_pOpts,
+                     int* restrict rC_pLineErr);
+// the engine call-back of a command addressed to a group
+static void rC_fanDone(E_target* rC_pTarg,
+                       void* rC_uD);
+#endif
 
 int rC_doSingleOperation(size_t rC_szStr_IPv4, const char* const rC_str_IPv4,
                          size_t rC_szStr_port, const char* const rC_str_port,
-                         const char rC_strMnemCd[static P_CST_MAXSZSTR_MNEMCD],
-                         enum r_mCodes rC_hwMod)
+                         size_t rC_numMnemCd,
+                         const char rC_strMnemCds[][P_CST_MAXSZSTR_MNEMCD],
+                         enum r_mCodes rC_hwMod,
+                         const rC_opts* restrict rC_pOpts)
 {
-   int rC_errCode = wRC_Cd_noError;
-   CURL* rC_pHan = CST_PVOID;
-   if (((!rC_szStr_IPv4 && rC_str_IPv4) ||
-        (rC_szStr_IPv4 && !rC_str_IPv4)) ||
-       ((!rC_szStr_port && rC_str_port) ||
-        (rC_szStr_port && !rC_str_port))) {
-      fputs(WRC_MSG_INCCHARR, stderr);
-      rC_errCode = wRC_Cd_incChArr;
+   L_board* rC_pBoard = CST_PVOID;
+   P_out* rC_comms = CST_PVOID;
+   C_cache rC_cache;
+   C_init(&rC_cache,
+          rC_pOpts -> rC_statTTL);
+   M_registry rC_reg;
+   M_init(&rC_reg);
+   rC_initLatency(rC_pOpts);
+   unsigned long rC_numSkip = 0;
+   int rC_errCode = rC_open(&rC_pBoard,
+                            rC_szStr_IPv4, rC_str_IPv4,
+                            rC_szStr_port, rC_str_port,
+                            rC_hwMod,
+                            &(rC_pOpts -> rC_policy));
+   if (rC_errCode)
+      goto RC_SINOP_EXIT;
+   const B_board* rC_pDesc = L_getBoard(rC_pBoard);
+   if (!rC_numMnemCd ||
+       !rC_strMnemCds) {
+      fputs(WRC_MSG_INVPAR, stderr);
+      rC_errCode = wRC_Cd_invP;
       goto RC_SINOP_EXIT;
    }
-   P_out rC_comm = {.p_oAct = oAct_numOAct};
-   rC_errCode = P_parseMnemCode(&rC_comm,
-                                rC_strMnemCd);
-   if (rC_errCode)
+   // every code is parsed before anything is sent
+   rC_comms = calloc(rC_numMnemCd, sizeof(P_out));
+   if (!rC_comms) {
+      fputs(WRC_MSG_HEAPMANFAIL, stderr);
+      rC_errCode = wRC_Cd_heapManFail;
       goto RC_SINOP_EXIT;
-   else if (rC_comm.p_oAct != oAct_quit) {
-      // creating the URL
-      unsigned rC_szStrUrl;
-      switch (rC_hwMod) {
-         case r_kmTronic: rC_szStrUrl = rC_szStr_IPv4 + RC_SZCOMM_KMT + 1;
-                          break;
-         case r_nc800:    rC_szStrUrl = rC_szStr_IPv4 + rC_szStr_port + RC_SZCOMM_NC8 + 1;
-                          break;
-         default:         rC_errCode = wRC_Cd_invP;
-                          fputs(WRC_MSG_INVPAR, stderr);
-                          goto RC_SINOP_EXIT;
-      }
-      char rC_strUrl[rC_szStrUrl];
-      rC_strUrl[rC_szStr_IPv4 - 1] = '/';
-      rC_strUrl[rC_szStrUrl - 1] = '\0';
-      memcpy(rC_strUrl, rC_str_IPv4, rC_szStr_IPv4 - 1);
-      // different URL components for different hardware models
-      switch (rC_hwMod) {
-         case r_kmTronic: memcpy(rC_strUrl + rC_szStr_IPv4, rC_KMTronic_comm[rC_comm.p_rID][rC_comm.p_fAct ? 1
-                                                                                                           : 0], RC_SZCOMM_KMT);
-                          break;
-         case r_nc800:    memcpy(rC_strUrl + rC_szStr_IPv4, rC_str_port, rC_szStr_port - 1);
-                          *(rC_strUrl + rC_szStr_IPv4 + rC_szStr_port - 1) = '/';
-                          memcpy(rC_strUrl + rC_szStr_IPv4 + rC_szStr_port, rC_nc800_comm[rC_comm.p_rID][rC_comm.p_fAct ? 1
-                                                                                                                        : 0], RC_SZCOMM_NC8);
-                          break;
-         default:         ; // suppresses a needless warning
-      }
-      rC_pHan = curl_easy_init();
-      if (!rC_pHan) {
-         fputs(WRC_MSG_UNSCEH, stderr);
-         rC_errCode = wRC_Cd_curl;
-         goto RC_SINOP_EXIT;
-      }
-      CURLcode rC_libCode = curl_easy_setopt(rC_pHan,
-                                             CURLOPT_PROTOCOLS,
-                                             CURLPROTO_HTTP | CURLPROTO_HTTPS);
-      if (rC_libCode) {
-         RC_CURLERRCODE(rC_libCode);
-         rC_errCode = wRC_Cd_curl;
-         goto RC_SINOP_EXIT;
-      }
-      rC_libCode = curl_easy_setopt(rC_pHan,
-                                    CURLOPT_WRITEFUNCTION,
-                                    rC_dl);
-      if (rC_libCode) {
-         RC_CURLERRCODE(rC_libCode);
-         rC_errCode = wRC_Cd_curl;
+   }
+   for (size_t i = 0; i < rC_numMnemCd; i++) {
+      rC_comms[i].p_oAct = oAct_numOAct;
+      rC_errCode = P_parseMnemCode(rC_comms + i,
+                                   rC_strMnemCds[i]);
+      if (rC_errCode)
          goto RC_SINOP_EXIT;
+   }
+   // the same handle is used, so that the connection is kept alive among the codes
+   for (size_t i = 0; i < rC_numMnemCd; i++) {
+      rC_chkDumpLatency(&rC_reg);
+      L_result rC_res;
+      r_stat rC_stat = R_DEF;
+      // a status query within the TTL of the cache does not reach the network
+      uint64_t rC_age = 0;
+      if (rC_comms[i].p_oAct == oAct_status &&
+          C_lookup(&rC_cache,
+                   rC_pDesc,
+                   &rC_stat,
+                   &rC_age)) {
+         if (rC_pOpts -> rC_outFmt == O_fmt_text) {
+            fprintf(stdout, "[INF] %s: cached (%.3f ms old)\n", rC_strMnemCds[i], (double) rC_age / S_NSPERMS);
+            rC_viewStat(rC_stat,
+                        rC_hwMod);
+         }
+         else {
+            const O_record rC_rec = {.o_seq = i + 1, .o_pBoard = rC_pDesc, .o_strComm = "status",
+                                     .o_time = -1, .o_stat = rC_stat, .o_fStat = true};
+            rC_emit(rC_pOpts,
+                    &rC_rec);
+         }
+         continue;
       }
-      char rC_htmlBuf[RC_MAXNUMCHS + 1] = {0};
-      rC_html_buf rC_dlData = {.rC_buf = rC_htmlBuf};
-      rC_libCode = curl_easy_setopt(rC_pHan,
-                                    CURLOPT_WRITEDATA,
-                                    (void*) &rC_dlData);
-      if (rC_libCode) {
-         RC_CURLERRCODE(rC_libCode);
-         rC_errCode = wRC_Cd_curl;
-         goto RC_SINOP_EXIT;
+      if (rC_isRedundant(&rC_cache,
+                         rC_pDesc,
+                         rC_comms + i,
+                         rC_pOpts,
+                         &rC_stat,
+                         &rC_age)) {
+         rC_numSkip++;
+         if (rC_pOpts -> rC_outFmt == O_fmt_text) {
+            fprintf(stdout, "[INF] %s: skipped, the relay is already in the requested state (%.3f ms old)\n", rC_strMnemCds[i], (double) rC_age / S_NSPERMS);
+            rC_viewStat(rC_stat,
+                        rC_hwMod);
+         }
+         else {
+            char rC_strComm[O_MAXSZCOMM];
+            O_describeComm(rC_comms + i,
+                           rC_strComm);
+            const O_record rC_rec = {.o_seq = i + 1, .o_pBoard = rC_pDesc, .o_strComm = rC_strComm,
+                                     .o_time = -1, .o_stat = rC_stat, .o_fStat = true};
+            rC_emit(rC_pOpts,
+                    &rC_rec);
+         }
+         continue;
       }
-      rC_libCode = curl_easy_setopt(rC_pHan,
-                                    CURLOPT_URL,
-                                    rC_strUrl);
-      if (rC_libCode) {
-         RC_CURLERRCODE(rC_libCode);
-         rC_errCode = wRC_Cd_curl;
+      const int rC_currErrCode = rC_exchange(rC_pBoard,
+                                             rC_comms + i,
+                                             &rC_res);
+      rC_recordLatency(&rC_reg,
+                       rC_pDesc,
+                       rC_pOpts,
+                       rC_currErrCode,
+                       &rC_res);
+      if (rC_storeStat(&rC_cache,
+                       rC_pDesc,
+                       rC_currErrCode,
+                       rC_res.l_resCode,
+                       rC_res.l_stat)) {
+         rC_errCode = wRC_Cd_heapManFail;
          goto RC_SINOP_EXIT;
       }
-      rC_libCode = curl_easy_perform(rC_pHan);
-      if (rC_libCode) {
-         RC_CURLERRCODE(rC_libCode);
-         rC_errCode = wRC_Cd_curl;
-         goto RC_SINOP_EXIT;
+      if (rC_currErrCode)
+         rC_errCode = rC_currErrCode;
+      if (rC_pOpts -> rC_outFmt != O_fmt_text) {
+         char rC_strComm[O_MAXSZCOMM];
+         O_describeComm(rC_comms + i,
+                        rC_strComm);
+         const O_record rC_rec = {.o_seq = i + 1, .o_pBoard = rC_pDesc, .o_strComm = rC_strComm,
+                                  .o_resCode = rC_res.l_resCode,
+                                  .o_libCode = rC_currErrCode == wRC_Cd_curl ? rC_res.l_libCode
+                                                                             : CURLE_OK,
+                                  .o_time = rC_res.l_totTime, .o_stat = rC_res.l_stat,
+                                  .o_fStat = !rC_currErrCode && rC_res.l_resCode == 200,
+                                  .o_numAttempt = rC_res.l_numAttempt};
+         rC_emit(rC_pOpts,
+                 &rC_rec);
+         continue;
       }
-      long rC_resCode = 200;
-      rC_libCode = curl_easy_getinfo(rC_pHan,
-                                    CURLINFO_RESPONSE_CODE,
-                                    &rC_resCode);
-      if (rC_libCode) {
-         RC_CURLERRCODE(rC_libCode);
-         rC_errCode = wRC_Cd_curl;
-         goto RC_SINOP_EXIT;
+      if (rC_currErrCode) {
+         fprintf(stdout, "[INF] %s: no response (%.3f ms)\n", rC_strMnemCds[i], rC_res.l_totTime / 1000.0);
+         continue;
       }
-      if (rC_resCode != 200)
-         fprintf(stdout, "[NOT] The last request yielded response code %ld\n", rC_resCode);
-      else {
-         rC_dlData.rC_szBuf++;
-         const r_stat rC_stat = P_parseHtmlResp(rC_dlData.rC_szBuf, rC_dlData.rC_buf,
-                                                rC_hwMod);
-         rC_viewStat(rC_stat,
+      fprintf(stdout, "[INF] %s: response code %ld (%.3f ms)\n", rC_strMnemCds[i], rC_res.l_resCode, rC_res.l_totTime / 1000.0);
+      if (rC_res.l_resCode != 200)
+         fprintf(stdout, "[NOT] The last request yielded response code %ld\n", rC_res.l_resCode);
+      else
+         rC_viewStat(rC_res.l_stat,
                      rC_hwMod);
-      }
    }
+   rC_viewCache(&rC_cache,
+                rC_pOpts,
+                rC_numSkip);
    RC_SINOP_EXIT:
-   curl_easy_cleanup(rC_pHan);
+   if (rC_pOpts -> rC_latRep == rC_lr_exit)
+      M_dump(&rC_reg,
+             stderr);
+   rC_publish(&rC_reg,
+              rC_pOpts -> rC_pathMetrics,
+              CST_PVOID);
+   L_closeBoard(rC_pBoard);
+   C_cleanup(&rC_cache);
+   M_cleanup(&rC_reg);
+   free(rC_comms);
+   rC_comms = CST_PVOID;
+   return rC_errCode;
+}
+
+int rC_doMaskOperation(size_t rC_szStr_IPv4, const char* const rC_str_IPv4,
+                       size_t rC_szStr_port, const char* const rC_str_port,
+                       enum r_mCodes rC_hwMod,
+                       r_stat rC_stat,
+                       const rC_opts* restrict rC_pOpts)
+{
+   L_board* rC_pBoard = CST_PVOID;
+   M_registry rC_reg;
+   M_init(&rC_reg);
+   int rC_errCode = rC_open(&rC_pBoard,
+                            rC_szStr_IPv4, rC_str_IPv4,
+                            rC_szStr_port, rC_str_port,
+                            rC_hwMod,
+                            &(rC_pOpts -> rC_policy));
+   if (rC_errCode)
+      goto RC_MASKOP_EXIT;
+   char rC_strMask[O_MAXSZCOMM] = "mask:";
+   const size_t rC_lenKey = strlen(rC_strMask);
+   for (unsigned i = 0; i < P_CST_NUMREL; i++)
+      rC_strMask[rC_lenKey + i] = (rC_stat & R_ON_MASK(i)) ? '1'
+                                                            : '0';
+   rC_strMask[rC_lenKey + P_CST_NUMREL] = '\0';
+   // the current status is not known: it is read only by the models that need it
+   L_result rC_res;
+   unsigned rC_numReq = 0;
+   rC_errCode = L_setMask(rC_pBoard,
+                          rC_stat,
+                          CST_PVOID,
+                          &rC_res,
+                          &rC_numReq);
+   // the outcome of the last request stands for the whole change
+   if (rC_numReq)
+      rC_recordLatency(&rC_reg,
+                       L_getBoard(rC_pBoard),
+                       rC_pOpts,
+                       rC_errCode,
+                       &rC_res);
+   rC_viewAttempts(rC_strMask,
+                   rC_numReq ? rC_res.l_numAttempt
+                             : 0,
+                   rC_res.l_attempts);
+   if (rC_pOpts -> rC_outFmt != O_fmt_text) {
+      if (rC_errCode == wRC_Cd_invP)
+         fputs(WRC_MSG_INVPAR, stderr);
+      const O_record rC_rec = {.o_seq = 1, .o_pBoard = L_getBoard(rC_pBoard), .o_strComm = rC_strMask,
+                               .o_resCode = rC_res.l_resCode, .o_libCode = rC_res.l_libCode,
+                               .o_time = rC_numReq ? rC_res.l_totTime
+                                                   : -1,
+                               .o_stat = rC_res.l_stat,
+                               .o_fStat = !rC_errCode,
+                               .o_numAttempt = rC_res.l_numAttempt};
+      rC_emit(rC_pOpts,
+              &rC_rec);
+      goto RC_MASKOP_EXIT;
+   }
+   switch (rC_errCode) {
+      case wRC_Cd_curl: RC_CURLERRCODE(rC_res.l_libCode);
+                        fprintf(stdout, "[INF] %s: no response (%.3f ms)\n", rC_strMask, rC_res.l_totTime / 1000.0);
+                        break;
+      case wRC_Cd_invP: fputs(WRC_MSG_INVPAR, stderr);
+                        break;
+      case wRC_Cd_resp: fprintf(stdout, "[NOT] The last request yielded response code %ld\n", rC_res.l_resCode);
+                        break;
+      default:          fprintf(stdout, "[INF] %s: response code %ld (%.3f ms)\n", rC_strMask, rC_res.l_resCode, rC_res.l_totTime / 1000.0);
+                        rC_viewStat(rC_res.l_stat,
+                                    rC_hwMod);
+   }
+   fprintf(stdout, "[INF] %s: %u request(s) sent\n", rC_strMask, rC_numReq);
+   RC_MASKOP_EXIT:
+   rC_publish(&rC_reg,
+              rC_pOpts -> rC_pathMetrics,
+              CST_PVOID);
+   L_closeBoard(rC_pBoard);
+   M_cleanup(&rC_reg);
    return rC_errCode;
 }
 
 int rC_doMultipleOperations(size_t rC_szStr_IPv4, const char* const rC_str_IPv4,
                             size_t rC_szStr_port, const char* const rC_str_port,
-                            enum r_mCodes rC_hwMod)
+                            enum r_mCodes rC_hwMod,
+                            const rC_opts* restrict rC_pOpts)
 {
-   int rC_errCode = wRC_Cd_noError;
-   CURL* rC_pHan = CST_PVOID;
-   char* rC_strUrl = CST_PVOID;
-   if (((!rC_szStr_IPv4 && rC_str_IPv4) ||
-        (rC_szStr_IPv4 && !rC_str_IPv4)) ||
-       ((!rC_szStr_port && rC_str_port) ||
-        (rC_szStr_port && !rC_str_port))) {
-      fputs(WRC_MSG_INCCHARR, stderr);
-      rC_errCode = wRC_Cd_incChArr;
+   L_board* rC_pBoard = CST_PVOID;
+   C_cache rC_cache;
+   C_init(&rC_cache,
+          rC_pOpts -> rC_statTTL);
+   M_registry rC_reg;
+   M_init(&rC_reg);
+   rC_initLatency(rC_pOpts);
+   unsigned long rC_numSkip = 0;
+   int rC_errCode = rC_open(&rC_pBoard,
+                            rC_szStr_IPv4, rC_str_IPv4,
+                            rC_szStr_port, rC_str_port,
+                            rC_hwMod,
+                            &(rC_pOpts -> rC_policy));
+   if (rC_errCode)
       goto RC_MULTOP_EXIT;
-   }
+   const B_board* rC_pDesc = L_getBoard(rC_pBoard);
    P_out rC_comm = {0};
-   // creating the URL
-   unsigned rC_szStrUrl;
-   switch (rC_hwMod) {
-      case r_kmTronic: rC_szStrUrl = rC_szStr_IPv4 + RC_SZCOMM_KMT + 1;
-                       break;
-      case r_nc800:    rC_szStrUrl = rC_szStr_IPv4 + rC_szStr_port + RC_SZCOMM_NC8 + 1;
-                       break;
-      default:         rC_errCode = wRC_Cd_invP;
-                       fputs(WRC_MSG_INVPAR, stderr);
-                       goto RC_MULTOP_EXIT;
-   }
-   rC_strUrl = calloc(rC_szStrUrl, sizeof(char));
-   if (!rC_strUrl) {
-      fputs(WRC_MSG_HEAPMANFAIL, stderr);
-      rC_errCode = wRC_Cd_heapManFail;
-      goto RC_MULTOP_EXIT;
-   }
-   *(rC_strUrl + rC_szStr_IPv4 - 1) = '/';
-   memcpy(rC_strUrl, rC_str_IPv4, rC_szStr_IPv4 - 1);
-   switch (rC_hwMod) {
-      case r_kmTronic: break;
-      case r_nc800:    memcpy(rC_strUrl + rC_szStr_IPv4, rC_str_port, rC_szStr_port - 1);
-                       *(rC_strUrl + rC_szStr_IPv4 + rC_szStr_port - 1) = '/';
-                       break;
-      default:         ; // suppresses a needless warning
-   }
-   rC_pHan = curl_easy_init();
-   if (!rC_pHan) {
-      fputs(WRC_MSG_UNSCEH, stderr);
-      rC_errCode = wRC_Cd_curl;
-      goto RC_MULTOP_EXIT;
-   }
-   CURLcode rC_libCode = curl_easy_setopt(rC_pHan,
-                                          CURLOPT_PROTOCOLS,
-                                          CURLPROTO_HTTP | CURLPROTO_HTTPS);
-   if (rC_libCode) {
-      RC_CURLERRCODE(rC_libCode);
-      rC_errCode = wRC_Cd_curl;
-      goto RC_MULTOP_EXIT;
-   }
-   rC_libCode = curl_easy_setopt(rC_pHan,
-                                 CURLOPT_WRITEFUNCTION,
-                                 rC_dl);
-   if (rC_libCode) {
-      RC_CURLERRCODE(rC_libCode);
-      rC_errCode = wRC_Cd_curl;
-      goto RC_MULTOP_EXIT;
-   }
-   char rC_htmlBuf[RC_MAXNUMCHS + 1] = {0};
-   rC_html_buf rC_dlData = {.rC_buf = rC_htmlBuf};
-   rC_libCode = curl_easy_setopt(rC_pHan,
-                                 CURLOPT_WRITEDATA,
-                                 (void*) &rC_dlData);
-   if (rC_libCode) {
-      RC_CURLERRCODE(rC_libCode);
-      rC_errCode = wRC_Cd_curl;
-      goto RC_MULTOP_EXIT;
-   }
    fputs("** Author: Pavlo Nykolyn **\n\
 ** Powered by curl **\n\
                   ______    _____  _                   _\n\
@@ -275,6 +543,7 @@ __            __|  |_|  ||  |     | |______ | |______ | |\n\
    do {
       // obtaining a valid command
       do {
+         rC_chkDumpLatency(&rC_reg);
          rC_comm.p_oAct = oAct_numOAct;
          fputs("> ", stdout);
          rC_errCode = P_parseInput(&rC_comm);
@@ -284,116 +553,1460 @@ __            __|  |_|  ||  |     | |______ | |______ | |\n\
                goto RC_MULTOP_EXIT;
          }
       } while (rC_errCode == wRC_Cd_wrI);
-      if (rC_comm.p_oAct == oAct_numOAct) {
-         // adding the command to the URL
-         switch (rC_hwMod) {
-            case r_kmTronic: memcpy(rC_strUrl + rC_szStr_IPv4, rC_KMTronic_comm[rC_comm.p_rID][rC_comm.p_fAct ? 1
-                                                                                                              : 0], RC_SZCOMM_KMT);
-                             break;
-            case r_nc800:    memcpy(rC_strUrl + rC_szStr_IPv4 + rC_szStr_port, rC_nc800_comm[rC_comm.p_rID][rC_comm.p_fAct ? 1
-                                                                                                                           : 0], RC_SZCOMM_NC8);
-                             break;
-            default:         ; // suppresses a needless warning
-         }
+      r_stat rC_stat = R_DEF;
+      uint64_t rC_age = 0;
+      if (rC_comm.p_oAct == oAct_status &&
+          C_lookup(&rC_cache,
+                   rC_pDesc,
+                   &rC_stat,
+                   &rC_age)) {
+         fprintf(stdout, "[INF] cached status (%.3f ms old)\n", (double) rC_age / S_NSPERMS);
+         rC_viewStat(rC_stat,
+                     rC_hwMod);
+      }
+      else if (rC_isRedundant(&rC_cache,
+                              rC_pDesc,
+                              &rC_comm,
+                              rC_pOpts,
+                              &rC_stat,
+                              &rC_age)) {
+         rC_numSkip++;
+         fprintf(stdout, "[INF] skipped, the relay is already in the requested state (%.3f ms old)\n", (double) rC_age / S_NSPERMS);
+         rC_viewStat(rC_stat,
+                     rC_hwMod);
+         // resetting the shared variables
+         rC_comm.p_fAct = false;
+         rC_comm.p_rID = 0;
+      }
+      else if (rC_comm.p_oAct == oAct_numOAct ||
+               rC_comm.p_oAct == oAct_status) {
          // performing the operation
-         rC_libCode = curl_easy_setopt(rC_pHan,
-                                       CURLOPT_URL,
-                                       rC_strUrl);
-         if (rC_libCode) {
-            RC_CURLERRCODE(rC_libCode);
-            rC_errCode = wRC_Cd_curl;
-            goto RC_MULTOP_EXIT;
-         }
-         rC_libCode = curl_easy_perform(rC_pHan);
-         if (rC_libCode) {
-            RC_CURLERRCODE(rC_libCode);
-            rC_errCode = wRC_Cd_curl;
-            goto RC_MULTOP_EXIT;
-         }
-         long rC_resCode = 200;
-         rC_libCode = curl_easy_getinfo(rC_pHan,
-                                       CURLINFO_RESPONSE_CODE,
-                                       &rC_resCode);
-         if (rC_libCode) {
-            RC_CURLERRCODE(rC_libCode);
-            rC_errCode = wRC_Cd_curl;
+         L_result rC_res;
+         rC_errCode = rC_exchange(rC_pBoard,
+                                  &rC_comm,
+                                  &rC_res);
+         rC_recordLatency(&rC_reg,
+                          rC_pDesc,
+                          rC_pOpts,
+                          rC_errCode,
+                          &rC_res);
+         if (rC_storeStat(&rC_cache,
+                          rC_pDesc,
+                          rC_errCode,
+                          rC_res.l_resCode,
+                          rC_res.l_stat))
+            rC_errCode = wRC_Cd_heapManFail;
+         // the commands are typed by hand: the file is written after each one
+         rC_publish(&rC_reg,
+                    rC_pOpts -> rC_pathMetrics,
+                    CST_PVOID);
+         if (rC_errCode)
             goto RC_MULTOP_EXIT;
-         }
-         if (rC_resCode != 200)
-            fprintf(stdout, "[NOT] The last request yielded response code %ld\n", rC_resCode);
-         else {
-            rC_dlData.rC_szBuf++;
-            const r_stat rC_stat = P_parseHtmlResp(rC_dlData.rC_szBuf, rC_dlData.rC_buf,
-                                                   rC_hwMod);
-            rC_viewStat(rC_stat,
+         if (rC_res.l_resCode != 200)
+            fprintf(stdout, "[NOT] The last request yielded response code %ld\n", rC_res.l_resCode);
+         else
+            rC_viewStat(rC_res.l_stat,
                         rC_hwMod);
-         }
          // resetting the shared variables
-         memset(rC_htmlBuf, 0, rC_dlData.rC_szBuf);
-         rC_dlData.rC_szBuf = 0;
          rC_comm.p_fAct = false;
          rC_comm.p_rID = 0;
       }
    } while (rC_comm.p_oAct != oAct_quit);
+   rC_viewCache(&rC_cache,
+                rC_pOpts,
+                rC_numSkip);
    RC_MULTOP_EXIT:
-   curl_easy_cleanup(rC_pHan);
-   free(rC_strUrl);
-   rC_strUrl = CST_PVOID;
+   if (rC_pOpts -> rC_latRep == rC_lr_exit)
+      M_dump(&rC_reg,
+             stderr);
+   rC_publish(&rC_reg,
+              rC_pOpts -> rC_pathMetrics,
+              CST_PVOID);
+   L_closeBoard(rC_pBoard);
+   C_cleanup(&rC_cache);
+   M_cleanup(&rC_reg);
+   return rC_errCode;
+}
+
+#ifndef WRC_NATIVE_HTTP
+int rC_doConcurrentOperations(size_t rC_numTarg, E_target rC_targs[],
+                              unsigned rC_maxInFlight,
+                              const rC_opts* restrict rC_pOpts)
+{
+   rC_concSess rC_sess = {.rC_pOpts = rC_pOpts, .rC_targs = rC_targs, .rC_lastFail = wRC_Cd_noError};
+   M_init(&(rC_sess.rC_reg));
+   int rC_errCode = E_run(rC_numTarg, rC_targs,
+                          rC_maxInFlight,
+                          &(rC_pOpts -> rC_policy),
+                          rC_pOpts -> rC_hedgePct,
+                          rC_pOpts -> rC_qMode,
+                          rC_viewTarget,
+                          (void*) &rC_sess);
+   switch (rC_errCode) {
+      case wRC_Cd_noError: break;
+      case wRC_Cd_invP:    fputs(WRC_MSG_INVPAR, stderr);
+                           break;
+      default:             fputs(WRC_MSG_UNSCMH, stderr);
+   }
+   if (!rC_errCode)
+      rC_errCode = rC_sess.rC_lastFail;
+   rC_viewHedges(&(rC_sess.rC_reg),
+                 rC_pOpts);
+   rC_viewQueues(&(rC_sess.rC_reg),
+                 rC_pOpts);
+   rC_publish(&(rC_sess.rC_reg),
+              rC_pOpts -> rC_pathMetrics,
+              CST_PVOID);
+   M_cleanup(&(rC_sess.rC_reg));
+   return rC_errCode;
+}
+
+int rC_doBatchOperations(size_t rC_szStr_IPv4, const char* const rC_str_IPv4,
+                         size_t rC_szStr_port, const char* const rC_str_port,
+                         enum r_mCodes rC_hwMod,
+                         const char* const rC_pathScript,
+                         const char* const rC_pathGroups,
+                         unsigned rC_maxInFlight,
+                         const rC_opts* restrict rC_pOpts)
+{
+   // the array is optional if the commands may be addressed to groups
+   B_board rC_board;
+   const B_board* rC_pBoard = CST_PVOID;
+   int rC_errCode = wRC_Cd_noError;
+   if (!rC_pathGroups ||
+       rC_hwMod != r_numMod) {
+      rC_errCode = B_initBoard(&rC_board,
+                               rC_szStr_IPv4, rC_str_IPv4,
+                               rC_szStr_port, rC_str_port,
+                               rC_hwMod);
+      if (rC_errCode) {
+         fputs(rC_errCode == wRC_Cd_incChArr ? WRC_MSG_INCCHARR
+                                             : WRC_MSG_INVPAR, stderr);
+         return rC_errCode;
+      }
+      rC_pBoard = &rC_board;
+   }
+   rC_script* rC_pScript = calloc(1, sizeof(rC_script));
+   rC_batchCmd* rC_cmds = calloc(RC_BATCH_WINDOW, sizeof(rC_batchCmd));
+   if (!rC_pScript ||
+       !rC_cmds) {
+      free(rC_pScript);
+      free(rC_cmds);
+      fputs(WRC_MSG_HEAPMANFAIL, stderr);
+      return wRC_Cd_heapManFail;
+   }
+   rC_pScript -> rC_pFile = rC_pathScript ? fopen(rC_pathScript, "r")
+                                          : stdin;
+   if (!(rC_pScript -> rC_pFile)) {
+      fputs(WRC_MSG_NOSCRIPT, stderr);
+      free(rC_pScript);
+      free(rC_cmds);
+      return wRC_Cd_wrPPar;
+   }
+   M_registry rC_reg;
+   M_init(&rC_reg);
+   uint64_t rC_tPub = S_now();
+   G_group* rC_groups = CST_PVOID;
+   size_t rC_numGroup = 0;
+   E_engine rC_eng;
+   rC_errCode = E_init(&rC_eng,
+                       rC_maxInFlight,
+                       rC_batchDone,
+                       (void*) &rC_reg);
+   if (!rC_errCode)
+      rC_errCode = E_setPolicy(&rC_eng,
+                               &(rC_pOpts -> rC_policy));
+   if (!rC_errCode)
+      rC_errCode = E_setHedge(&rC_eng,
+                              rC_pOpts -> rC_hedgePct);
+   if (!rC_errCode)
+      rC_errCode = E_setQueue(&rC_eng,
+                              rC_pOpts -> rC_qMode);
+   if (rC_errCode) {
+      fputs(rC_errCode == wRC_Cd_invP ? WRC_MSG_INVPAR
+                                      : WRC_MSG_UNSCMH, stderr);
+      goto RC_BATCH_EXIT;
+   }
+   if (rC_pathGroups) {
+      rC_errCode = rC_loadGroups(rC_pathGroups,
+                                 &rC_groups,
+                                 &rC_numGroup);
+      if (rC_errCode)
+         goto RC_BATCH_EXIT;
+   }
+   if (rC_pOpts -> rC_fPreRes) {
+      if (rC_pBoard)
+         rC_preResolve(1, rC_pBoard,
+                       rC_pOpts);
+      for (size_t i = 0; i < rC_numGroup; i++)
+         rC_preResolve(rC_groups[i].g_numBoard, rC_groups[i].g_boards,
+                       rC_pOpts);
+   }
+   // the window of commands is a circular buffer: the results are printed in the order of the script
+   size_t rC_head = 0;
+   size_t rC_numCmd = 0;
+   unsigned long rC_numDone = 0;
+   unsigned long rC_numFail = 0;
+   int rC_lastFail = wRC_Cd_noError;
+   bool rC_fEnd = false;
+   // a command addressed to a group is a barrier: it waits for every previous command and the
+   // window is not filled until it is over
+   const G_group* rC_pGroup = CST_PVOID;
+   P_out rC_grpComm;
+   size_t rC_grpLine = 0;
+   const uint64_t rC_tStart = S_now();
+   while (!rC_fEnd ||
+          rC_numCmd ||
+          rC_pGroup) {
+      // filling the window
+      while (!rC_fEnd &&
+             !rC_pGroup &&
+             rC_numCmd < RC_BATCH_WINDOW) {
+         const char* rC_line = CST_PVOID;
+         size_t rC_lenLine = 0;
+         if (!rC_nextLine(rC_pScript,
+                          &rC_line,
+                          &rC_lenLine)) {
+            rC_fEnd = true;
+            break;
+         }
+         // empty lines and comments are ignored
+         size_t rC_posFst = 0;
+         while (rC_posFst < rC_lenLine &&
+                isspace(rC_line[rC_posFst]))
+            rC_posFst++;
+         if (rC_posFst == rC_lenLine ||
+             rC_line[rC_posFst] == '#')
+            continue;
+         rC_batchCmd* rC_pCmd = rC_cmds + (rC_head + rC_numCmd) % RC_BATCH_WINDOW;
+         memset(rC_pCmd, 0, sizeof(rC_batchCmd));
+         rC_pCmd -> rC_numLine = rC_pScript -> rC_numLine;
+         rC_pCmd -> rC_targ.e_pBoard = rC_pBoard;
+         rC_pCmd -> rC_targ.e_comm.p_oAct = oAct_numOAct;
+         const char* rC_strName = CST_PVOID;
+         size_t rC_lenName = 0;
+         const bool rC_fGroup = G_splitComm(rC_lenLine, rC_line,
+                                            &rC_lenLine,
+                                            &rC_strName,
+                                            &rC_lenName);
+         rC_pCmd -> rC_errCode = P_parseLine(&(rC_pCmd -> rC_targ.e_comm),
+                                             rC_lenLine, rC_line);
+         if (!(rC_pCmd -> rC_errCode) &&
+             !rC_fGroup &&
+             rC_pCmd -> rC_targ.e_comm.p_oAct == oAct_quit) {
+            rC_fEnd = true;
+            break;
+         }
+         if (!(rC_pCmd -> rC_errCode) &&
+             rC_fGroup &&
+             rC_pCmd -> rC_targ.e_comm.p_oAct != oAct_quit) {
+            rC_pGroup = G_find(rC_numGroup, rC_groups,
+                               rC_lenName, rC_strName);
+            if (rC_pGroup) {
+               // the slot is not taken: the group is processed once the window is empty
+               rC_grpComm = rC_pCmd -> rC_targ.e_comm;
+               rC_grpLine = rC_pCmd -> rC_numLine;
+               break;
+            }
+         }
+         // an unknown group, a group that is not valid and a command that has no array
+         if (rC_fGroup ||
+             !rC_pBoard)
+            rC_pCmd -> rC_errCode = wRC_Cd_wrI;
+         if (rC_pCmd -> rC_errCode)
+            rC_pCmd -> rC_state = RC_BS_DONE;
+         else
+            rC_pCmd -> rC_mask = rC_pCmd -> rC_targ.e_comm.p_oAct == oAct_status ? RC_BATCH_ALLREL
+                                                                                 : R_ON_MASK(rC_pCmd -> rC_targ.e_comm.p_rID);
+         rC_numCmd++;
+      }
+      // starting the commands that do not involve the relays of a previous unfinished command (the
+      // commands on the same relay keep the order of the script, a status query is a barrier). If the
+      // commands are queued by the engine, its queue of the array already keeps the order of the script:
+      // every command is submitted, so that a superseded one can be coalesced
+      const bool rC_fQueued = rC_pOpts -> rC_qMode != E_qm_none;
+      r_stat rC_busy = 0;
+      for (size_t i = 0; i < rC_numCmd &&
+                         rC_busy != RC_BATCH_ALLREL &&
+                         E_pending(&rC_eng) < rC_maxInFlight; i++) {
+         rC_batchCmd* rC_pCmd = rC_cmds + (rC_head + i) % RC_BATCH_WINDOW;
+         if (rC_pCmd -> rC_state == RC_BS_QUEUED &&
+             (rC_fQueued ||
+              !(rC_pCmd -> rC_mask & rC_busy))) {
+            rC_pCmd -> rC_state = RC_BS_ACTIVE;
+            rC_pCmd -> rC_tStart = S_now();
+            E_submit(&rC_eng, &(rC_pCmd -> rC_targ));
+         }
+         if (rC_pCmd -> rC_state != RC_BS_DONE &&
+             !rC_fQueued)
+            rC_busy |= rC_pCmd -> rC_mask;
+      }
+      // printing the results of the completed commands
+      while (rC_numCmd &&
+             rC_cmds[rC_head].rC_state == RC_BS_DONE) {
+         const rC_batchCmd* rC_pCmd = rC_cmds + rC_head;
+         rC_viewBatchCmd(rC_pCmd,
+                         rC_pOpts);
+         rC_numDone++;
+         int rC_currErrCode = rC_pCmd -> rC_errCode;
+         if (!rC_currErrCode)
+            rC_currErrCode = rC_pCmd -> rC_targ.e_errCode;
+         // a coalesced command has not been sent, it is not a failure
+         if (!rC_currErrCode &&
+             !(rC_pCmd -> rC_targ.e_fCoalesced) &&
+             rC_pCmd -> rC_targ.e_resCode != 200)
+            rC_currErrCode = wRC_Cd_resp;
+         if (rC_currErrCode) {
+            rC_numFail++;
+            rC_lastFail = rC_currErrCode;
+         }
+         rC_head = (rC_head + 1) % RC_BATCH_WINDOW;
+         rC_numCmd--;
+      }
+      if (rC_pGroup &&
+          !rC_numCmd) {
+         int rC_currErrCode = wRC_Cd_noError;
+         rC_errCode = rC_fanOut(rC_pGroup,
+                                &rC_grpComm,
+                                rC_grpLine,
+                                rC_maxInFlight,
+                                &rC_reg,
+                                rC_pOpts,
+                                &rC_currErrCode);
+         if (rC_errCode)
+            goto RC_BATCH_EXIT;
+         rC_numDone++;
+         if (rC_currErrCode) {
+            rC_numFail++;
+            rC_lastFail = rC_currErrCode;
+         }
+         rC_pGroup = CST_PVOID;
+      }
+      if (E_pending(&rC_eng)) {
+         rC_errCode = E_step(&rC_eng,
+                             RC_MAXWAIT_BATCH);
+         if (rC_errCode) {
+            fputs(WRC_MSG_UNSCMH, stderr);
+            goto RC_BATCH_EXIT;
+         }
+      }
+      rC_publish(&rC_reg,
+                 rC_pOpts -> rC_pathMetrics,
+                 &rC_tPub);
+   }
+   if (rC_pOpts -> rC_outFmt == O_fmt_text)
+      fprintf(stdout, "[INF] batch: %lu command(s), %lu failure(s), %.3f ms\n",
+              rC_numDone, rC_numFail, (double) (S_now() - rC_tStart) / S_NSPERMS);
+   rC_viewHedges(&rC_reg,
+                 rC_pOpts);
+   rC_viewQueues(&rC_reg,
+                 rC_pOpts);
+   rC_errCode = rC_lastFail;
+   RC_BATCH_EXIT:
+   E_cleanup(&rC_eng);
+   rC_publish(&rC_reg,
+              rC_pOpts -> rC_pathMetrics,
+              CST_PVOID);
+   M_cleanup(&rC_reg);
+   for (size_t i = 0; i < rC_numGroup; i++)
+      G_cleanup(rC_groups + i);
+   free(rC_groups);
+   if (rC_pathScript)
+      fclose(rC_pScript -> rC_pFile);
+   free(rC_pScript);
+   free(rC_cmds);
+   return rC_errCode;
+}
+
+int rC_doPulseOperations(size_t rC_numBoard, const B_board rC_boards[],
+                         size_t rC_numPulse, const P_pulse rC_pulses[],
+                         unsigned rC_maxInFlight,
+                         const rC_opts* restrict rC_pOpts)
+{
+   if (!rC_numBoard ||
+       !rC_boards ||
+       !rC_numPulse ||
+       !rC_pulses) {
+      fputs(WRC_MSG_INVPAR, stderr);
+      return wRC_Cd_invP;
+   }
+   const size_t rC_numState = rC_numBoard * rC_numPulse;
+   rC_pulse* rC_states = calloc(rC_numState, sizeof(rC_pulse));
+   if (!rC_states) {
+      fputs(WRC_MSG_HEAPMANFAIL, stderr);
+      return wRC_Cd_heapManFail;
+   }
+   rC_pulseSess rC_sess = {.rC_pOpts = rC_pOpts, .rC_states = rC_states, .rC_errCode = wRC_Cd_noError,
+                           .rC_lastFail = wRC_Cd_noError};
+   S_init(&(rC_sess.rC_heap));
+   M_init(&(rC_sess.rC_reg));
+   uint64_t rC_tPub = S_now();
+   E_engine rC_eng;
+   int rC_errCode = E_init(&rC_eng,
+                           rC_maxInFlight,
+                           rC_pulseDone,
+                           (void*) &rC_sess);
+   if (!rC_errCode)
+      rC_errCode = E_setPolicy(&rC_eng,
+                               &(rC_pOpts -> rC_policy));
+   if (!rC_errCode)
+      rC_errCode = E_setHedge(&rC_eng,
+                              rC_pOpts -> rC_hedgePct);
+   if (!rC_errCode)
+      rC_errCode = E_setQueue(&rC_eng,
+                              rC_pOpts -> rC_qMode);
+   if (rC_errCode) {
+      fputs(rC_errCode == wRC_Cd_invP ? WRC_MSG_INVPAR
+                                      : WRC_MSG_UNSCMH, stderr);
+      E_cleanup(&rC_eng);
+      S_cleanup(&(rC_sess.rC_heap));
+      free(rC_states);
+      return rC_errCode;
+   }
+   // every relay is turned on at once (within the limit of concurrent transfers)
+   for (size_t i = 0; i < rC_numState; i++) {
+      rC_pulse* rC_pState = rC_states + i;
+      rC_pState -> rC_targ.e_pBoard = rC_boards + i / rC_numPulse;
+      rC_pState -> rC_targ.e_comm.p_rID = rC_pulses[i % rC_numPulse].p_rID;
+      rC_pState -> rC_targ.e_comm.p_fAct = true;
+      rC_pState -> rC_targ.e_comm.p_oAct = oAct_numOAct;
+      rC_pState -> rC_dur = rC_pulses[i % rC_numPulse].p_dur * S_NSPERMS;
+      E_submit(&rC_eng, &(rC_pState -> rC_targ));
+   }
+   while (E_pending(&rC_eng) ||
+          rC_sess.rC_heap.s_numEvts) {
+      // starting the turn off commands that are due
+      S_event rC_evt;
+      const uint64_t rC_now = S_now();
+      while (S_peek(&(rC_sess.rC_heap), &rC_evt) &&
+             rC_evt.s_deadline <= rC_now) {
+         S_pop(&(rC_sess.rC_heap), CST_PVOID);
+         rC_pulse* rC_pState = (rC_pulse*) rC_evt.s_pData;
+         rC_pState -> rC_targ.e_comm.p_fAct = false;
+         rC_pState -> rC_tOffStart = S_now();
+         E_submit(&rC_eng, &(rC_pState -> rC_targ));
+      }
+      rC_errCode = E_step(&rC_eng,
+                          S_waitTime(&(rC_sess.rC_heap), RC_MAXWAIT_PULSE));
+      if (rC_errCode ||
+          rC_sess.rC_errCode) {
+         if (!rC_errCode)
+            rC_errCode = rC_sess.rC_errCode;
+         fputs(rC_errCode == wRC_Cd_heapManFail ? WRC_MSG_HEAPMANFAIL
+                                                : WRC_MSG_UNSCMH, stderr);
+         goto RC_PULSE_EXIT;
+      }
+      rC_publish(&(rC_sess.rC_reg),
+                 rC_pOpts -> rC_pathMetrics,
+                 &rC_tPub);
+   }
+   // the records have been written as soon as each command completed
+   if (rC_pOpts -> rC_outFmt == O_fmt_text)
+      for (size_t i = 0; i < rC_numState; i++)
+         rC_viewPulse(rC_states + i);
+   rC_viewHedges(&(rC_sess.rC_reg),
+                 rC_pOpts);
+   rC_viewQueues(&(rC_sess.rC_reg),
+                 rC_pOpts);
+   rC_errCode = rC_sess.rC_lastFail;
+   RC_PULSE_EXIT:
+   E_cleanup(&rC_eng);
+   rC_publish(&(rC_sess.rC_reg),
+              rC_pOpts -> rC_pathMetrics,
+              CST_PVOID);
+   M_cleanup(&(rC_sess.rC_reg));
+   S_cleanup(&(rC_sess.rC_heap));
+   free(rC_states);
+   return rC_errCode;
+}
+
+int rC_doDaemonOperations(size_t rC_numBoard, const B_board rC_boards[],
+                          const char* const rC_pathSock,
+                          unsigned rC_maxInFlight,
+                          const rC_opts* restrict rC_pOpts)
+{
+   N_daemon rC_dmn;
+   E_engine rC_eng;
+   memset(&rC_eng, 0, sizeof(E_engine));
+   int rC_errCode = N_init(&rC_dmn,
+                           rC_numBoard, rC_boards,
+                           rC_pathSock,
+                           rC_pOpts -> rC_outFmt);
+   if (rC_errCode)
+      goto RC_DAEMON_EXIT;
+   rC_errCode = E_init(&rC_eng,
+                       rC_maxInFlight,
+                       rC_daemonDone,
+                       (void*) &rC_dmn);
+   if (!rC_errCode)
+      rC_errCode = E_setPolicy(&rC_eng,
+                               &(rC_pOpts -> rC_policy));
+   if (!rC_errCode)
+      rC_errCode = E_setHedge(&rC_eng,
+                              rC_pOpts -> rC_hedgePct);
+   if (!rC_errCode)
+      rC_errCode = E_setQueue(&rC_eng,
+                              rC_pOpts -> rC_qMode);
+   if (!rC_errCode)
+      // the connection towards every array outlives its transfers
+      rC_errCode = E_keepConns(&rC_eng,
+                               (unsigned) (rC_numBoard < E_MAX_MAXINFLIGHT ? rC_numBoard
+                                                                           : E_MAX_MAXINFLIGHT) + rC_maxInFlight);
+   if (rC_errCode) {
+      fputs(rC_errCode == wRC_Cd_invP ? WRC_MSG_INVPAR
+                                      : WRC_MSG_UNSCMH, stderr);
+      goto RC_DAEMON_EXIT;
+   }
+   rC_initStop();
+   // the messages of a daemon reach its log as soon as they are printed
+   setvbuf(stdout, CST_PVOID, _IOLBF, 0);
+   // the connection towards each array is established at once (a status query)
+   N_warmUp(&rC_dmn,
+            &rC_eng);
+   fprintf(stdout, "[INF] daemon: listening on %s (%zu array(s))\n", rC_pathSock, rC_numBoard);
+   uint64_t rC_tPub = S_now();
+   while (!rC_fStop) {
+      rC_errCode = N_step(&rC_dmn,
+                          &rC_eng,
+                          RC_MAXWAIT_DAEMON);
+      if (rC_errCode) {
+         fputs(WRC_MSG_UNSCMH, stderr);
+         goto RC_DAEMON_EXIT;
+      }
+      rC_publish(&(rC_dmn.n_reg),
+                 rC_pOpts -> rC_pathMetrics,
+                 &rC_tPub);
+   }
+   fprintf(stdout, "[INF] daemon: %lu client(s), %lu request(s)\n", rC_dmn.n_numAcc, rC_dmn.n_numReq);
+   rC_viewHedges(&(rC_dmn.n_reg),
+                 rC_pOpts);
+   rC_viewQueues(&(rC_dmn.n_reg),
+                 rC_pOpts);
+   RC_DAEMON_EXIT:
+   // the requests that are still pending are aborted (they belong to the pool)
+   E_cleanup(&rC_eng);
+   rC_publish(&(rC_dmn.n_reg),
+              rC_pOpts -> rC_pathMetrics,
+              CST_PVOID);
+   N_cleanup(&rC_dmn);
+   return rC_errCode;
+}
+
+int rC_doCronOperations(size_t rC_numBoard, const B_board rC_boards[],
+                        const char* const rC_pathSched,
+                        unsigned rC_maxInFlight,
+                        const rC_opts* restrict rC_pOpts)
+{
+   rC_cronSess rC_sess = {.rC_pOpts = rC_pOpts};
+   E_engine rC_eng;
+   memset(&rC_eng, 0, sizeof(E_engine));
+   int rC_errCode = T_load(&(rC_sess.rC_tab),
+                           rC_pathSched,
+                           rC_numBoard, rC_boards);
+   if (rC_errCode) {
+      T_cleanup(&(rC_sess.rC_tab));
+      return rC_errCode;
+   }
+   rC_errCode = E_init(&rC_eng,
+                       rC_maxInFlight,
+                       rC_cronDone,
+                       (void*) &rC_sess);
+   if (!rC_errCode)
+      rC_errCode = E_setPolicy(&rC_eng,
+                               &(rC_pOpts -> rC_policy));
+   if (!rC_errCode)
+      rC_errCode = E_setHedge(&rC_eng,
+                              rC_pOpts -> rC_hedgePct);
+   if (!rC_errCode)
+      rC_errCode = E_setQueue(&rC_eng,
+                              rC_pOpts -> rC_qMode);
+   if (!rC_errCode)
+      // the connection towards every array outlives its transfers
+      rC_errCode = E_keepConns(&rC_eng,
+                               (unsigned) (rC_numBoard < E_MAX_MAXINFLIGHT ? rC_numBoard
+                                                                           : E_MAX_MAXINFLIGHT) + rC_maxInFlight);
+   if (rC_errCode) {
+      fputs(rC_errCode == wRC_Cd_invP ? WRC_MSG_INVPAR
+                                      : WRC_MSG_UNSCMH, stderr);
+      goto RC_CRON_EXIT;
+   }
+   rC_initStop();
+   struct sigaction rC_act;
+   memset(&rC_act, 0, sizeof(struct sigaction));
+   rC_act.sa_handler = rC_onSignal;
+   sigemptyset(&rC_act.sa_mask);
+   sigaction(SIGUSR1, &rC_act, CST_PVOID);
+   setvbuf(stdout, CST_PVOID, _IOLBF, 0);
+   if (rC_pOpts -> rC_outFmt == O_fmt_text)
+      fprintf(stdout, "[INF] cron: %zu entr%s, %zu array(s)\n", rC_sess.rC_tab.t_numJob, rC_sess.rC_tab.t_numJob == 1 ? "y"
+                                                                                                                   : "ies", rC_numBoard);
+   uint64_t rC_tPub = S_now();
+   while (!rC_fStop) {
+      T_run(&(rC_sess.rC_tab),
+            &rC_eng);
+      // waiting for the earliest event of the table (the wall clock is checked at least once per
+      // RC_MAXWAIT_CRON, so that a change of its time is noticed)
+      rC_errCode = E_step(&rC_eng,
+                          T_waitTime(&(rC_sess.rC_tab),
+                                     RC_MAXWAIT_CRON));
+      if (rC_errCode ||
+          rC_sess.rC_tab.t_errCode) {
+         if (!rC_errCode)
+            rC_errCode = rC_sess.rC_tab.t_errCode;
+         fputs(rC_errCode == wRC_Cd_heapManFail ? WRC_MSG_HEAPMANFAIL
+                                                : WRC_MSG_UNSCMH, stderr);
+         goto RC_CRON_EXIT;
+      }
+      if (rC_fDumpLat) {
+         rC_fDumpLat = 0;
+         T_view(&(rC_sess.rC_tab),
+                stderr);
+         M_dump(&(rC_sess.rC_tab.t_reg),
+                stderr);
+      }
+      rC_publish(&(rC_sess.rC_tab.t_reg),
+                 rC_pOpts -> rC_pathMetrics,
+                 &rC_tPub);
+   }
+   // a relay that is being pulsed is not left on: the turn off commands are sent at once and the
+   // commands in progress are completed
+   while (E_pending(&rC_eng) ||
+          rC_sess.rC_tab.t_offs.s_numEvts) {
+      T_stop(&(rC_sess.rC_tab),
+             &rC_eng);
+      rC_errCode = E_step(&rC_eng,
+                          RC_MAXWAIT_CRON);
+      if (rC_errCode ||
+          rC_sess.rC_tab.t_errCode) {
+         if (!rC_errCode)
+            rC_errCode = rC_sess.rC_tab.t_errCode;
+         fputs(rC_errCode == wRC_Cd_heapManFail ? WRC_MSG_HEAPMANFAIL
+                                                : WRC_MSG_UNSCMH, stderr);
+         goto RC_CRON_EXIT;
+      }
+   }
+   if (rC_pOpts -> rC_outFmt == O_fmt_text)
+      T_view(&(rC_sess.rC_tab),
+             stdout);
+   rC_viewHedges(&(rC_sess.rC_tab.t_reg),
+                 rC_pOpts);
+   rC_viewQueues(&(rC_sess.rC_tab.t_reg),
+                 rC_pOpts);
+   RC_CRON_EXIT:
+   E_cleanup(&rC_eng);
+   rC_publish(&(rC_sess.rC_tab.t_reg),
+              rC_pOpts -> rC_pathMetrics,
+              CST_PVOID);
+   T_cleanup(&(rC_sess.rC_tab));
+   return rC_errCode;
+}
+
+void rC_preResolve(size_t rC_numBoard, const B_board rC_boards[],
+                   const rC_opts* restrict rC_pOpts)
+{
+   const uint64_t rC_tStart = S_now();
+   size_t rC_numName = 0;
+   size_t rC_numFail = 0;
+   for (size_t i = 0; i < rC_numBoard; i++) {
+      const B_board* rC_pBoard = rC_boards + i;
+      if (!(rC_pBoard -> b_fName))
+         continue;
+      // few arrays are described: a linear search suffices
+      bool rC_fSeen = false;
+      for (size_t j = 0; j < i &&
+                         !rC_fSeen; j++)
+         rC_fSeen = rC_boards[j].b_lenHost == rC_pBoard -> b_lenHost &&
+                    !memcmp(rC_boards[j].b_strPref, rC_pBoard -> b_strPref, rC_pBoard -> b_lenHost);
+      if (rC_fSeen)
+         continue;
+      rC_numName++;
+      const CURLcode rC_libCode = B_resolve(rC_pBoard,
+                                            rC_pOpts -> rC_policy.l_connTimeout);
+      if (rC_libCode == CURLE_COULDNT_RESOLVE_HOST ||
+          rC_libCode == CURLE_FAILED_INIT) {
+         fprintf(stderr, "[NOT] %.*s cannot be resolved (curl error code %d)\n", (int) rC_pBoard -> b_lenHost, rC_pBoard -> b_strPref,
+                 (int) rC_libCode);
+         rC_numFail++;
+      }
+   }
+   if (rC_pOpts -> rC_outFmt == O_fmt_text)
+      fprintf(stdout, "[INF] pre-resolve: %zu name(s), %zu failure(s), %.3f ms\n",
+              rC_numName, rC_numFail, (double) (S_now() - rC_tStart) / S_NSPERMS);
+}
+#endif
+
+static int rC_open(L_board** rC_ppBoard,
+                   size_t rC_szStr_IPv4, const char* const rC_str_IPv4,
+                   size_t rC_szStr_port, const char* const rC_str_port,
+                   enum r_mCodes rC_hwMod,
+                   const L_policy* restrict rC_pPolicy)
+{
+   int rC_errCode = L_openBoard(rC_ppBoard,
+                                rC_szStr_IPv4, rC_str_IPv4,
+                                rC_szStr_port, rC_str_port,
+                                rC_hwMod);
+   if (!rC_errCode)
+      rC_errCode = L_setPolicy(*rC_ppBoard,
+                               rC_pPolicy);
+   switch (rC_errCode) {
+      case wRC_Cd_noError:     break;
+      case wRC_Cd_heapManFail: fputs(WRC_MSG_HEAPMANFAIL, stderr);
+                               break;
+      case wRC_Cd_incChArr:    fputs(WRC_MSG_INCCHARR, stderr);
+                               break;
+      case wRC_Cd_curl:        fputs(WRC_MSG_UNSCEH, stderr);
+                               break;
+      default:                 fputs(WRC_MSG_INVPAR, stderr);
+   }
    return rC_errCode;
 }
 
+static int rC_exchange(L_board* rC_pBoard,
+                       const P_out* restrict rC_pComm,
+                       L_result* restrict rC_pRes)
+{
+   const int rC_errCode = rC_pComm -> p_oAct == oAct_status ? L_readStat(rC_pBoard,
+                                                                         rC_pRes)
+                                                            : L_sendCommand(rC_pBoard,
+                                                                            (unsigned) rC_pComm -> p_rID,
+                                                                            rC_pComm -> p_fAct,
+                                                                            rC_pRes);
+   char rC_strComm[O_MAXSZCOMM];
+   O_describeComm(rC_pComm,
+                  rC_strComm);
+   rC_viewAttempts(rC_strComm,
+                   rC_pRes -> l_numAttempt,
+                   rC_pRes -> l_attempts);
+   switch (rC_errCode) {
+      case wRC_Cd_curl: RC_CURLERRCODE(rC_pRes -> l_libCode);
+                        return wRC_Cd_curl;
+      case wRC_Cd_invP: fputs(WRC_MSG_INVPAR, stderr);
+                        return wRC_Cd_invP;
+      default:          return wRC_Cd_noError; // the response code is checked by the caller
+   }
+}
+
+static void rC_viewAttempts(const char* const rC_strComm,
+                            unsigned rC_numAttempt,
+                            const L_attempt rC_attempts[])
+{
+   for (unsigned i = 0; i + 1 < rC_numAttempt; i++) {
+      if (rC_attempts[i].l_libCode)
+         fprintf(stderr, "[NOT] %s: attempt %u of %u failed with curl error code %d (%.3f ms)\n", rC_strComm, i + 1, rC_numAttempt, rC_attempts[i].l_libCode, rC_attempts[i].l_totTime / 1000.0);
+      else
+         fprintf(stderr, "[NOT] %s: attempt %u of %u yielded response code %ld (%.3f ms)\n", rC_strComm, i + 1, rC_numAttempt, rC_attempts[i].l_resCode, rC_attempts[i].l_totTime / 1000.0);
+   }
+}
+
+static int rC_storeStat(C_cache* restrict rC_pCache,
+                        const B_board* restrict rC_pBoard,
+                        int rC_errCode,
+                        long rC_resCode,
+                        r_stat rC_stat)
+{
+   if (rC_errCode ||
+       rC_resCode != 200) {
+      C_invalidate(rC_pCache,
+                   rC_pBoard);
+      return wRC_Cd_noError;
+   }
+   if (C_update(rC_pCache,
+                rC_pBoard,
+                rC_stat)) {
+      fputs(WRC_MSG_HEAPMANFAIL, stderr);
+      return wRC_Cd_heapManFail;
+   }
+   return wRC_Cd_noError;
+}
+
+static bool rC_isRedundant(const C_cache* restrict rC_pCache,
+                           const B_board* restrict rC_pBoard,
+                           const P_out* restrict rC_pComm,
+                           const rC_opts* restrict rC_pOpts,
+                           r_stat* restrict rC_pStat,
+                           uint64_t* restrict rC_pAge)
+{
+   if (!(rC_pOpts -> rC_fIdem) ||
+       rC_pComm -> p_oAct != oAct_numOAct ||
+       !C_peek(rC_pCache,
+               rC_pBoard,
+               rC_pOpts -> rC_maxStale,
+               rC_pStat,
+               rC_pAge))
+      return false;
+   // the commands are absolute
+   const bool rC_fOn = (*rC_pStat & R_ON_MASK(rC_pComm -> p_rID)) != 0;
+   return rC_fOn == rC_pComm -> p_fAct;
+}
+
+static void rC_onSignal(int rC_sig)
+{
+   rC_fDumpLat = 1;
+}
+
+static void rC_initLatency(const rC_opts* restrict rC_pOpts)
+{
+   if (rC_pOpts -> rC_latRep == rC_lr_none)
+      return;
+   struct sigaction rC_act;
+   memset(&rC_act, 0, sizeof(struct sigaction));
+   rC_act.sa_handler = rC_onSignal;
+   rC_act.sa_flags = SA_RESTART;
+   sigemptyset(&rC_act.sa_mask);
+   sigaction(SIGUSR1, &rC_act, CST_PVOID);
+}
+
+static void rC_recordLatency(M_registry* restrict rC_pReg,
+                             const B_board* restrict rC_pBoard,
+                             const rC_opts* restrict rC_pOpts,
+                             int rC_errCode,
+                             const L_result* restrict rC_pRes)
+{
+   if (rC_pOpts -> rC_latRep == rC_lr_none &&
+       !(rC_pOpts -> rC_pathMetrics))
+      return;
+   const M_sample rC_sample = {.m_times = {[M_ph_lookup] = rC_pRes -> l_lookupTime,
+                                           [M_ph_conn] = rC_pRes -> l_connTime,
+                                           [M_ph_ttfb] = rC_pRes -> l_ttfbTime,
+                                           [M_ph_total] = rC_pRes -> l_totTime},
+                               .m_numBytes = rC_pRes -> l_numRecv,
+                               .m_libCode = rC_errCode == wRC_Cd_curl ? rC_pRes -> l_libCode
+                                                                      : CURLE_OK,
+                               .m_resCode = rC_pRes -> l_resCode,
+                               .m_stat = rC_pRes -> l_stat,
+                               .m_fParsed = rC_pRes -> l_fParsed,
+                               .m_numRetry = rC_pRes -> l_numAttempt ? rC_pRes -> l_numAttempt - 1
+                                                                     : 0,
+                               .m_fNewConn = rC_pRes -> l_fNewConn,
+                               .m_fHandshake = rC_pRes -> l_fHandshake,
+                               .m_queueTime = -1};
+   if (rC_pOpts -> rC_latRep != rC_lr_none &&
+       rC_pOpts -> rC_outFmt == O_fmt_text)
+      fprintf(stdout, "[INF] lookup %.3f ms, connect %.3f ms, first byte %.3f ms, total %.3f ms, %lld byte(s), %s\n",
+              rC_pRes -> l_lookupTime / 1000.0, rC_pRes -> l_connTime / 1000.0, rC_pRes -> l_ttfbTime / 1000.0,
+              rC_pRes -> l_totTime / 1000.0, rC_pRes -> l_numRecv,
+              rC_pRes -> l_fHandshake ? "TLS handshake"
+                                      : rC_pRes -> l_fNewConn ? "new connection"
+                                                              : "kept-alive connection");
+   if (M_record(rC_pReg,
+                rC_pBoard,
+                &rC_sample))
+      fputs(WRC_MSG_HEAPMANFAIL, stderr);
+}
+
+static void rC_chkDumpLatency(const M_registry* restrict rC_pReg)
+{
+   if (!rC_fDumpLat)
+      return;
+   rC_fDumpLat = 0;
+   M_dump(rC_pReg,
+          stderr);
+}
+
+#ifndef WRC_NATIVE_HTTP
+static void rC_recordTarget(M_registry* restrict rC_pReg,
+                            const E_target* restrict rC_pTarg)
+{
+   const B_xferInfo* rC_pInfo = &(rC_pTarg -> e_info);
+   const M_sample rC_sample = {.m_times = {[M_ph_lookup] = rC_pInfo -> b_lookupTime,
+                                           [M_ph_conn] = rC_pInfo -> b_connTime,
+                                           [M_ph_ttfb] = rC_pInfo -> b_ttfbTime,
+                                           [M_ph_total] = rC_pInfo -> b_totTime},
+                               .m_numBytes = rC_pInfo -> b_numRecv,
+                               .m_libCode = rC_pTarg -> e_errCode == wRC_Cd_curl ? (int) rC_pTarg -> e_libCode
+                                                                                 : CURLE_OK,
+                               .m_resCode = rC_pTarg -> e_resCode,
+                               .m_stat = rC_pTarg -> e_stat,
+                               .m_fParsed = rC_pInfo -> b_fParsed,
+                               .m_numRetry = rC_pTarg -> e_numAttempt ? rC_pTarg -> e_numAttempt - 1
+                                                                      : 0,
+                               .m_fHedged = rC_pTarg -> e_fHedged,
+                               .m_fHedgeWon = rC_pTarg -> e_fHedgeWon,
+                               .m_fCoalesced = rC_pTarg -> e_fCoalesced,
+                               .m_fNewConn = rC_pInfo -> b_fNewConn,
+                               .m_fHandshake = rC_pInfo -> b_fHandshake,
+                               .m_queueTime = rC_pTarg -> e_fCoalesced ? -1
+                                                                       : (long long) (rC_pTarg -> e_queueTime / 1000U),
+                               .m_depth = rC_pTarg -> e_depth};
+   char rC_strComm[O_MAXSZCOMM];
+   O_describeComm(&(rC_pTarg -> e_comm),
+                  rC_strComm);
+   rC_viewAttempts(rC_strComm,
+                   rC_pTarg -> e_numAttempt,
+                   rC_pTarg -> e_attempts);
+   if (M_record(rC_pReg,
+                rC_pTarg -> e_pBoard,
+                &rC_sample))
+      fputs(WRC_MSG_HEAPMANFAIL, stderr);
+}
+#endif
+
+static void rC_publish(const M_registry* restrict rC_pReg,
+                       const char* const rC_path,
+                       uint64_t* restrict rC_pTLast)
+{
+   if (!rC_path)
+      return;
+   if (rC_pTLast) {
+      const uint64_t rC_now = S_now();
+      if (rC_now - *rC_pTLast < (uint64_t) RC_METRICS_PERIOD * S_NSPERMS)
+         return;
+      *rC_pTLast = rC_now;
+   }
+   if (M_writeProm(rC_pReg,
+                   rC_path))
+      fputs(WRC_MSG_NOMETRICS, stderr);
+}
+
+static void rC_emit(const rC_opts* restrict rC_pOpts,
+                    const O_record* restrict rC_pRec)
+{
+   if (!O_emit(rC_pOpts -> rC_outFmt,
+               rC_pRec,
+               STDOUT_FILENO))
+      fputs(WRC_MSG_NOOUTPUT, stderr);
+}
+
+#ifndef WRC_NATIVE_HTTP
+static void rC_emitTarget(const rC_opts* restrict rC_pOpts,
+                          size_t rC_seq,
+                          const E_target* restrict rC_pTarg)
+{
+   char rC_strComm[O_MAXSZCOMM];
+   O_describeComm(&(rC_pTarg -> e_comm),
+                  rC_strComm);
+   const bool rC_fCurl = rC_pTarg -> e_errCode == wRC_Cd_curl;
+   const O_record rC_rec = {.o_seq = rC_seq, .o_pBoard = rC_pTarg -> e_pBoard, .o_strComm = rC_strComm,
+                            .o_resCode = rC_fCurl ? 0
+                                                  : rC_pTarg -> e_resCode,
+                            .o_libCode = rC_fCurl ? (int) rC_pTarg -> e_libCode
+                                                  : CURLE_OK,
+                            .o_time = rC_pTarg -> e_fCoalesced ? -1
+                                                               : rC_pTarg -> e_info.b_totTime,
+                            .o_stat = rC_pTarg -> e_stat,
+                            .o_fStat = !rC_fCurl && rC_pTarg -> e_resCode == 200,
+                            .o_numAttempt = rC_pTarg -> e_numAttempt};
+   rC_emit(rC_pOpts,
+           &rC_rec);
+}
+
+static void rC_viewHedges(const M_registry* restrict rC_pReg,
+                          const rC_opts* restrict rC_pOpts)
+{
+   if (!(rC_pOpts -> rC_hedgePct) ||
+       rC_pOpts -> rC_outFmt != O_fmt_text)
+      return;
+   for (size_t i = 0; i < rC_pReg -> m_numBoards; i++) {
+      const M_board* rC_pEntry = rC_pReg -> m_boards + i;
+      fprintf(stdout, "[INF] %s: %lu request(s), %lu hedged, %lu won by the hedge\n", rC_pEntry -> m_strPref, rC_pEntry -> m_numReq, rC_pEntry -> m_numHedge, rC_pEntry -> m_numHedgeWon);
+   }
+}
+
+static void rC_viewQueues(const M_registry* restrict rC_pReg,
+                          const rC_opts* restrict rC_pOpts)
+{
+   if (rC_pOpts -> rC_qMode == E_qm_none ||
+       rC_pOpts -> rC_outFmt != O_fmt_text)
+      return;
+   for (size_t i = 0; i < rC_pReg -> m_numBoards; i++) {
+      const M_board* rC_pEntry = rC_pReg -> m_boards + i;
+      fprintf(stdout, "[INF] %s: %lu request(s), %lu coalesced, largest queue depth %lu, queueing delay %.3f ms (p50) %.3f ms (p99)\n", rC_pEntry -> m_strPref, rC_pEntry -> m_numReq, rC_pEntry -> m_numCoal, rC_pEntry -> m_maxDepth,
+              M_quantile(&(rC_pEntry -> m_queue), 0.5) / 1000.0, M_quantile(&(rC_pEntry -> m_queue), 0.99) / 1000.0);
+   }
+}
+#endif
+
+static void rC_viewCache(const C_cache* restrict rC_pCache,
+                         const rC_opts* restrict rC_pOpts,
+                         unsigned long rC_numSkip)
+{
+   if (rC_pOpts -> rC_outFmt != O_fmt_text)
+      return;
+   if (rC_pCache -> c_ttl)
+      fprintf(stdout, "[INF] status cache: %lu hit(s), %lu miss(es)\n", rC_pCache -> c_numHit, rC_pCache -> c_numMiss);
+   if (rC_pOpts -> rC_fIdem)
+      fprintf(stdout, "[INF] idempotent mode: %lu command(s) skipped\n", rC_numSkip);
+}
+
 static void rC_viewStat(const r_stat rC_stat,
                         enum r_mCodes rC_hwMod)
 {
-   switch (rC_hwMod) {
-      case r_kmTronic: rC_viewStat_KMTronic(rC_stat);
-                       break;
-      case r_nc800:    rC_viewStat_NC800(rC_stat);
-                       break;
-      default:         ; // suppresses a needless warning
-   }
-}
-
-static void rC_viewStat_KMTronic(const r_stat rC_stat)
-{
-   fputs((rC_stat & R_ON_1) ? R_ON_1_MSG
-                            : R_OFF_1_MSG, stdout);
-   fputs((rC_stat & R_ON_2) ? R_ON_2_MSG
-                            : R_OFF_2_MSG, stdout);
-   fputs((rC_stat & R_ON_3) ? R_ON_3_MSG
-                            : R_OFF_3_MSG, stdout);
-   fputs((rC_stat & R_ON_4) ? R_ON_4_MSG
-                            : R_OFF_4_MSG, stdout);
-   fputs((rC_stat & R_ON_5) ? R_ON_5_MSG
-                            : R_OFF_5_MSG, stdout);
-   fputs((rC_stat & R_ON_6) ? R_ON_6_MSG
-                            : R_OFF_6_MSG, stdout);
-   fputs((rC_stat & R_ON_7) ? R_ON_7_MSG
-                            : R_OFF_7_MSG, stdout);
-   fputs((rC_stat & R_ON_8) ? R_ON_8_MSG
-                            : R_OFF_8_MSG, stdout);
-}
-
-static void rC_viewStat_NC800(const r_stat rC_stat)
-{
-   if (rC_stat & R_1R_MASK) {
-      fputs((rC_stat & R_ON_1) ? R_ON_1_MSG
-                               : R_OFF_1_MSG, stdout);
-      fputs((rC_stat & R_ON_2) ? R_ON_2_MSG
-                               : R_OFF_2_MSG, stdout);
-      fputs((rC_stat & R_ON_3) ? R_ON_3_MSG
-                               : R_OFF_3_MSG, stdout);
-      fputs((rC_stat & R_ON_4) ? R_ON_4_MSG
-                               : R_OFF_4_MSG, stdout);
-   }
-   else if (rC_stat & R_2R_MASK) {
-      fputs((rC_stat & R_ON_5) ? R_ON_5_MSG
-                               : R_OFF_5_MSG, stdout);
-      fputs((rC_stat & R_ON_6) ? R_ON_6_MSG
-                               : R_OFF_6_MSG, stdout);
-      fputs((rC_stat & R_ON_7) ? R_ON_7_MSG
-                               : R_OFF_7_MSG, stdout);
-      fputs((rC_stat & R_ON_8) ? R_ON_8_MSG
-                               : R_OFF_8_MSG, stdout);
+   // the first column holds the messages of the relays that are off
+   static const char* rC_msgs[P_CST_NUMREL][2] = {{R_OFF_1_MSG, R_ON_1_MSG},
+                                                  {R_OFF_2_MSG, R_ON_2_MSG},
+                                                  {R_OFF_3_MSG, R_ON_3_MSG},
+                                                  {R_OFF_4_MSG, R_ON_4_MSG},
+                                                  {R_OFF_5_MSG, R_ON_5_MSG},
+                                                  {R_OFF_6_MSG, R_ON_6_MSG},
+                                                  {R_OFF_7_MSG, R_ON_7_MSG},
+                                                  {R_OFF_8_MSG, R_ON_8_MSG}};
+   const D_model* rC_pMod = D_getModel(rC_hwMod);
+   if (!rC_pMod)
+      return;
+   unsigned rC_first = 0;
+   unsigned rC_end = rC_pMod -> d_numRel;
+   // only the first row that holds a relay that is on is described
+   if (rC_pMod -> d_szRow) {
+      for (; rC_first < rC_pMod -> d_numRel; rC_first += rC_pMod -> d_szRow) {
+         rC_end = rC_first + rC_pMod -> d_szRow < rC_pMod -> d_numRel ? rC_first + rC_pMod -> d_szRow
+                                                                     : rC_pMod -> d_numRel;
+         r_stat rC_row = R_DEF;
+         for (unsigned i = rC_first; i < rC_end; i++)
+            rC_row |= R_ON_MASK(i);
+         if (rC_stat & rC_row)
+            break;
+      }
+   }
+   for (unsigned i = rC_first; i < rC_end; i++)
+      fputs(rC_msgs[i][(rC_stat & R_ON_MASK(i)) ? 1
+                                                 : 0], stdout);
+}
+
+#ifndef WRC_NATIVE_HTTP
+static void rC_viewTarget(E_target* rC_pTarg,
+                          void* rC_uD)
+{
+   rC_concSess* rC_pSess = (rC_concSess*) rC_uD;
+   rC_recordTarget(&(rC_pSess -> rC_reg),
+                   rC_pTarg);
+   // a coalesced target has not been sent, it is not a failure
+   if (rC_pTarg -> e_errCode)
+      rC_pSess -> rC_lastFail = rC_pTarg -> e_errCode;
+   else if (!(rC_pTarg -> e_fCoalesced) &&
+            rC_pTarg -> e_resCode != 200)
+      rC_pSess -> rC_lastFail = wRC_Cd_resp;
+   if (rC_pSess -> rC_pOpts -> rC_outFmt != O_fmt_text) {
+      rC_emitTarget(rC_pSess -> rC_pOpts,
+                    (size_t) (rC_pTarg - rC_pSess -> rC_targs) + 1,
+                    rC_pTarg);
+      return;
+   }
+   fprintf(stdout, "[INF] %s\n", rC_pTarg -> e_strUrl);
+   if (rC_pTarg -> e_fCoalesced)
+      fputs("[INF] coalesced: superseded by a later command on the same relay\n", stdout);
+   else if (rC_pTarg -> e_errCode == wRC_Cd_curl)
+      RC_CURLERRCODE(rC_pTarg -> e_libCode);
+   else if (rC_pTarg -> e_resCode != 200)
+      fprintf(stdout, "[NOT] The last request yielded response code %ld\n", rC_pTarg -> e_resCode);
+   else
+      rC_viewStat(rC_pTarg -> e_stat,
+                  rC_pTarg -> e_pBoard -> b_hwMod);
+}
+
+static void rC_pulseDone(E_target* rC_pTarg,
+                         void* rC_uD)
+{
+   rC_pulseSess* rC_pSess = (rC_pulseSess*) rC_uD;
+   // the target is the first member of its pulse
+   rC_pulse* rC_pState = (rC_pulse*) rC_pTarg;
+   const uint64_t rC_now = S_now();
+   rC_recordTarget(&(rC_pSess -> rC_reg),
+                   rC_pTarg);
+   if (rC_pSess -> rC_pOpts -> rC_outFmt != O_fmt_text)
+      rC_emitTarget(rC_pSess -> rC_pOpts,
+                    (size_t) (rC_pState - rC_pSess -> rC_states) + 1,
+                    rC_pTarg);
+   if (rC_pTarg -> e_errCode)
+      rC_pSess -> rC_lastFail = rC_pTarg -> e_errCode;
+   else if (rC_pTarg -> e_resCode != 200)
+      rC_pSess -> rC_lastFail = wRC_Cd_resp;
+   if (rC_pTarg -> e_comm.p_fAct) {
+      rC_pState -> rC_tOnDone = rC_now;
+      rC_pState -> rC_onErrCode = rC_pTarg -> e_errCode;
+      rC_pState -> rC_onResCode = rC_pTarg -> e_resCode;
+      // the turn off command is scheduled even if the turn on command failed (the state of the
+      // relay is unknown and the command is absolute)
+      rC_pState -> rC_tOffDue = rC_now + rC_pState -> rC_dur;
+      const int rC_errCode = S_push(&(rC_pSess -> rC_heap),
+                                    rC_pState -> rC_tOffDue,
+                                    (void*) rC_pState);
+      if (rC_errCode &&
+          !(rC_pSess -> rC_errCode))
+         rC_pSess -> rC_errCode = rC_errCode;
    }
+   else
+      rC_pState -> rC_tOffDone = rC_now;
+}
+
+static void rC_viewPulse(const rC_pulse* restrict rC_pPulse)
+{
+   const E_target* rC_pTarg = &(rC_pPulse -> rC_targ);
+   fprintf(stdout, "[INF] pulse of relay %d of %s\n", rC_pTarg -> e_comm.p_rID + 1, rC_pTarg -> e_pBoard -> b_strPref);
+   if (rC_pPulse -> rC_onErrCode == wRC_Cd_curl ||
+       rC_pPulse -> rC_onResCode != 200)
+      fputs("[NOT] the turn on command failed\n", stdout);
+   if (rC_pTarg -> e_errCode == wRC_Cd_curl)
+      RC_CURLERRCODE(rC_pTarg -> e_libCode);
+   else if (rC_pTarg -> e_resCode != 200)
+      fprintf(stdout, "[NOT] The last request yielded response code %ld\n", rC_pTarg -> e_resCode);
+   fprintf(stdout, "      width %.3f ms (requested %.3f ms), jitter %.3f ms\n",
+           (double) (rC_pPulse -> rC_tOffDone - rC_pPulse -> rC_tOnDone) / S_NSPERMS,
+           (double) (rC_pPulse -> rC_dur) / S_NSPERMS,
+           (double) (rC_pPulse -> rC_tOffStart - rC_pPulse -> rC_tOffDue) / S_NSPERMS);
+   if (rC_pTarg -> e_errCode != wRC_Cd_curl &&
+       rC_pTarg -> e_resCode == 200)
+      rC_viewStat(rC_pTarg -> e_stat,
+                  rC_pTarg -> e_pBoard -> b_hwMod);
+}
+
+static bool rC_nextLine(rC_script* restrict rC_pScript,
+                        const char** rC_ppLine,
+                        size_t* restrict rC_pLenLine)
+{
+   while (true) {
+      const size_t rC_lenAvail = rC_pScript -> rC_len - rC_pScript -> rC_pos;
+      char* rC_pCurr = rC_pScript -> rC_buf + rC_pScript -> rC_pos;
+      const char* rC_pNL = memchr(rC_pCurr, '\n', rC_lenAvail);
+      if (rC_pNL) {
+         const size_t rC_lenLine = rC_pNL - rC_pCurr;
+         rC_pScript -> rC_pos += rC_lenLine + 1;
+         if (rC_pScript -> rC_fSkip) {
+            // the end of an overlong line
+            rC_pScript -> rC_fSkip = false;
+            continue;
+         }
+         rC_pScript -> rC_numLine++;
+         *rC_ppLine = rC_pCurr;
+         *rC_pLenLine = rC_lenLine;
+         return true;
+      }
+      if (rC_pScript -> rC_fEOF) {
+         // the last line may lack the new line character
+         rC_pScript -> rC_pos = rC_pScript -> rC_len;
+         if (!rC_lenAvail ||
+             rC_pScript -> rC_fSkip)
+            return false;
+         rC_pScript -> rC_numLine++;
+         *rC_ppLine = rC_pCurr;
+         *rC_pLenLine = rC_lenAvail;
+         return true;
+      }
+      if (rC_lenAvail == RC_BATCH_SZBUF) {
+         // a line cannot be longer than the buffer: what has been read is returned (the parser rejects
+         // it) and the rest is discarded
+         rC_pScript -> rC_pos = rC_pScript -> rC_len;
+         if (rC_pScript -> rC_fSkip)
+            continue;
+         rC_pScript -> rC_fSkip = true;
+         rC_pScript -> rC_numLine++;
+         *rC_ppLine = rC_pCurr;
+         *rC_pLenLine = rC_lenAvail;
+         return true;
+      }
+      // moving the partial line to the beginning of the buffer and reading the next block
+      memmove(rC_pScript -> rC_buf, rC_pCurr, rC_lenAvail);
+      rC_pScript -> rC_len = rC_lenAvail;
+      rC_pScript -> rC_pos = 0;
+      const size_t rC_numRead = fread(rC_pScript -> rC_buf + rC_lenAvail, 1,
+                                      RC_BATCH_SZBUF - rC_lenAvail,
+                                      rC_pScript -> rC_pFile);
+      rC_pScript -> rC_len += rC_numRead;
+      if (!rC_numRead)
+         rC_pScript -> rC_fEOF = true;
+   }
+}
+
+static void rC_batchDone(E_target* rC_pTarg,
+                         void* rC_uD)
+{
+   // the target is the first member of its command
+   rC_batchCmd* rC_pCmd = (rC_batchCmd*) rC_pTarg;
+   rC_pCmd -> rC_state = RC_BS_DONE;
+   rC_pCmd -> rC_tDone = S_now();
+   rC_recordTarget((M_registry*) rC_uD,
+                   rC_pTarg);
+}
+
+static void rC_viewBatchCmd(const rC_batchCmd* restrict rC_pCmd,
+                            const rC_opts* restrict rC_pOpts)
+{
+   // <line> <command> <outcome> <duration (milliseconds)> <status of relays 1 to 8>
+   const E_target* rC_pTarg = &(rC_pCmd -> rC_targ);
+   if (rC_pOpts -> rC_outFmt != O_fmt_text) {
+      if (!(rC_pCmd -> rC_errCode)) {
+         rC_emitTarget(rC_pOpts,
+                       rC_pCmd -> rC_numLine,
+                       rC_pTarg);
+         return;
+      }
+      const O_record rC_rec = {.o_seq = rC_pCmd -> rC_numLine, .o_pBoard = rC_pTarg -> e_pBoard, .o_strComm = CST_PVOID,
+                               .o_time = -1};
+      rC_emit(rC_pOpts,
+              &rC_rec);
+      return;
+   }
+   if (rC_pCmd -> rC_errCode) {
+      fprintf(stdout, "%zu - input - -\n", rC_pCmd -> rC_numLine);
+      return;
+   }
+   char rC_strComm[O_MAXSZCOMM];
+   O_describeComm(&(rC_pTarg -> e_comm),
+                  rC_strComm);
+   if (rC_pTarg -> e_fCoalesced) {
+      fprintf(stdout, "%zu %s coalesced - -\n", rC_pCmd -> rC_numLine, rC_strComm);
+      return;
+   }
+   const double rC_dur = (double) (rC_pCmd -> rC_tDone - rC_pCmd -> rC_tStart) / S_NSPERMS;
+   if (rC_pTarg -> e_errCode == wRC_Cd_curl) {
+      fprintf(stdout, "%zu %s curl:%d %.3f -\n", rC_pCmd -> rC_numLine, rC_strComm, rC_pTarg -> e_libCode + 0, rC_dur);
+      return;
+   }
+   char rC_strStat[P_CST_NUMREL + 1] = "-";
+   if (rC_pTarg -> e_resCode == 200) {
+      for (unsigned i = 0; i < P_CST_NUMREL; i++)
+         rC_strStat[i] = (rC_pTarg -> e_stat & R_ON_MASK(i)) ? '1'
+                                                             : '0';
+      rC_strStat[P_CST_NUMREL] = '\0';
+   }
+   fprintf(stdout, "%zu %s %ld %.3f %s\n", rC_pCmd -> rC_numLine, rC_strComm, rC_pTarg -> e_resCode, rC_dur, rC_strStat);
+}
+
+static void rC_onStop(int rC_sig)
+{
+   rC_fStop = 1;
+}
+
+static void rC_initStop(void)
+{
+   rC_fStop = 0;
+   struct sigaction rC_act;
+   memset(&rC_act, 0, sizeof(struct sigaction));
+   rC_act.sa_handler = rC_onStop;
+   sigemptyset(&rC_act.sa_mask);
+   sigaction(SIGINT, &rC_act, CST_PVOID);
+   sigaction(SIGTERM, &rC_act, CST_PVOID);
+}
+
+static void rC_daemonDone(E_target* rC_pTarg,
+                          void* rC_uD)
+{
+   N_daemon* rC_pDmn = (N_daemon*) rC_uD;
+   rC_recordTarget(&(rC_pDmn -> n_reg),
+                   rC_pTarg);
+   N_complete(rC_pDmn,
+              rC_pTarg);
+}
+
+static void rC_cronDone(E_target* rC_pTarg,
+                        void* rC_uD)
+{
+   rC_cronSess* rC_pSess = (rC_cronSess*) rC_uD;
+   // the target is the first member of its command
+   const T_job* rC_pJob = ((const T_command*) rC_pTarg) -> t_pJob;
+   rC_recordTarget(&(rC_pSess -> rC_tab.t_reg),
+                   rC_pTarg);
+   // the sequence number of a record is the line of the entry
+   if (rC_pSess -> rC_pOpts -> rC_outFmt != O_fmt_text)
+      rC_emitTarget(rC_pSess -> rC_pOpts,
+                    rC_pJob -> t_numLine,
+                    rC_pTarg);
+   else {
+      char rC_strComm[O_MAXSZCOMM];
+      O_describeComm(&(rC_pTarg -> e_comm),
+                     rC_strComm);
+      const int rC_lenPref = (int) rC_pTarg -> e_pBoard -> b_lenPref - 1;
+      if (rC_pTarg -> e_fCoalesced)
+         fprintf(stdout, "[INF] line %zu: %s of %.*s coalesced (superseded by a later command on the same relay)\n", rC_pJob -> t_numLine, rC_strComm,
+                 rC_lenPref, rC_pTarg -> e_pBoard -> b_strPref);
+      else if (rC_pTarg -> e_errCode == wRC_Cd_curl)
+         fprintf(stdout, "[NOT] line %zu: %s of %.*s failed (curl error code %d)\n", rC_pJob -> t_numLine, rC_strComm,
+                 rC_lenPref, rC_pTarg -> e_pBoard -> b_strPref, (int) rC_pTarg -> e_libCode);
+      else
+         fprintf(stdout, "[%s] line %zu: %s of %.*s, response code %ld (%.3f ms)\n", rC_pTarg -> e_resCode == 200 ? "INF"
+                                                                                                                 : "NOT",
+                 rC_pJob -> t_numLine, rC_strComm, rC_lenPref, rC_pTarg -> e_pBoard -> b_strPref,
+                 rC_pTarg -> e_resCode, rC_pTarg -> e_info.b_totTime / 1000.0);
+   }
+   T_complete(&(rC_pSess -> rC_tab),
+              rC_pTarg);
+}
+
+static int rC_loadGroups(const char* const rC_pathGroups,
+                         G_group** rC_pGroups,
+                         size_t* restrict rC_pNumGroup)
+{
+   rC_script* rC_pFile = calloc(1, sizeof(rC_script));
+   if (!rC_pFile) {
+      fputs(WRC_MSG_HEAPMANFAIL, stderr);
+      return wRC_Cd_heapManFail;
+   }
+   rC_pFile -> rC_pFile = fopen(rC_pathGroups, "r");
+   if (!(rC_pFile -> rC_pFile)) {
+      fputs(WRC_MSG_NOGROUPS, stderr);
+      free(rC_pFile);
+      return wRC_Cd_wrPPar;
+   }
+   G_group* rC_groups = CST_PVOID;
+   size_t rC_numGroup = 0;
+   size_t rC_cap = 0;
+   int rC_errCode = wRC_Cd_noError;
+   const char* rC_line;
+   size_t rC_lenLine;
+   while (rC_nextLine(rC_pFile,
+                      &rC_line,
+                      &rC_lenLine)) {
+      // empty lines and comments are ignored
+      while (rC_lenLine &&
+             isspace(*rC_line)) {
+         rC_line++;
+         rC_lenLine--;
+      }
+      if (!rC_lenLine ||
+          *rC_line == '#')
+         continue;
+      if (rC_numGroup == rC_cap) {
+         const size_t rC_newCap = rC_cap ? 2 * rC_cap
+                                         : 16U;
+         G_group* rC_newGroups = realloc(rC_groups, rC_newCap * sizeof(G_group));
+         if (!rC_newGroups) {
+            fputs(WRC_MSG_HEAPMANFAIL, stderr);
+            rC_errCode = wRC_Cd_heapManFail;
+            goto RC_LOADGROUPS_EXIT;
+         }
+         rC_groups = rC_newGroups;
+         rC_cap = rC_newCap;
+      }
+      G_group* rC_pGroup = rC_groups + rC_numGroup;
+      rC_errCode = G_parseGroup(rC_pGroup,
+                                rC_lenLine, rC_line);
+      if (rC_errCode == wRC_Cd_heapManFail) {
+         fputs(WRC_MSG_HEAPMANFAIL, stderr);
+         goto RC_LOADGROUPS_EXIT;
+      }
+      if (!rC_errCode &&
+          G_find(rC_numGroup, rC_groups,
+                 strlen(rC_pGroup -> g_name), rC_pGroup -> g_name)) {
+         G_cleanup(rC_pGroup);
+         rC_errCode = wRC_Cd_wrI;
+      }
+      if (rC_errCode) {
+         RC_WRGROUP(rC_pFile -> rC_numLine);
+         rC_errCode = wRC_Cd_wrI;
+         goto RC_LOADGROUPS_EXIT;
+      }
+      rC_numGroup++;
+   }
+   if (ferror(rC_pFile -> rC_pFile) ||
+       !rC_numGroup) {
+      fputs(WRC_MSG_NOGROUPS, stderr);
+      rC_errCode = wRC_Cd_wrPPar;
+   }
+   RC_LOADGROUPS_EXIT:
+   fclose(rC_pFile -> rC_pFile);
+   free(rC_pFile);
+   if (rC_errCode) {
+      for (size_t i = 0; i < rC_numGroup; i++)
+         G_cleanup(rC_groups + i);
+      free(rC_groups);
+      return rC_errCode;
+   }
+   *rC_pGroups = rC_groups;
+   *rC_pNumGroup = rC_numGroup;
+   return wRC_Cd_noError;
+}
+
+static int rC_fanOut(const G_group* restrict rC_pGroup,
+                     const P_out* restrict rC_pComm,
+                     size_t rC_numLine,
+                     unsigned rC_maxInFlight,
+                     M_registry* restrict rC_pReg,
+                     const rC_opts* restrict rC_pOpts,
+                     int* restrict rC_pLineErr)
+{
+   E_target* rC_targs = calloc(rC_pGroup -> g_numBoard, sizeof(E_target));
+   if (!rC_targs) {
+      fputs(WRC_MSG_HEAPMANFAIL, stderr);
+      return wRC_Cd_heapManFail;
+   }
+   for (size_t i = 0; i < rC_pGroup -> g_numBoard; i++) {
+      rC_targs[i].e_pBoard = rC_pGroup -> g_boards + i;
+      rC_targs[i].e_comm = *rC_pComm;
+   }
+   const uint64_t rC_tStart = S_now();
+   int rC_errCode = E_run(rC_pGroup -> g_numBoard, rC_targs,
+                          rC_maxInFlight,
+                          &(rC_pOpts -> rC_policy),
+                          rC_pOpts -> rC_hedgePct,
+                          rC_pOpts -> rC_qMode,
+                          rC_fanDone,
+                          (void*) rC_pReg);
+   const double rC_wall = (double) (S_now() - rC_tStart) / S_NSPERMS;
+   if (rC_errCode) {
+      switch (rC_errCode) {
+         case wRC_Cd_invP:        fputs(WRC_MSG_INVPAR, stderr);
+                                  break;
+         case wRC_Cd_heapManFail: fputs(WRC_MSG_HEAPMANFAIL, stderr);
+                                  break;
+         default:                 fputs(WRC_MSG_UNSCMH, stderr);
+      }
+      free(rC_targs);
+      return rC_errCode;
+   }
+   // the members are reported in the order of the group
+   // <line> <command> <outcome> <duration (milliseconds)> <status of relays 1 to 8> <array>
+   char rC_strComm[O_MAXSZCOMM];
+   O_describeComm(rC_pComm,
+                  rC_strComm);
+   size_t rC_numFail = 0;
+   int rC_lastFail = wRC_Cd_noError;
+   for (size_t i = 0; i < rC_pGroup -> g_numBoard; i++) {
+      const E_target* rC_pTarg = rC_targs + i;
+      int rC_currErrCode = rC_pTarg -> e_errCode;
+      // a coalesced member has not been sent, it is not a failure
+      if (!rC_currErrCode &&
+          !(rC_pTarg -> e_fCoalesced) &&
+          rC_pTarg -> e_resCode != 200)
+         rC_currErrCode = wRC_Cd_resp;
+      if (rC_currErrCode) {
+         rC_numFail++;
+         rC_lastFail = rC_currErrCode;
+      }
+      if (rC_pOpts -> rC_outFmt != O_fmt_text) {
+         rC_emitTarget(rC_pOpts,
+                       rC_numLine,
+                       rC_pTarg);
+         continue;
+      }
+      // the trailing separator of the URL prefix is dropped
+      const B_board* rC_pBoard = rC_pTarg -> e_pBoard;
+      const int rC_lenBoard = (int) (rC_pBoard -> b_lenPref ? rC_pBoard -> b_lenPref - 1
+                                                            : 0);
+      const double rC_dur = (double) rC_pTarg -> e_info.b_totTime / 1000.0;
+      if (rC_pTarg -> e_errCode == wRC_Cd_curl) {
+         fprintf(stdout, "%zu %s curl:%d %.3f - %.*s\n", rC_numLine, rC_strComm, rC_pTarg -> e_libCode + 0, rC_dur,
+                 rC_lenBoard, rC_pBoard -> b_strPref);
+         continue;
+      }
+      if (rC_pTarg -> e_errCode) {
+         fprintf(stdout, "%zu %s error - - %.*s\n", rC_numLine, rC_strComm, rC_lenBoard, rC_pBoard -> b_strPref);
+         continue;
+      }
+      if (rC_pTarg -> e_fCoalesced) {
+         fprintf(stdout, "%zu %s coalesced - - %.*s\n", rC_numLine, rC_strComm, rC_lenBoard, rC_pBoard -> b_strPref);
+         continue;
+      }
+      char rC_strStat[P_CST_NUMREL + 1] = "-";
+      if (rC_pTarg -> e_resCode == 200) {
+         for (unsigned j = 0; j < P_CST_NUMREL; j++)
+            rC_strStat[j] = (rC_pTarg -> e_stat & R_ON_MASK(j)) ? '1'
+                                                                : '0';
+         rC_strStat[P_CST_NUMREL] = '\0';
+      }
+      fprintf(stdout, "%zu %s %ld %.3f %s %.*s\n", rC_numLine, rC_strComm, rC_pTarg -> e_resCode, rC_dur, rC_strStat,
+              rC_lenBoard, rC_pBoard -> b_strPref);
+   }
+   if (rC_pOpts -> rC_outFmt == O_fmt_text)
+      fprintf(stdout, "[INF] line %zu: %s @%s: %zu array(s), %zu failure(s), %.3f ms\n",
+              rC_numLine, rC_strComm, rC_pGroup -> g_name, rC_pGroup -> g_numBoard, rC_numFail, rC_wall);
+   *rC_pLineErr = rC_lastFail;
+   free(rC_targs);
+   return wRC_Cd_noError;
+}
+
+static void rC_fanDone(E_target* rC_pTarg,
+                       void* rC_uD)
+{
+   rC_recordTarget((M_registry*) rC_uD,
+                   rC_pTarg);
 }
+#endif
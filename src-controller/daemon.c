@@ -0,0 +1,568 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "daemon.h"
+#include "parser.h"
+#include "constants.h"
+#include "err_wrapper.h"
+
+#define N_SZOUT   4096U  // initial size of the buffer that holds the responses that have not been sent to a client
+#define N_BACKLOG   16   // backlog of the listening socket
+// requests of a daemon, besides <array> <mnemonic code>
+#define N_REQ_METRICS  "metrics"
+#define N_REQ_QUIT     "quit"
+#define N_EOF          "# EOF\n"  // ends the metrics sent to a client
+
+// creates the listening socket of a daemon (a stale socket left by a previous instance is replaced)
+// returns one of the following error codes:
+// - wRC_Cd_noError;
+// - wRC_Cd_wrPPar (the error message is printed on stderr)
+static int n_listen(const char* const n_pathSock,
+                    int* restrict n_pLsn);
+// accepts a client
+static void n_accept(N_daemon* restrict n_pDmn);
+// closes the connection of a client (its pending requests are discarded once completed)
+static void n_closeClient(N_daemon* restrict n_pDmn,
+                          size_t n_idxCli);
+// reads the requests of a client
+static void n_readClient(N_daemon* restrict n_pDmn,
+                         size_t n_idxCli);
+// processes the complete requests of a client, as long as the pool of requests is not empty
+static void n_processClient(N_daemon* restrict n_pDmn,
+                            E_engine* restrict n_pEng,
+                            size_t n_idxCli);
+// processes a single request of a client (the line is not null-terminated)
+static void n_handleRequest(N_daemon* restrict n_pDmn,
+                            E_engine* restrict n_pEng,
+                            size_t n_idxCli,
+                            const char* n_line,
+                            size_t n_lenLine);
+// queues data that are to be sent to a client (false is returned if the client has been closed
+// because of a failed allocation)
+static bool n_queueOut(N_daemon* restrict n_pDmn,
+                       size_t n_idxCli,
+                       const char* n_data,
+                       size_t n_lenData);
+// queues the record of a response for a client
+static void n_respond(N_daemon* restrict n_pDmn,
+                      size_t n_idxCli,
+                      const O_record* restrict n_pRec);
+// queues the metrics of a daemon for a client, in the Prometheus text format terminated by # EOF
+static void n_sendMetrics(N_daemon* restrict n_pDmn,
+                          size_t n_idxCli);
+// sends the queued responses of a client without blocking (the client is closed once every
+// response has been sent, if it does not send requests anymore)
+static void n_flushClient(N_daemon* restrict n_pDmn,
+                          size_t n_idxCli);
+
+int N_init(N_daemon* restrict n_pDmn,
+           size_t n_numBoard, const B_board n_boards[],
+           const char* const n_pathSock,
+           enum O_formats n_fmt)
+{
+   memset(n_pDmn, 0, sizeof(N_daemon));
+   n_pDmn -> n_lsn = -1;
+   for (size_t i = 0; i < N_MAXCLI; i++)
+      n_pDmn -> n_clis[i].n_fd = -1;
+   M_init(&(n_pDmn -> n_reg));
+   if (!n_numBoard ||
+       !n_boards ||
+       !n_pathSock) {
+      fputs(WRC_MSG_INVPAR, stderr);
+      return wRC_Cd_invP;
+   }
+   // the responses are always meant for a program
+   n_pDmn -> n_fmt = n_fmt == O_fmt_text ? O_fmt_raw
+                                         : n_fmt;
+   n_pDmn -> n_numBoard = n_numBoard;
+   n_pDmn -> n_boards = n_boards;
+   n_pDmn -> n_reqs = calloc(N_MAXREQ, sizeof(N_request));
+   if (!(n_pDmn -> n_reqs)) {
+      fputs(WRC_MSG_HEAPMANFAIL, stderr);
+      return wRC_Cd_heapManFail;
+   }
+   for (size_t i = N_MAXREQ; i > 0; i--) {
+      n_pDmn -> n_reqs[i - 1].n_pNextFree = n_pDmn -> n_pFree;
+      n_pDmn -> n_pFree = n_pDmn -> n_reqs + i - 1;
+   }
+   const int n_errCode = n_listen(n_pathSock,
+                                  &(n_pDmn -> n_lsn));
+   if (!n_errCode)
+      n_pDmn -> n_pathSock = n_pathSock;
+   return n_errCode;
+}
+
+void N_warmUp(N_daemon* restrict n_pDmn,
+              E_engine* restrict n_pEng)
+{
+   for (size_t i = 0; i < n_pDmn -> n_numBoard &&
+                      n_pDmn -> n_pFree; i++) {
+      N_request* n_pReq = n_pDmn -> n_pFree;
+      n_pDmn -> n_pFree = n_pReq -> n_pNextFree;
+      memset(n_pReq, 0, sizeof(N_request));
+      n_pReq -> n_idxCli = N_NOCLI;
+      n_pReq -> n_targ.e_pBoard = n_pDmn -> n_boards + i;
+      n_pReq -> n_targ.e_comm.p_oAct = oAct_status;
+      E_submit(n_pEng, &(n_pReq -> n_targ));
+   }
+}
+
+int N_step(N_daemon* restrict n_pDmn,
+           E_engine* restrict n_pEng,
+           int n_timeout)
+{
+   struct curl_waitfd n_fds[N_MAXCLI + 1];
+   size_t n_idxFds[N_MAXCLI + 1];
+   // the listening socket is polled only if a slot is free; a client is not read while the pool
+   // of requests is empty or its buffer is full (the client waits within the socket buffer)
+   unsigned n_numFds = 0;
+   if (n_pDmn -> n_numCli < N_MAXCLI) {
+      n_fds[n_numFds] = (struct curl_waitfd) {.fd = n_pDmn -> n_lsn, .events = CURL_WAIT_POLLIN, .revents = 0};
+      n_idxFds[n_numFds++] = N_NOCLI;
+   }
+   for (size_t i = 0; i < N_MAXCLI; i++) {
+      const N_client* n_pCli = n_pDmn -> n_clis + i;
+      if (n_pCli -> n_fd < 0)
+         continue;
+      short n_events = 0;
+      if (!(n_pCli -> n_fQuit) &&
+          n_pCli -> n_lenIn < N_SZIN &&
+          n_pDmn -> n_pFree)
+         n_events |= CURL_WAIT_POLLIN;
+      if (n_pCli -> n_posOut < n_pCli -> n_lenOut)
+         n_events |= CURL_WAIT_POLLOUT;
+      if (!n_events)
+         continue;
+      n_fds[n_numFds] = (struct curl_waitfd) {.fd = n_pCli -> n_fd, .events = n_events, .revents = 0};
+      n_idxFds[n_numFds++] = i;
+   }
+   const int n_errCode = E_stepFds(n_pEng,
+                                   n_timeout,
+                                   n_fds, n_numFds);
+   if (n_errCode)
+      return n_errCode;
+   for (unsigned i = 0; i < n_numFds; i++) {
+      if (!n_fds[i].revents)
+         continue;
+      if (n_idxFds[i] == N_NOCLI) {
+         n_accept(n_pDmn);
+         continue;
+      }
+      // the client may have been closed by the engine call-back
+      if (n_pDmn -> n_clis[n_idxFds[i]].n_fd != n_fds[i].fd)
+         continue;
+      if (n_fds[i].revents & CURL_WAIT_POLLOUT)
+         n_flushClient(n_pDmn,
+                       n_idxFds[i]);
+      if (n_pDmn -> n_clis[n_idxFds[i]].n_fd >= 0 &&
+          (n_fds[i].revents & ~CURL_WAIT_POLLOUT))
+         n_readClient(n_pDmn,
+                      n_idxFds[i]);
+   }
+   // the requests of every client are processed (including the ones that were waiting for the pool)
+   for (size_t i = 0; i < N_MAXCLI; i++)
+      if (n_pDmn -> n_clis[i].n_fd >= 0)
+         n_processClient(n_pDmn,
+                         n_pEng,
+                         i);
+   return wRC_Cd_noError;
+}
+
+void N_complete(N_daemon* restrict n_pDmn,
+                E_target* n_pTarg)
+{
+   // the target is the first member of its request
+   N_request* n_pReq = (N_request*) n_pTarg;
+   if (n_pReq -> n_idxCli == N_NOCLI) {
+      // the trailing separator of the URL prefix is dropped
+      const int n_lenPref = (int) n_pTarg -> e_pBoard -> b_lenPref - 1;
+      if (n_pTarg -> e_errCode == wRC_Cd_curl)
+         fprintf(stdout, "[NOT] %.*s is not reachable (curl error code %d)\n", n_lenPref, n_pTarg -> e_pBoard -> b_strPref,
+                 (int) n_pTarg -> e_libCode);
+      else
+         fprintf(stdout, "[INF] %.*s is reachable: response code %ld (%.3f ms)\n", n_lenPref, n_pTarg -> e_pBoard -> b_strPref,
+                 n_pTarg -> e_resCode, n_pTarg -> e_info.b_totTime / 1000.0);
+   }
+   else if (n_pDmn -> n_clis[n_pReq -> n_idxCli].n_fd >= 0 &&
+            n_pDmn -> n_clis[n_pReq -> n_idxCli].n_gen == n_pReq -> n_gen) {
+      // the response is sent at once, unless previous responses are still waiting
+      n_pDmn -> n_clis[n_pReq -> n_idxCli].n_numPend--;
+      char n_strComm[O_MAXSZCOMM];
+      O_describeComm(&(n_pTarg -> e_comm),
+                     n_strComm);
+      const bool n_fCurl = n_pTarg -> e_errCode == wRC_Cd_curl;
+      const O_record n_rec = {.o_seq = n_pReq -> n_seq, .o_pBoard = n_pTarg -> e_pBoard, .o_strComm = n_strComm,
+                              .o_resCode = n_fCurl ? 0
+                                                   : n_pTarg -> e_resCode,
+                              .o_libCode = n_fCurl ? (int) n_pTarg -> e_libCode
+                                                   : CURLE_OK,
+                              .o_time = n_pTarg -> e_fCoalesced ? -1
+                                                                : n_pTarg -> e_info.b_totTime,
+                              .o_stat = n_pTarg -> e_stat,
+                              .o_fStat = !n_fCurl && n_pTarg -> e_resCode == 200,
+                              .o_numAttempt = n_pTarg -> e_numAttempt};
+      n_respond(n_pDmn,
+                n_pReq -> n_idxCli,
+                &n_rec);
+      if (n_pDmn -> n_clis[n_pReq -> n_idxCli].n_fd >= 0)
+         n_flushClient(n_pDmn,
+                       n_pReq -> n_idxCli);
+   }
+   n_pReq -> n_pNextFree = n_pDmn -> n_pFree;
+   n_pDmn -> n_pFree = n_pReq;
+}
+
+void N_cleanup(N_daemon* restrict n_pDmn)
+{
+   for (size_t i = 0; i < N_MAXCLI; i++)
+      if (n_pDmn -> n_clis[i].n_fd >= 0)
+         n_closeClient(n_pDmn,
+                       i);
+   if (n_pDmn -> n_lsn >= 0) {
+      close(n_pDmn -> n_lsn);
+      unlink(n_pDmn -> n_pathSock);
+      n_pDmn -> n_lsn = -1;
+   }
+   M_cleanup(&(n_pDmn -> n_reg));
+   free(n_pDmn -> n_reqs);
+   n_pDmn -> n_reqs = n_pDmn -> n_pFree = CST_PVOID;
+}
+
+static int n_listen(const char* const n_pathSock,
+                    int* restrict n_pLsn)
+{
+   struct sockaddr_un n_addr;
+   memset(&n_addr, 0, sizeof(struct sockaddr_un));
+   n_addr.sun_family = AF_UNIX;
+   if (strlen(n_pathSock) >= sizeof(n_addr.sun_path)) {
+      fputs(WRC_MSG_NOSOCKET, stderr);
+      return wRC_Cd_wrPPar;
+   }
+   strcpy(n_addr.sun_path, n_pathSock);
+   // a socket that still accepts connections belongs to a running daemon; any other file is preserved.
+   // The probe has its own socket, since a socket whose connection failed cannot be bound
+   struct stat n_info;
+   if (!lstat(n_pathSock, &n_info) &&
+       S_ISSOCK(n_info.st_mode)) {
+      const int n_probe = socket(AF_UNIX, SOCK_STREAM, 0);
+      if (n_probe >= 0) {
+         if (connect(n_probe, (const struct sockaddr*) &n_addr, sizeof(struct sockaddr_un)))
+            unlink(n_pathSock);
+         close(n_probe);
+      }
+   }
+   const int n_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (n_fd < 0) {
+      fputs(WRC_MSG_NOSOCKET, stderr);
+      return wRC_Cd_wrPPar;
+   }
+   if (bind(n_fd, (const struct sockaddr*) &n_addr, sizeof(struct sockaddr_un)) ||
+       listen(n_fd, N_BACKLOG) ||
+       fcntl(n_fd, F_SETFL, fcntl(n_fd, F_GETFL) | O_NONBLOCK)) {
+      close(n_fd);
+      fputs(WRC_MSG_NOSOCKET, stderr);
+      return wRC_Cd_wrPPar;
+   }
+   *n_pLsn = n_fd;
+   return wRC_Cd_noError;
+}
+
+static void n_accept(N_daemon* restrict n_pDmn)
+{
+   const int n_fd = accept(n_pDmn -> n_lsn, CST_PVOID, CST_PVOID);
+   if (n_fd < 0)
+      return;
+   size_t n_idxCli = 0;
+   while (n_idxCli < N_MAXCLI &&
+          n_pDmn -> n_clis[n_idxCli].n_fd >= 0)
+      n_idxCli++;
+   if (n_idxCli == N_MAXCLI ||
+       fcntl(n_fd, F_SETFL, fcntl(n_fd, F_GETFL) | O_NONBLOCK)) {
+      close(n_fd);
+      return;
+   }
+   N_client* n_pCli = n_pDmn -> n_clis + n_idxCli;
+   const unsigned n_gen = n_pCli -> n_gen;
+   memset(n_pCli, 0, sizeof(N_client));
+   n_pCli -> n_fd = n_fd;
+   n_pCli -> n_gen = n_gen;
+   n_pDmn -> n_numCli++;
+   n_pDmn -> n_numAcc++;
+}
+
+static void n_closeClient(N_daemon* restrict n_pDmn,
+                          size_t n_idxCli)
+{
+   N_client* n_pCli = n_pDmn -> n_clis + n_idxCli;
+   close(n_pCli -> n_fd);
+   free(n_pCli -> n_out);
+   const unsigned n_gen = n_pCli -> n_gen + 1;
+   memset(n_pCli, 0, sizeof(N_client));
+   n_pCli -> n_fd = -1;
+   n_pCli -> n_gen = n_gen;
+   n_pDmn -> n_numCli--;
+}
+
+static void n_readClient(N_daemon* restrict n_pDmn,
+                         size_t n_idxCli)
+{
+   N_client* n_pCli = n_pDmn -> n_clis + n_idxCli;
+   if (n_pCli -> n_fQuit ||
+       n_pCli -> n_lenIn == N_SZIN)
+      return;
+   const ssize_t n_numRead = recv(n_pCli -> n_fd,
+                                  n_pCli -> n_in + n_pCli -> n_lenIn,
+                                  N_SZIN - n_pCli -> n_lenIn, 0);
+   if (n_numRead < 0) {
+      if (errno != EINTR &&
+          errno != EAGAIN &&
+          errno != EWOULDBLOCK)
+         n_closeClient(n_pDmn,
+                       n_idxCli);
+      return;
+   }
+   if (!n_numRead) {
+      // the last request may lack the new line character
+      n_pCli -> n_fQuit = true;
+      if (n_pCli -> n_lenIn &&
+          n_pCli -> n_lenIn < N_SZIN)
+         n_pCli -> n_in[n_pCli -> n_lenIn++] = '\n';
+      return;
+   }
+   n_pCli -> n_lenIn += (size_t) n_numRead;
+}
+
+static void n_processClient(N_daemon* restrict n_pDmn,
+                            E_engine* restrict n_pEng,
+                            size_t n_idxCli)
+{
+   N_client* n_pCli = n_pDmn -> n_clis + n_idxCli;
+   size_t n_pos = 0;
+   while (n_pCli -> n_fd >= 0 &&
+          n_pDmn -> n_pFree &&
+          n_pos < n_pCli -> n_lenIn) {
+      const char* n_line = n_pCli -> n_in + n_pos;
+      const char* n_pNL = memchr(n_line, '\n', n_pCli -> n_lenIn - n_pos);
+      if (!n_pNL)
+         break;
+      const size_t n_lenLine = n_pNL - n_line;
+      n_pos += n_lenLine + 1;
+      if (n_pCli -> n_fSkip) {
+         // the end of an overlong request
+         n_pCli -> n_fSkip = false;
+         continue;
+      }
+      n_handleRequest(n_pDmn,
+                      n_pEng,
+                      n_idxCli,
+                      n_line, n_lenLine);
+      // the requests that follow quit are ignored
+      if (n_pCli -> n_fQuit &&
+          !(n_pCli -> n_lenIn))
+         return;
+   }
+   if (n_pCli -> n_fd < 0)
+      return;
+   memmove(n_pCli -> n_in, n_pCli -> n_in + n_pos, n_pCli -> n_lenIn - n_pos);
+   n_pCli -> n_lenIn -= n_pos;
+   if (n_pCli -> n_lenIn == N_SZIN &&
+       !memchr(n_pCli -> n_in, '\n', N_SZIN)) {
+      // a request cannot be longer than the buffer: it is rejected and the rest is discarded
+      n_pCli -> n_numReq++;
+      n_pCli -> n_lenIn = 0;
+      n_pCli -> n_fSkip = true;
+      const O_record n_rec = {.o_seq = n_pCli -> n_numReq, .o_time = -1};
+      n_respond(n_pDmn,
+                n_idxCli,
+                &n_rec);
+   }
+   if (n_pCli -> n_fd >= 0)
+      n_flushClient(n_pDmn,
+                    n_idxCli);
+}
+
+static void n_handleRequest(N_daemon* restrict n_pDmn,
+                            E_engine* restrict n_pEng,
+                            size_t n_idxCli,
+                            const char* n_line,
+                            size_t n_lenLine)
+{
+   N_client* n_pCli = n_pDmn -> n_clis + n_idxCli;
+   // leading and trailing spaces (a carriage return included) are ignored, as well as empty lines
+   while (n_lenLine &&
+          isspace(*n_line)) {
+      n_line++;
+      n_lenLine--;
+   }
+   while (n_lenLine &&
+          isspace(n_line[n_lenLine - 1]))
+      n_lenLine--;
+   if (!n_lenLine)
+      return;
+   if (n_lenLine == strlen(N_REQ_QUIT) &&
+       !memcmp(n_line, N_REQ_QUIT, n_lenLine)) {
+      n_pCli -> n_fQuit = true;
+      n_pCli -> n_lenIn = 0;
+      return;
+   }
+   n_pCli -> n_numReq++;
+   n_pDmn -> n_numReq++;
+   if (n_lenLine == strlen(N_REQ_METRICS) &&
+       !memcmp(n_line, N_REQ_METRICS, n_lenLine)) {
+      n_sendMetrics(n_pDmn,
+                    n_idxCli);
+      return;
+   }
+   // <array> <mnemonic code>, where <array> is the position of the array (starting from one)
+   O_record n_rec = {.o_seq = n_pCli -> n_numReq, .o_time = -1};
+   size_t n_pos = 0;
+   size_t n_idxBoard = 0;
+   while (n_pos < n_lenLine &&
+          isdigit(n_line[n_pos]) &&
+          n_idxBoard <= n_pDmn -> n_numBoard)
+      n_idxBoard = n_idxBoard * 10 + (size_t) (n_line[n_pos++] - '0');
+   if (!n_idxBoard ||
+       n_idxBoard > n_pDmn -> n_numBoard ||
+       n_pos == n_lenLine ||
+       !isspace(n_line[n_pos])) {
+      n_respond(n_pDmn,
+                n_idxCli,
+                &n_rec);
+      return;
+   }
+   n_rec.o_pBoard = n_pDmn -> n_boards + n_idxBoard - 1;
+   while (n_pos < n_lenLine &&
+          isspace(n_line[n_pos]))
+      n_pos++;
+   char n_strMnemCd[P_CST_MAXSZSTR_MNEMCD] = {0};
+   P_out n_comm = {.p_oAct = oAct_numOAct};
+   if (n_lenLine - n_pos > P_CST_MAXLEN_MNEMCD) {
+      n_respond(n_pDmn,
+                n_idxCli,
+                &n_rec);
+      return;
+   }
+   memcpy(n_strMnemCd, n_line + n_pos, n_lenLine - n_pos);
+   if (P_parseMnemCode(&n_comm,
+                       n_strMnemCd)) {
+      n_respond(n_pDmn,
+                n_idxCli,
+                &n_rec);
+      return;
+   }
+   N_request* n_pReq = n_pDmn -> n_pFree;
+   n_pDmn -> n_pFree = n_pReq -> n_pNextFree;
+   memset(n_pReq, 0, sizeof(N_request));
+   n_pReq -> n_targ.e_pBoard = n_rec.o_pBoard;
+   n_pReq -> n_targ.e_comm = n_comm;
+   n_pReq -> n_idxCli = n_idxCli;
+   n_pReq -> n_gen = n_pCli -> n_gen;
+   n_pReq -> n_seq = n_rec.o_seq;
+   n_pCli -> n_numPend++;
+   E_submit(n_pEng, &(n_pReq -> n_targ));
+}
+
+static bool n_queueOut(N_daemon* restrict n_pDmn,
+                       size_t n_idxCli,
+                       const char* n_data,
+                       size_t n_lenData)
+{
+   N_client* n_pCli = n_pDmn -> n_clis + n_idxCli;
+   if (n_pCli -> n_lenOut + n_lenData > n_pCli -> n_capOut) {
+      size_t n_newCap = n_pCli -> n_capOut ? n_pCli -> n_capOut
+                                           : N_SZOUT;
+      while (n_newCap < n_pCli -> n_lenOut + n_lenData)
+         n_newCap *= 2;
+      char* n_newOut = realloc(n_pCli -> n_out, n_newCap);
+      if (!n_newOut) {
+         fputs(WRC_MSG_HEAPMANFAIL, stderr);
+         n_closeClient(n_pDmn,
+                       n_idxCli);
+         return false;
+      }
+      n_pCli -> n_out = n_newOut;
+      n_pCli -> n_capOut = n_newCap;
+   }
+   memcpy(n_pCli -> n_out + n_pCli -> n_lenOut, n_data, n_lenData);
+   n_pCli -> n_lenOut += n_lenData;
+   return true;
+}
+
+static void n_respond(N_daemon* restrict n_pDmn,
+                      size_t n_idxCli,
+                      const O_record* restrict n_pRec)
+{
+   char n_strRec[O_MAXSZREC];
+   const size_t n_lenRec = O_format(n_pDmn -> n_fmt,
+                                    n_pRec,
+                                    n_strRec);
+   n_queueOut(n_pDmn,
+              n_idxCli,
+              n_strRec, n_lenRec);
+}
+
+static void n_sendMetrics(N_daemon* restrict n_pDmn,
+                          size_t n_idxCli)
+{
+   char* n_buf = CST_PVOID;
+   size_t n_szBuf = 0;
+   FILE* n_pStream = open_memstream(&n_buf, &n_szBuf);
+   if (n_pStream) {
+      M_printProm(&(n_pDmn -> n_reg),
+                  n_pStream);
+      fclose(n_pStream);
+   }
+   if (n_buf &&
+       !n_queueOut(n_pDmn,
+                   n_idxCli,
+                   n_buf, n_szBuf)) {
+      free(n_buf);
+      return;
+   }
+   free(n_buf);
+   n_queueOut(n_pDmn,
+              n_idxCli,
+              N_EOF, strlen(N_EOF));
+}
+
+static void n_flushClient(N_daemon* restrict n_pDmn,
+                          size_t n_idxCli)
+{
+   N_client* n_pCli = n_pDmn -> n_clis + n_idxCli;
+   while (n_pCli -> n_posOut < n_pCli -> n_lenOut) {
+      // a client that went away does not raise SIGPIPE
+      const ssize_t n_numSent = send(n_pCli -> n_fd,
+                                     n_pCli -> n_out + n_pCli -> n_posOut,
+                                     n_pCli -> n_lenOut - n_pCli -> n_posOut,
+                                     MSG_NOSIGNAL);
+      if (n_numSent < 0) {
+         if (errno == EINTR)
+            continue;
+         if (errno == EAGAIN ||
+             errno == EWOULDBLOCK)
+            return;
+         n_closeClient(n_pDmn,
+                       n_idxCli);
+         return;
+      }
+      n_pCli -> n_posOut += (size_t) n_numSent;
+   }
+   n_pCli -> n_posOut = n_pCli -> n_lenOut = 0;
+   if (n_pCli -> n_fQuit &&
+       !(n_pCli -> n_numPend) &&
+       !(n_pCli -> n_lenIn))
+      n_closeClient(n_pDmn,
+                    n_idxCli);
+}
@@ -0,0 +1,726 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <curl/curl.h>
+#include "engine.h"
+#include "parser.h"
+#include "constants.h"
+#include "err_wrapper.h"
+
+#define E_STEP_TIMEOUT  1000  // maximum time (milliseconds) spent waiting by a single step of E_run
+
+// starts the transfer of a target; on failure the target is processed immediately
+static void e_start(E_engine* restrict e_pEng,
+                    E_target* e_pTarg);
+// releases the easy handle of a target, hands its array over to the next queued target and notifies
+// the user
+static void e_finish(E_engine* restrict e_pEng,
+                     E_target* e_pTarg);
+// processes the completed transfers and fills the free slots with queued targets
+static int e_collect(E_engine* restrict e_pEng);
+// schedules the retry of a target whose attempt has failed (false if the policy does not allow it)
+static bool e_retry(E_engine* restrict e_pEng,
+                    E_target* e_pTarg);
+// resets the outcome of a target before an attempt
+static void e_resetOutcome(E_target* e_pTarg);
+// time (milliseconds) left before the deadline of a target (zero if the policy has no deadline)
+static unsigned long e_remain(const E_engine* restrict e_pEng,
+                              const E_target* restrict e_pTarg,
+                              uint64_t e_now);
+// the instant at which the attempt of a target that starts now is hedged (zero if it is not)
+static uint64_t e_hedgeDue(E_engine* restrict e_pEng,
+                           const B_board* restrict e_pBoard,
+                           uint64_t e_now);
+// sends the hedge of the current attempt of a target (a failure is ignored)
+static void e_hedge(E_engine* restrict e_pEng,
+                    E_target* e_pTarg);
+// records the duration of an answered attempt (a failed allocation is ignored)
+static void e_recordDur(E_engine* restrict e_pEng,
+                        const B_board* restrict e_pBoard,
+                        uint64_t e_dur);
+// the state of an array; it is added if requested (CST_PVOID if it is missing or cannot be added)
+static E_perBoard* e_findBoard(E_engine* restrict e_pEng,
+                               const B_board* restrict e_pBoard,
+                               bool e_fAdd);
+// removes the queued relay command superseded by a target (CST_PVOID if there is none)
+static E_target* e_coalesce(E_perBoard* restrict e_pPerBoard,
+                            const E_target* restrict e_pTarg);
+// compares two durations (qsort)
+static int e_cmpDurs(const void* e_pLeft,
+                     const void* e_pRight);
+
+int E_init(E_engine* restrict e_pEng,
+           unsigned e_maxInFlight,
+           E_doneCb e_doneCb,
+           void* e_uD)
+{
+   if (!e_pEng ||
+       !e_maxInFlight ||
+       e_maxInFlight > E_MAX_MAXINFLIGHT)
+      return wRC_Cd_invP;
+   memset(e_pEng, 0, sizeof(E_engine));
+   e_pEng -> e_pMHan = curl_multi_init();
+   if (!(e_pEng -> e_pMHan))
+      return wRC_Cd_curl;
+   e_pEng -> e_maxInFlight = e_maxInFlight;
+   e_pEng -> e_doneCb = e_doneCb;
+   e_pEng -> e_uD = e_uD;
+   S_init(&(e_pEng -> e_retries));
+   L_defPolicy(&(e_pEng -> e_policy));
+   // the seed differs among the engines and among the processes
+   e_pEng -> e_seed = (uint32_t) ((uintptr_t) e_pEng ^ S_now()) | 1U;
+   return wRC_Cd_noError;
+}
+
+int E_setPolicy(E_engine* restrict e_pEng,
+                const L_policy* restrict e_pPolicy)
+{
+   if (!e_pEng ||
+       !e_pPolicy ||
+       !B_chkPolicy(e_pPolicy))
+      return wRC_Cd_invP;
+   e_pEng -> e_policy = *e_pPolicy;
+   return wRC_Cd_noError;
+}
+
+int E_setHedge(E_engine* restrict e_pEng,
+               unsigned e_hedgePct)
+{
+   if (!e_pEng ||
+       (e_hedgePct &&
+        (e_hedgePct < E_MIN_HEDGEPCT ||
+         e_hedgePct > E_MAX_HEDGEPCT)))
+      return wRC_Cd_invP;
+   e_pEng -> e_hedgePct = e_hedgePct;
+   return wRC_Cd_noError;
+}
+
+int E_setQueue(E_engine* restrict e_pEng,
+               enum E_queueModes e_qMode)
+{
+   if (!e_pEng ||
+       (unsigned) e_qMode >= E_qm_num ||
+       E_pending(e_pEng))
+      return wRC_Cd_invP;
+   e_pEng -> e_qMode = e_qMode;
+   return wRC_Cd_noError;
+}
+
+int E_submit(E_engine* restrict e_pEng,
+             E_target* e_pTarg)
+{
+   if (!e_pEng ||
+       !e_pTarg ||
+       !(e_pTarg -> e_pBoard))
+      return wRC_Cd_invP;
+   e_pTarg -> e_strUrl = B_getUrl(e_pTarg -> e_pBoard,
+                                  &(e_pTarg -> e_comm));
+   e_resetOutcome(e_pTarg);
+   e_pTarg -> e_numAttempt = 0;
+   e_pTarg -> e_fHedged = false;
+   e_pTarg -> e_fHedgeWon = false;
+   e_pTarg -> e_fCoalesced = false;
+   e_pTarg -> e_queueTime = 0;
+   e_pTarg -> e_depth = 0;
+   e_pTarg -> e_tSubmit = S_now();
+   e_pTarg -> e_pHan = CST_PVOID;
+   e_pTarg -> e_pHedge = CST_PVOID;
+   e_pTarg -> e_pNext = CST_PVOID;
+   e_pTarg -> e_pPrev = CST_PVOID;
+   if (e_pEng -> e_qMode != E_qm_none) {
+      E_perBoard* e_pPerBoard = e_findBoard(e_pEng,
+                                            e_pTarg -> e_pBoard,
+                                            true);
+      // the target cannot be queued: it is processed at once, as a target that cannot be started
+      if (!e_pPerBoard) {
+         e_pTarg -> e_errCode = wRC_Cd_heapManFail;
+         e_finish(e_pEng, e_pTarg);
+         return wRC_Cd_noError;
+      }
+      if (e_pPerBoard -> e_fBusy) {
+         // the target waits for the array; the superseded command is notified once the queue is
+         // consistent (the callback may submit further targets)
+         E_target* e_pSuper = e_pEng -> e_qMode == E_qm_coalesce ? e_coalesce(e_pPerBoard, e_pTarg)
+                                                                 : CST_PVOID;
+         e_pTarg -> e_depth = e_pPerBoard -> e_depth + 1;
+         if (e_pPerBoard -> e_pTail)
+            e_pPerBoard -> e_pTail -> e_pNext = e_pTarg;
+         else
+            e_pPerBoard -> e_pHead = e_pTarg;
+         e_pPerBoard -> e_pTail = e_pTarg;
+         e_pPerBoard -> e_depth++;
+         if (e_pSuper &&
+             e_pEng -> e_doneCb)
+            e_pEng -> e_doneCb(e_pSuper,
+                               e_pEng -> e_uD);
+         return wRC_Cd_noError;
+      }
+      e_pPerBoard -> e_fBusy = true;
+   }
+   if (e_pEng -> e_numInFlight < e_pEng -> e_maxInFlight)
+      e_start(e_pEng, e_pTarg);
+   else {
+      if (e_pEng -> e_pTail)
+         e_pEng -> e_pTail -> e_pNext = e_pTarg;
+      else
+         e_pEng -> e_pHead = e_pTarg;
+      e_pEng -> e_pTail = e_pTarg;
+   }
+   return wRC_Cd_noError;
+}
+
+int E_step(E_engine* restrict e_pEng,
+           int e_timeout)
+{
+   return E_stepFds(e_pEng,
+                    e_timeout,
+                    CST_PVOID, 0);
+}
+
+int E_stepFds(E_engine* restrict e_pEng,
+              int e_timeout,
+              struct curl_waitfd e_extraFds[],
+              unsigned e_numExtra)
+{
+   if (!e_pEng ||
+       (e_numExtra &&
+        !e_extraFds))
+      return wRC_Cd_invP;
+   // curl_multi_poll honours the internal timers of libcurl (a freshly added handle does not wait),
+   // whereas the retries and the hedges are due at instants known only by the engine
+   e_timeout = S_waitTime(&(e_pEng -> e_retries),
+                          e_timeout);
+   if (e_pEng -> e_hedgePct) {
+      const uint64_t e_now = S_now();
+      for (const E_target* e_pCurr = e_pEng -> e_pActive; e_pCurr; e_pCurr = e_pCurr -> e_pNext) {
+         if (!(e_pCurr -> e_tHedge))
+            continue;
+         const uint64_t e_wait = e_pCurr -> e_tHedge > e_now ? (e_pCurr -> e_tHedge - e_now + S_NSPERMS - 1) / S_NSPERMS
+                                                             : 0;
+         if (e_wait < (uint64_t) e_timeout)
+            e_timeout = (int) e_wait;
+      }
+   }
+   CURLMcode e_mCode = curl_multi_poll(e_pEng -> e_pMHan,
+                                       e_extraFds, e_numExtra,
+                                       e_timeout,
+                                       CST_PVOID);
+   if (e_mCode)
+      return wRC_Cd_curl;
+   int e_numRunning = 0;
+   e_mCode = curl_multi_perform(e_pEng -> e_pMHan,
+                                &e_numRunning);
+   if (e_mCode)
+      return wRC_Cd_curl;
+   return e_collect(e_pEng);
+}
+
+int E_keepConns(E_engine* restrict e_pEng,
+                unsigned e_numConn)
+{
+   if (!e_pEng ||
+       !e_numConn)
+      return wRC_Cd_invP;
+   if (curl_multi_setopt(e_pEng -> e_pMHan,
+                         CURLMOPT_MAXCONNECTS,
+                         (long) e_numConn))
+      return wRC_Cd_curl;
+   return wRC_Cd_noError;
+}
+
+size_t E_pending(const E_engine* restrict e_pEng)
+{
+   size_t e_numPend = e_pEng -> e_numInFlight + e_pEng -> e_retries.s_numEvts;
+   for (const E_target* e_pCurr = e_pEng -> e_pHead; e_pCurr; e_pCurr = e_pCurr -> e_pNext)
+      e_numPend++;
+   for (size_t i = 0; i < e_pEng -> e_numBoards; i++)
+      e_numPend += e_pEng -> e_boards[i].e_depth;
+   return e_numPend;
+}
+
+void E_cleanup(E_engine* restrict e_pEng)
+{
+   if (!e_pEng ||
+       !(e_pEng -> e_pMHan))
+      return;
+   // the request of an active target may have failed while its hedge is still running
+   for (E_target* e_pCurr = e_pEng -> e_pActive; e_pCurr; e_pCurr = e_pCurr -> e_pNext) {
+      if (e_pCurr -> e_pHan) {
+         curl_multi_remove_handle(e_pEng -> e_pMHan, e_pCurr -> e_pHan);
+         curl_easy_cleanup(e_pCurr -> e_pHan);
+         e_pCurr -> e_pHan = CST_PVOID;
+      }
+      if (e_pCurr -> e_pHedge) {
+         curl_multi_remove_handle(e_pEng -> e_pMHan, e_pCurr -> e_pHedge);
+         curl_easy_cleanup(e_pCurr -> e_pHedge);
+         e_pCurr -> e_pHedge = CST_PVOID;
+      }
+   }
+   // neither the targets waiting for a retry nor the ones waiting for their array own an easy handle
+   S_cleanup(&(e_pEng -> e_retries));
+   free(e_pEng -> e_boards);
+   curl_multi_cleanup(e_pEng -> e_pMHan);
+   memset(e_pEng, 0, sizeof(E_engine));
+}
+
+int E_run(size_t e_numTarg, E_target e_targs[],
+          unsigned e_maxInFlight,
+          const L_policy* restrict e_pPolicy,
+          unsigned e_hedgePct,
+          enum E_queueModes e_qMode,
+          E_doneCb e_doneCb,
+          void* e_uD)
+{
+   if (e_numTarg &&
+       !e_targs)
+      return wRC_Cd_invP;
+   E_engine e_eng;
+   int e_errCode = E_init(&e_eng,
+                          e_maxInFlight,
+                          e_doneCb,
+                          e_uD);
+   if (e_errCode)
+      return e_errCode;
+   if (e_pPolicy) {
+      e_errCode = E_setPolicy(&e_eng, e_pPolicy);
+      if (e_errCode)
+         goto E_RUN_EXIT;
+   }
+   e_errCode = E_setHedge(&e_eng, e_hedgePct);
+   if (!e_errCode)
+      e_errCode = E_setQueue(&e_eng, e_qMode);
+   if (e_errCode)
+      goto E_RUN_EXIT;
+   for (size_t i = 0; i < e_numTarg; i++) {
+      e_errCode = E_submit(&e_eng, e_targs + i);
+      if (e_errCode)
+         goto E_RUN_EXIT;
+   }
+   while (E_pending(&e_eng)) {
+      e_errCode = E_step(&e_eng, E_STEP_TIMEOUT);
+      if (e_errCode)
+         goto E_RUN_EXIT;
+   }
+   E_RUN_EXIT:
+   E_cleanup(&e_eng);
+   return e_errCode;
+}
+
+static void e_start(E_engine* restrict e_pEng,
+                    E_target* e_pTarg)
+{
+   B_resetDlData(&(e_pTarg -> e_dlData),
+                 e_pTarg -> e_pBoard);
+   // the deadline runs from the first attempt (the time spent waiting for a slot is not included)
+   const uint64_t e_now = S_now();
+   if (!(e_pTarg -> e_numAttempt)) {
+      e_pTarg -> e_tStart = e_now;
+      e_pTarg -> e_queueTime = e_now - e_pTarg -> e_tSubmit;
+   }
+   e_pTarg -> e_tAttempt = e_now;
+   e_pTarg -> e_tHedge = 0;
+   e_pTarg -> e_pHan = curl_easy_init();
+   if (!(e_pTarg -> e_pHan)) {
+      e_pTarg -> e_errCode = wRC_Cd_curl;
+      e_pTarg -> e_libCode = CURLE_FAILED_INIT;
+      e_finish(e_pEng, e_pTarg);
+      return;
+   }
+   CURLcode e_libCode = B_prepHandle(e_pTarg -> e_pHan,
+                                     &(e_pTarg -> e_dlData));
+   if (!e_libCode)
+      e_libCode = B_setLimits(e_pTarg -> e_pHan,
+                              &(e_pEng -> e_policy),
+                              e_remain(e_pEng,
+                                       e_pTarg,
+                                       e_now));
+   if (!e_libCode)
+      e_libCode = curl_easy_setopt(e_pTarg -> e_pHan,
+                                   CURLOPT_URL,
+                                   e_pTarg -> e_strUrl);
+   if (!e_libCode)
+      e_libCode = curl_easy_setopt(e_pTarg -> e_pHan,
+                                   CURLOPT_PRIVATE,
+                                   (void*) e_pTarg);
+   if (!e_libCode &&
+       curl_multi_add_handle(e_pEng -> e_pMHan, e_pTarg -> e_pHan))
+      e_libCode = CURLE_FAILED_INIT;
+   if (e_libCode) {
+      e_pTarg -> e_errCode = wRC_Cd_curl;
+      e_pTarg -> e_libCode = e_libCode;
+      e_finish(e_pEng, e_pTarg);
+      return;
+   }
+   e_pTarg -> e_pPrev = CST_PVOID;
+   e_pTarg -> e_pNext = e_pEng -> e_pActive;
+   if (e_pEng -> e_pActive)
+      e_pEng -> e_pActive -> e_pPrev = e_pTarg;
+   e_pEng -> e_pActive = e_pTarg;
+   e_pEng -> e_numInFlight++;
+   e_pTarg -> e_tHedge = e_hedgeDue(e_pEng,
+                                    e_pTarg -> e_pBoard,
+                                    e_now);
+}
+
+static void e_finish(E_engine* restrict e_pEng,
+                     E_target* e_pTarg)
+{
+   curl_easy_cleanup(e_pTarg -> e_pHan);
+   e_pTarg -> e_pHan = CST_PVOID;
+   if (e_pEng -> e_qMode != E_qm_none) {
+      E_perBoard* e_pPerBoard = e_findBoard(e_pEng,
+                                            e_pTarg -> e_pBoard,
+                                            false);
+      E_target* e_pNext = e_pPerBoard ? e_pPerBoard -> e_pHead
+                                      : CST_PVOID;
+      if (e_pNext) {
+         e_pPerBoard -> e_pHead = e_pNext -> e_pNext;
+         if (!(e_pPerBoard -> e_pHead))
+            e_pPerBoard -> e_pTail = CST_PVOID;
+         e_pPerBoard -> e_depth--;
+         e_pNext -> e_pNext = CST_PVOID;
+         // the array stays busy: its next target takes a slot as any other submitted target
+         if (e_pEng -> e_numInFlight < e_pEng -> e_maxInFlight)
+            e_start(e_pEng, e_pNext);
+         else {
+            if (e_pEng -> e_pTail)
+               e_pEng -> e_pTail -> e_pNext = e_pNext;
+            else
+               e_pEng -> e_pHead = e_pNext;
+            e_pEng -> e_pTail = e_pNext;
+         }
+      }
+      else if (e_pPerBoard)
+         e_pPerBoard -> e_fBusy = false;
+   }
+   if (e_pEng -> e_doneCb)
+      e_pEng -> e_doneCb(e_pTarg,
+                         e_pEng -> e_uD);
+}
+
+static int e_collect(E_engine* restrict e_pEng)
+{
+   int e_numMsgs = 0;
+   CURLMsg* e_pMsg = CST_PVOID;
+   while ((e_pMsg = curl_multi_info_read(e_pEng -> e_pMHan, &e_numMsgs))) {
+      if (e_pMsg -> msg != CURLMSG_DONE)
+         continue;
+      CURL* e_pHan = e_pMsg -> easy_handle;
+      E_target* e_pTarg = CST_PVOID;
+      curl_easy_getinfo(e_pHan,
+                        CURLINFO_PRIVATE,
+                        (char**) &e_pTarg);
+      // the request and its hedge share the target
+      const bool e_fHedge = e_pHan == e_pTarg -> e_pHedge;
+      B_dl_data* e_pDlData = e_fHedge ? &(e_pTarg -> e_hedgeDl)
+                                      : &(e_pTarg -> e_dlData);
+      const CURLcode e_resLib = B_chkResult(e_pMsg -> data.result,
+                                            e_pDlData);
+      curl_multi_remove_handle(e_pEng -> e_pMHan, e_pHan);
+      CURL** e_ppTwin = e_fHedge ? &(e_pTarg -> e_pHan)
+                                 : &(e_pTarg -> e_pHedge);
+      if (*e_ppTwin) {
+         // a failed request is ignored as long as its twin may still be answered
+         if (e_resLib) {
+            curl_easy_cleanup(e_pHan);
+            if (e_fHedge)
+               e_pTarg -> e_pHedge = CST_PVOID;
+            else
+               e_pTarg -> e_pHan = CST_PVOID;
+            continue;
+         }
+         curl_multi_remove_handle(e_pEng -> e_pMHan, *e_ppTwin);
+         curl_easy_cleanup(*e_ppTwin);
+         *e_ppTwin = CST_PVOID;
+      }
+      // the last request standing becomes the one of the target
+      e_pTarg -> e_pHan = e_pHan;
+      e_pTarg -> e_pHedge = CST_PVOID;
+      e_pTarg -> e_tHedge = 0;
+      if (e_fHedge &&
+          !e_resLib)
+         e_pTarg -> e_fHedgeWon = true;
+      B_readXferInfo(e_pHan,
+                     e_pDlData,
+                     &(e_pTarg -> e_info));
+      if (e_pEng -> e_hedgePct &&
+          !e_resLib)
+         e_recordDur(e_pEng,
+                     e_pTarg -> e_pBoard,
+                     S_now() - e_pTarg -> e_tAttempt);
+      // unlinking the target from the list of active targets
+      if (e_pTarg -> e_pPrev)
+         e_pTarg -> e_pPrev -> e_pNext = e_pTarg -> e_pNext;
+      else
+         e_pEng -> e_pActive = e_pTarg -> e_pNext;
+      if (e_pTarg -> e_pNext)
+         e_pTarg -> e_pNext -> e_pPrev = e_pTarg -> e_pPrev;
+      e_pTarg -> e_pNext = e_pTarg -> e_pPrev = CST_PVOID;
+      e_pEng -> e_numInFlight--;
+      if (e_resLib) {
+         e_pTarg -> e_errCode = wRC_Cd_curl;
+         e_pTarg -> e_libCode = e_resLib;
+      }
+      else {
+         e_pTarg -> e_resCode = 200;
+         const CURLcode e_libCode = curl_easy_getinfo(e_pHan,
+                                                      CURLINFO_RESPONSE_CODE,
+                                                      &(e_pTarg -> e_resCode));
+         if (e_libCode) {
+            e_pTarg -> e_errCode = wRC_Cd_curl;
+            e_pTarg -> e_libCode = e_libCode;
+         }
+         else if (e_pTarg -> e_resCode == 200)
+            e_pTarg -> e_stat = e_pDlData -> b_resp.p_stat;
+      }
+      e_pTarg -> e_attempts[e_pTarg -> e_numAttempt] = (L_attempt) {.l_resCode = e_pTarg -> e_resCode,
+                                                                    .l_libCode = e_pTarg -> e_libCode,
+                                                                    .l_totTime = e_pTarg -> e_info.b_totTime};
+      e_pTarg -> e_numAttempt++;
+      if (!e_retry(e_pEng, e_pTarg))
+         e_finish(e_pEng, e_pTarg);
+   }
+   const uint64_t e_now = S_now();
+   // sending the hedges that are due
+   if (e_pEng -> e_hedgePct)
+      for (E_target* e_pCurr = e_pEng -> e_pActive; e_pCurr; e_pCurr = e_pCurr -> e_pNext)
+         if (e_pCurr -> e_tHedge &&
+             e_pCurr -> e_tHedge <= e_now)
+            e_hedge(e_pEng, e_pCurr);
+   // the due retries precede the queued targets (in the order of their instants)
+   E_target* e_pLast = CST_PVOID;
+   S_event e_evt;
+   while (S_peek(&(e_pEng -> e_retries), &e_evt) &&
+          e_evt.s_deadline <= e_now) {
+      S_pop(&(e_pEng -> e_retries), CST_PVOID);
+      E_target* e_pTarg = e_evt.s_pData;
+      if (e_pLast) {
+         e_pTarg -> e_pNext = e_pLast -> e_pNext;
+         e_pLast -> e_pNext = e_pTarg;
+      }
+      else {
+         e_pTarg -> e_pNext = e_pEng -> e_pHead;
+         e_pEng -> e_pHead = e_pTarg;
+      }
+      if (!(e_pTarg -> e_pNext))
+         e_pEng -> e_pTail = e_pTarg;
+      e_pLast = e_pTarg;
+   }
+   // filling the free slots
+   while (e_pEng -> e_pHead &&
+          e_pEng -> e_numInFlight < e_pEng -> e_maxInFlight) {
+      E_target* e_pTarg = e_pEng -> e_pHead;
+      e_pEng -> e_pHead = e_pTarg -> e_pNext;
+      if (!(e_pEng -> e_pHead))
+         e_pEng -> e_pTail = CST_PVOID;
+      e_pTarg -> e_pNext = CST_PVOID;
+      e_start(e_pEng, e_pTarg);
+   }
+   return wRC_Cd_noError;
+}
+
+static bool e_retry(E_engine* restrict e_pEng,
+                    E_target* e_pTarg)
+{
+   const L_policy* e_pPolicy = &(e_pEng -> e_policy);
+   if (e_pTarg -> e_numAttempt > e_pPolicy -> l_maxRetry ||
+       !B_isTransient(e_pTarg -> e_libCode,
+                      e_pTarg -> e_resCode))
+      return false;
+   // a retry that could not start before the deadline is not attempted
+   const uint64_t e_now = S_now();
+   const uint64_t e_delay = B_backoff(e_pPolicy,
+                                      e_pTarg -> e_numAttempt - 1,
+                                      &(e_pEng -> e_seed)) * S_NSPERMS;
+   if (e_pPolicy -> l_deadline &&
+       e_now - e_pTarg -> e_tStart + e_delay >= e_pPolicy -> l_deadline * S_NSPERMS)
+      return false;
+   // without room for the retry, the failure is reported
+   if (S_push(&(e_pEng -> e_retries),
+              e_now + e_delay,
+              e_pTarg))
+      return false;
+   curl_easy_cleanup(e_pTarg -> e_pHan);
+   e_pTarg -> e_pHan = CST_PVOID;
+   e_resetOutcome(e_pTarg);
+   return true;
+}
+
+static void e_resetOutcome(E_target* e_pTarg)
+{
+   e_pTarg -> e_errCode = wRC_Cd_noError;
+   e_pTarg -> e_libCode = CURLE_OK;
+   e_pTarg -> e_resCode = 0;
+   e_pTarg -> e_stat = R_DEF;
+}
+
+static unsigned long e_remain(const E_engine* restrict e_pEng,
+                              const E_target* restrict e_pTarg,
+                              uint64_t e_now)
+{
+   const unsigned long e_deadline = e_pEng -> e_policy.l_deadline;
+   if (!e_deadline)
+      return 0;
+   // an attempt that starts late is granted a millisecond
+   const uint64_t e_elapsed = (e_now - e_pTarg -> e_tStart) / S_NSPERMS;
+   return e_elapsed < e_deadline ? e_deadline - (unsigned long) e_elapsed
+                                 : 1;
+}
+
+static uint64_t e_hedgeDue(E_engine* restrict e_pEng,
+                           const B_board* restrict e_pBoard,
+                           uint64_t e_now)
+{
+   // a hedge would open a second connection towards a serialized array
+   if (!(e_pEng -> e_hedgePct) ||
+       e_pEng -> e_qMode != E_qm_none)
+      return 0;
+   const E_perBoard* e_pPerBoard = e_findBoard(e_pEng,
+                                               e_pBoard,
+                                               false);
+   if (!e_pPerBoard ||
+       e_pPerBoard -> e_numDur < E_HEDGE_MINSAMP)
+      return 0;
+   // nearest-rank percentile of the recent durations
+   uint32_t e_durs[E_HEDGE_WINDOW];
+   memcpy(e_durs, e_pPerBoard -> e_durs, e_pPerBoard -> e_numDur * sizeof(uint32_t));
+   qsort(e_durs, e_pPerBoard -> e_numDur, sizeof(uint32_t), e_cmpDurs);
+   const unsigned e_rank = (e_pPerBoard -> e_numDur * e_pEng -> e_hedgePct + 99U) / 100U;
+   return e_now + (uint64_t) e_durs[e_rank - 1] * 1000U;
+}
+
+static void e_hedge(E_engine* restrict e_pEng,
+                    E_target* e_pTarg)
+{
+   e_pTarg -> e_tHedge = 0;
+   // the request of the target may have failed already (the twin of a hedge is never hedged)
+   if (!(e_pTarg -> e_pHan))
+      return;
+   B_resetDlData(&(e_pTarg -> e_hedgeDl),
+                 e_pTarg -> e_pBoard);
+   CURL* e_pHan = curl_easy_init();
+   if (!e_pHan)
+      return;
+   CURLcode e_libCode = B_prepHandle(e_pHan,
+                                     &(e_pTarg -> e_hedgeDl));
+   if (!e_libCode)
+      e_libCode = B_setLimits(e_pHan,
+                              &(e_pEng -> e_policy),
+                              e_remain(e_pEng,
+                                       e_pTarg,
+                                       S_now()));
+   if (!e_libCode)
+      e_libCode = curl_easy_setopt(e_pHan,
+                                   CURLOPT_URL,
+                                   e_pTarg -> e_strUrl);
+   if (!e_libCode)
+      e_libCode = curl_easy_setopt(e_pHan,
+                                   CURLOPT_PRIVATE,
+                                   (void*) e_pTarg);
+   // the connection of the slow request may be the cause of its delay
+   if (!e_libCode)
+      e_libCode = curl_easy_setopt(e_pHan,
+                                   CURLOPT_FRESH_CONNECT,
+                                   1L);
+   if (!e_libCode &&
+       curl_multi_add_handle(e_pEng -> e_pMHan, e_pHan))
+      e_libCode = CURLE_FAILED_INIT;
+   if (e_libCode) {
+      curl_easy_cleanup(e_pHan);
+      return;
+   }
+   e_pTarg -> e_pHedge = e_pHan;
+   e_pTarg -> e_fHedged = true;
+}
+
+static void e_recordDur(E_engine* restrict e_pEng,
+                        const B_board* restrict e_pBoard,
+                        uint64_t e_dur)
+{
+   E_perBoard* e_pPerBoard = e_findBoard(e_pEng,
+                                         e_pBoard,
+                                         true);
+   if (!e_pPerBoard)
+      return;
+   const uint64_t e_durUs = e_dur / 1000U;
+   e_pPerBoard -> e_durs[e_pPerBoard -> e_next] = e_durUs < UINT32_MAX ? (uint32_t) e_durUs
+                                                                       : UINT32_MAX;
+   e_pPerBoard -> e_next = (e_pPerBoard -> e_next + 1) % E_HEDGE_WINDOW;
+   if (e_pPerBoard -> e_numDur < E_HEDGE_WINDOW)
+      e_pPerBoard -> e_numDur++;
+}
+
+static int e_cmpDurs(const void* e_pLeft,
+                     const void* e_pRight)
+{
+   const uint32_t e_left = *(const uint32_t*) e_pLeft;
+   const uint32_t e_right = *(const uint32_t*) e_pRight;
+   return (e_left > e_right) - (e_left < e_right);
+}
+
+static E_perBoard* e_findBoard(E_engine* restrict e_pEng,
+                               const B_board* restrict e_pBoard,
+                               bool e_fAdd)
+{
+   // several descriptions of the same array (for instance, two targets of a concurrent session) share
+   // its state: the arrays are identified by their URL prefix
+   for (size_t i = 0; i < e_pEng -> e_numBoards; i++) {
+      const B_board* e_pCurr = e_pEng -> e_boards[i].e_pBoard;
+      if (e_pCurr == e_pBoard ||
+          (e_pCurr -> b_hwMod == e_pBoard -> b_hwMod &&
+           !strcmp(e_pCurr -> b_strPref, e_pBoard -> b_strPref)))
+         return e_pEng -> e_boards + i;
+   }
+   if (!e_fAdd)
+      return CST_PVOID;
+   // the queued targets are linked among themselves, hence the states may be moved
+   if (e_pEng -> e_numBoards == e_pEng -> e_capBoards) {
+      const size_t e_newCap = e_pEng -> e_capBoards ? 2 * e_pEng -> e_capBoards
+                                                    : 4;
+      E_perBoard* e_newBoards = realloc(e_pEng -> e_boards, e_newCap * sizeof(E_perBoard));
+      if (!e_newBoards)
+         return CST_PVOID;
+      e_pEng -> e_boards = e_newBoards;
+      e_pEng -> e_capBoards = e_newCap;
+   }
+   E_perBoard* e_pPerBoard = e_pEng -> e_boards + e_pEng -> e_numBoards;
+   e_pEng -> e_numBoards++;
+   memset(e_pPerBoard, 0, sizeof(E_perBoard));
+   e_pPerBoard -> e_pBoard = e_pBoard;
+   return e_pPerBoard;
+}
+
+static E_target* e_coalesce(E_perBoard* restrict e_pPerBoard,
+                            const E_target* restrict e_pTarg)
+{
+   if (e_pTarg -> e_comm.p_oAct != oAct_numOAct)
+      return CST_PVOID;
+   // the last queued command on the same relay, unless a status query follows it (the query would
+   // observe the superseded state)
+   E_target* e_pSuper = CST_PVOID;
+   E_target* e_pPrev = CST_PVOID;
+   E_target* e_pSuperPrev = CST_PVOID;
+   for (E_target* e_pCurr = e_pPerBoard -> e_pHead; e_pCurr; e_pPrev = e_pCurr, e_pCurr = e_pCurr -> e_pNext)
+      if (e_pCurr -> e_comm.p_oAct != oAct_numOAct)
+         e_pSuper = CST_PVOID;
+      else if (e_pCurr -> e_comm.p_rID == e_pTarg -> e_comm.p_rID) {
+         e_pSuper = e_pCurr;
+         e_pSuperPrev = e_pPrev;
+      }
+   if (!e_pSuper)
+      return CST_PVOID;
+   if (e_pSuperPrev)
+      e_pSuperPrev -> e_pNext = e_pSuper -> e_pNext;
+   else
+      e_pPerBoard -> e_pHead = e_pSuper -> e_pNext;
+   if (e_pPerBoard -> e_pTail == e_pSuper)
+      e_pPerBoard -> e_pTail = e_pSuperPrev;
+   e_pPerBoard -> e_depth--;
+   e_pSuper -> e_pNext = CST_PVOID;
+   e_pSuper -> e_fCoalesced = true;
+   return e_pSuper;
+}
@@ -0,0 +1,182 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "group.h"
+#include "model.h"
+#include "constants.h"
+#include "err_wrapper.h"
+
+#define G_FIELD_SEP  ';'  // separates the fields of an array
+
+// parses an array (<host>;[<port>];<model>)
+// returns either wRC_Cd_noError or wRC_Cd_wrI
+static int g_parseBoard(B_board* restrict g_pBoard,
+                        size_t g_lenStr, const char* g_str);
+// obtains the next field of a line separated by spaces (false is returned if there is none)
+static bool g_nextField(size_t g_lenLine, const char* g_line,
+                        size_t* restrict g_pPos,
+                        const char** g_ppField,
+                        size_t* restrict g_pLenField);
+
+int G_parseGroup(G_group* restrict g_pGroup,
+                 size_t g_lenLine, const char* const g_line)
+{
+   if (!g_pGroup ||
+       !g_line)
+      return wRC_Cd_invP;
+   memset(g_pGroup, 0, sizeof(G_group));
+   size_t g_pos = 0;
+   const char* g_field;
+   size_t g_lenField;
+   if (!g_nextField(g_lenLine, g_line,
+                    &g_pos,
+                    &g_field,
+                    &g_lenField) ||
+       g_lenField > G_MAXLEN_NAME)
+      return wRC_Cd_wrI;
+   for (size_t i = 0; i < g_lenField; i++)
+      if (!isalnum(g_field[i]) &&
+          g_field[i] != '-' &&
+          g_field[i] != '_')
+         return wRC_Cd_wrI;
+   memcpy(g_pGroup -> g_name, g_field, g_lenField);
+   // the members are counted first, so that they are allocated at once
+   size_t g_numBoard = 0;
+   const size_t g_posFst = g_pos;
+   while (g_nextField(g_lenLine, g_line,
+                      &g_pos,
+                      &g_field,
+                      &g_lenField))
+      g_numBoard++;
+   if (!g_numBoard)
+      return wRC_Cd_wrI;
+   B_board* g_boards = calloc(g_numBoard, sizeof(B_board));
+   if (!g_boards)
+      return wRC_Cd_heapManFail;
+   g_pos = g_posFst;
+   for (size_t i = 0; i < g_numBoard; i++) {
+      g_nextField(g_lenLine, g_line,
+                  &g_pos,
+                  &g_field,
+                  &g_lenField);
+      if (g_parseBoard(g_boards + i,
+                       g_lenField, g_field)) {
+         free(g_boards);
+         return wRC_Cd_wrI;
+      }
+   }
+   g_pGroup -> g_boards = g_boards;
+   g_pGroup -> g_numBoard = g_numBoard;
+   return wRC_Cd_noError;
+}
+
+bool G_splitComm(size_t g_lenLine, const char* g_line,
+                 size_t* restrict g_pLenComm,
+                 const char** g_ppName,
+                 size_t* restrict g_pLenName)
+{
+   size_t g_end = g_lenLine;
+   while (g_end &&
+          isspace(g_line[g_end - 1]))
+      g_end--;
+   size_t g_start = g_end;
+   while (g_start &&
+          !isspace(g_line[g_start - 1]))
+      g_start--;
+   if (g_start == g_end ||
+       g_line[g_start] != G_PREFIX)
+      return false;
+   *g_ppName = g_line + g_start + 1;
+   *g_pLenName = g_end - g_start - 1;
+   while (g_start &&
+          isspace(g_line[g_start - 1]))
+      g_start--;
+   *g_pLenComm = g_start;
+   return true;
+}
+
+const G_group* G_find(size_t g_numGroup, const G_group g_groups[],
+                      size_t g_lenName, const char* const g_strName)
+{
+   // few groups are defined: a linear search suffices
+   for (size_t i = 0; i < g_numGroup; i++)
+      if (strlen(g_groups[i].g_name) == g_lenName &&
+          !memcmp(g_groups[i].g_name, g_strName, g_lenName))
+         return g_groups + i;
+   return CST_PVOID;
+}
+
+void G_cleanup(G_group* restrict g_pGroup)
+{
+   if (!g_pGroup)
+      return;
+   free(g_pGroup -> g_boards);
+   memset(g_pGroup, 0, sizeof(G_group));
+}
+
+static int g_parseBoard(B_board* restrict g_pBoard,
+                        size_t g_lenStr, const char* g_str)
+{
+   const char* g_sep1 = memchr(g_str, G_FIELD_SEP, g_lenStr);
+   if (!g_sep1)
+      return wRC_Cd_wrI;
+   const char* g_sep2 = memchr(g_sep1 + 1, G_FIELD_SEP, (size_t) (g_str + g_lenStr - g_sep1 - 1));
+   if (!g_sep2 ||
+       memchr(g_sep2 + 1, G_FIELD_SEP, (size_t) (g_str + g_lenStr - g_sep2 - 1)))
+      return wRC_Cd_wrI;
+   const size_t g_lenHost = (size_t) (g_sep1 - g_str);
+   const size_t g_lenPort = (size_t) (g_sep2 - g_sep1 - 1);
+   const size_t g_lenMod = (size_t) (g_str + g_lenStr - g_sep2 - 1);
+   char g_strHost[B_MAXSZSTR_HOST] = {0};
+   char g_strPort[B_MAXSZSTR_PRT] = {0};
+   char g_strMod[G_MAXLEN_NAME + 1] = {0};
+   if (!B_chkHost(g_lenHost, g_str) ||
+       g_lenPort >= B_MAXSZSTR_PRT ||
+       g_lenMod > G_MAXLEN_NAME)
+      return wRC_Cd_wrI;
+   memcpy(g_strHost, g_str, g_lenHost);
+   memcpy(g_strPort, g_sep1 + 1, g_lenPort);
+   memcpy(g_strMod, g_sep2 + 1, g_lenMod);
+   const enum r_mCodes g_hwMod = D_findModel(g_strMod);
+   const D_model* g_pMod = D_getModel(g_hwMod);
+   if (!g_pMod ||
+       strspn(g_strPort, "0123456789") != g_lenPort ||
+       strtoul(g_strPort, 0, 10) > 65535 ||
+       (g_pMod -> d_fPort &&
+        !g_lenPort))
+      return wRC_Cd_wrI;
+   if (B_initBoard(g_pBoard,
+                   g_lenHost + 1, g_strHost,
+                   g_lenPort + 1, g_strPort,
+                   g_hwMod))
+      return wRC_Cd_wrI;
+   return wRC_Cd_noError;
+}
+
+static bool g_nextField(size_t g_lenLine, const char* g_line,
+                        size_t* restrict g_pPos,
+                        const char** g_ppField,
+                        size_t* restrict g_pLenField)
+{
+   size_t g_pos = *g_pPos;
+   while (g_pos < g_lenLine &&
+          isspace(g_line[g_pos]))
+      g_pos++;
+   if (g_pos == g_lenLine) {
+      *g_pPos = g_pos;
+      return false;
+   }
+   const size_t g_start = g_pos;
+   while (g_pos < g_lenLine &&
+          !isspace(g_line[g_pos]))
+      g_pos++;
+   *g_pPos = g_pos;
+   *g_ppField = g_line + g_start;
+   *g_pLenField = g_pos - g_start;
+   return true;
+}
@@ -0,0 +1,471 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "metrics.h"
+#include "model.h"
+#include "constants.h"
+#include "err_wrapper.h"
+
+#define M_INITCAP  4U  // initial capacity of the array of web relay arrays
+#define M_MAXVAL   ((UINT64_C(1) << ((M_MAXMSB) + 1U)) - 1U)  // largest value held by a histogram
+#define M_SUFF_TMP  ".tmp"                                  // suffix of the temporary file written before a metrics file is replaced
+
+// names of the phases within a report
+static const char* m_phaseNames[M_ph_num] = {"lookup", "connect", "first byte", "total"};
+// names of the phases within the Prometheus labels
+static const char* m_phaseLabels[M_ph_num] = {"lookup", "connect", "first_byte", "total"};
+// the percentiles of a report
+static const double m_quants[] = {0.5, 0.9, 0.99, 0.999};
+
+// the web relay array of the registry (a null pointer is returned if there is none)
+static M_board* m_find(const M_registry* restrict m_pReg,
+                       const B_board* restrict m_pBoard);
+// index of the bucket that holds a value: the values lower than 2 * M_NUMSUB have a bucket each,
+// the other ones are identified by their most significant bit and the following M_SUBBITS bits
+static size_t m_index(uint64_t m_val);
+// the largest value held by a bucket
+static uint64_t m_upperBound(size_t m_idx);
+// prints the labels that identify a web relay array (the trailing separator of the URL prefix is
+// omitted). The closing brace is left to the caller
+static void m_printLabels(const M_board* restrict m_pEntry,
+                          FILE* m_pStream);
+
+void M_init(M_registry* restrict m_pReg)
+{
+   memset(m_pReg, 0, sizeof(M_registry));
+}
+
+int M_record(M_registry* restrict m_pReg,
+             const B_board* restrict m_pBoard,
+             const M_sample* restrict m_pSample)
+{
+   M_board* m_pEntry = m_find(m_pReg, m_pBoard);
+   if (!m_pEntry) {
+      if (m_pReg -> m_numBoards == m_pReg -> m_cap) {
+         const size_t m_newCap = m_pReg -> m_cap ? 2 * (m_pReg -> m_cap)
+                                                 : M_INITCAP;
+         M_board* m_newBoards = realloc(m_pReg -> m_boards, m_newCap * sizeof(M_board));
+         if (!m_newBoards)
+            return wRC_Cd_heapManFail;
+         m_pReg -> m_boards = m_newBoards;
+         m_pReg -> m_cap = m_newCap;
+      }
+      m_pEntry = m_pReg -> m_boards + m_pReg -> m_numBoards;
+      m_pReg -> m_numBoards++;
+      memset(m_pEntry, 0, sizeof(M_board));
+      memcpy(m_pEntry -> m_strPref, m_pBoard -> b_strPref, m_pBoard -> b_lenPref + 1);
+      m_pEntry -> m_hwMod = m_pBoard -> b_hwMod;
+   }
+   if (m_pSample -> m_depth > m_pEntry -> m_maxDepth)
+      m_pEntry -> m_maxDepth = m_pSample -> m_depth;
+   // a coalesced command has never been sent
+   if (m_pSample -> m_fCoalesced) {
+      m_pEntry -> m_numCoal++;
+      return wRC_Cd_noError;
+   }
+   m_pEntry -> m_numReq++;
+   m_pEntry -> m_numRetry += m_pSample -> m_numRetry;
+   if (m_pSample -> m_fHedged)
+      m_pEntry -> m_numHedge++;
+   if (m_pSample -> m_fHedgeWon)
+      m_pEntry -> m_numHedgeWon++;
+   // a request that failed without a connection has reused nothing
+   if (m_pSample -> m_fNewConn)
+      m_pEntry -> m_numConn++;
+   else if (!(m_pSample -> m_libCode))
+      m_pEntry -> m_numReuse++;
+   if (m_pSample -> m_fHandshake)
+      m_pEntry -> m_numHandshake++;
+   if (m_pSample -> m_libCode) {
+      m_pEntry -> m_numFail++;
+      const unsigned m_idxLib = (unsigned) m_pSample -> m_libCode < M_NUMLIBCD ? (unsigned) m_pSample -> m_libCode
+                                                                               : M_NUMLIBCD - 1;
+      m_pEntry -> m_numLibErr[m_idxLib]++;
+   }
+   else if (m_pSample -> m_resCode != 200) {
+      // the codes that do not fit share code 0, held by the last slot
+      unsigned i = 0;
+      while (i < m_pEntry -> m_numResCd &&
+             m_pEntry -> m_resCounts[i].m_resCode != m_pSample -> m_resCode)
+         i++;
+      if (i == m_pEntry -> m_numResCd) {
+         if (m_pEntry -> m_numResCd < M_NUMRESCD - 1 &&
+             m_pSample -> m_resCode) {
+            m_pEntry -> m_resCounts[i].m_resCode = m_pSample -> m_resCode;
+            m_pEntry -> m_numResCd++;
+         }
+         else
+            i = M_NUMRESCD - 1;
+      }
+      m_pEntry -> m_resCounts[i].m_num++;
+   }
+   else if (!(m_pSample -> m_fParsed))
+      m_pEntry -> m_numParseFail++;
+   else {
+      m_pEntry -> m_stat = m_pSample -> m_stat;
+      m_pEntry -> m_fStat = true;
+   }
+   if (m_pSample -> m_numBytes > 0)
+      m_pEntry -> m_numBytes += (uint64_t) m_pSample -> m_numBytes;
+   for (unsigned i = 0; i < M_ph_num; i++)
+      if (m_pSample -> m_times[i] >= 0)
+         M_recordValue(m_pEntry -> m_hists + i,
+                       (uint64_t) m_pSample -> m_times[i]);
+   if (m_pSample -> m_queueTime >= 0)
+      M_recordValue(&(m_pEntry -> m_queue),
+                    (uint64_t) m_pSample -> m_queueTime);
+   return wRC_Cd_noError;
+}
+
+void M_recordRun(M_registry* restrict m_pReg,
+                 uint64_t m_drift)
+{
+   m_pReg -> m_fSched = true;
+   m_pReg -> m_sched.m_numRun++;
+   M_recordValue(&(m_pReg -> m_sched.m_drift),
+                 m_drift);
+}
+
+void M_recordMissed(M_registry* restrict m_pReg,
+                    unsigned long m_numMissed)
+{
+   m_pReg -> m_fSched = true;
+   m_pReg -> m_sched.m_numMissed += m_numMissed;
+}
+
+void M_recordValue(M_hist* restrict m_pHist,
+                   uint64_t m_val)
+{
+   if (m_val > M_MAXVAL)
+      m_val = M_MAXVAL;
+   if (!(m_pHist -> m_num) ||
+       m_val < m_pHist -> m_min)
+      m_pHist -> m_min = m_val;
+   if (m_val > m_pHist -> m_max)
+      m_pHist -> m_max = m_val;
+   m_pHist -> m_num++;
+   m_pHist -> m_sum += m_val;
+   m_pHist -> m_counts[m_index(m_val)]++;
+}
+
+uint64_t M_quantile(const M_hist* restrict m_pHist,
+                    double m_quant)
+{
+   if (!(m_pHist -> m_num))
+      return 0;
+   // the rank of the value (starting from one)
+   uint64_t m_rank = (uint64_t) (m_quant * (double) m_pHist -> m_num);
+   if ((double) m_rank < m_quant * (double) m_pHist -> m_num)
+      m_rank++;
+   if (!m_rank)
+      m_rank = 1;
+   uint64_t m_cumul = 0;
+   for (size_t i = 0; i < M_NUMBUCK; i++) {
+      m_cumul += m_pHist -> m_counts[i];
+      if (m_cumul >= m_rank) {
+         const uint64_t m_upper = m_upperBound(i);
+         return m_upper < m_pHist -> m_max ? m_upper
+                                           : m_pHist -> m_max;
+      }
+   }
+   return m_pHist -> m_max;
+}
+
+uint64_t M_lowerBound(size_t m_idx)
+{
+   if (m_idx < 2 * M_NUMSUB)
+      return m_idx;
+   const unsigned m_shift = m_idx / M_NUMSUB - 1;
+   return (uint64_t) (M_NUMSUB + m_idx % M_NUMSUB) << m_shift;
+}
+
+void M_dump(const M_registry* restrict m_pReg,
+            FILE* m_pStream)
+{
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      const M_board* m_pEntry = m_pReg -> m_boards + i;
+      fprintf(m_pStream, "[INF] latency of %s: %lu request(s), %lu failure(s), %lu retry(ies), %llu byte(s)\n", m_pEntry -> m_strPref, m_pEntry -> m_numReq, m_pEntry -> m_numFail, m_pEntry -> m_numRetry, (unsigned long long) m_pEntry -> m_numBytes);
+      if (m_pEntry -> m_numHedge)
+         fprintf(m_pStream, "      %lu hedge(s), %lu won by the hedge\n", m_pEntry -> m_numHedge, m_pEntry -> m_numHedgeWon);
+      if (m_pEntry -> m_maxDepth ||
+          m_pEntry -> m_numCoal)
+         fprintf(m_pStream, "      %lu coalesced command(s), largest queue depth %lu\n", m_pEntry -> m_numCoal, m_pEntry -> m_maxDepth);
+      fprintf(m_pStream, "      %lu new connection(s), %lu TLS handshake(s), %lu kept-alive connection(s) reused\n", m_pEntry -> m_numConn, m_pEntry -> m_numHandshake, m_pEntry -> m_numReuse);
+      fprintf(m_pStream, "      %-10s %10s %10s %10s %10s %10s %10s %10s (ms)\n", "phase", "min", "p50", "p90", "p99", "p99.9", "max", "mean");
+      for (unsigned j = 0; j < M_ph_num; j++) {
+         const M_hist* m_pHist = m_pEntry -> m_hists + j;
+         if (!(m_pHist -> m_num))
+            continue;
+         fprintf(m_pStream, "      %-10s %10.3f", m_phaseNames[j], m_pHist -> m_min / 1000.0);
+         for (size_t k = 0; k < sizeof(m_quants) / sizeof(m_quants[0]); k++)
+            fprintf(m_pStream, " %10.3f", M_quantile(m_pHist, m_quants[k]) / 1000.0);
+         fprintf(m_pStream, " %10.3f %10.3f\n", m_pHist -> m_max / 1000.0, (double) m_pHist -> m_sum / m_pHist -> m_num / 1000.0);
+      }
+      // the queueing delay is reported once a request has waited for the array
+      const M_hist* m_pHist = &(m_pEntry -> m_queue);
+      if (m_pEntry -> m_maxDepth &&
+          m_pHist -> m_num) {
+         fprintf(m_pStream, "      %-10s %10.3f", "queue", m_pHist -> m_min / 1000.0);
+         for (size_t k = 0; k < sizeof(m_quants) / sizeof(m_quants[0]); k++)
+            fprintf(m_pStream, " %10.3f", M_quantile(m_pHist, m_quants[k]) / 1000.0);
+         fprintf(m_pStream, " %10.3f %10.3f\n", m_pHist -> m_max / 1000.0, (double) m_pHist -> m_sum / m_pHist -> m_num / 1000.0);
+      }
+   }
+   if (m_pReg -> m_fSched) {
+      const M_hist* m_pHist = &(m_pReg -> m_sched.m_drift);
+      fprintf(m_pStream, "[INF] schedule: %lu run(s), %lu missed occurrence(s)\n", m_pReg -> m_sched.m_numRun, m_pReg -> m_sched.m_numMissed);
+      if (m_pHist -> m_num) {
+         fprintf(m_pStream, "      %-10s %10.3f", "drift", m_pHist -> m_min / 1000.0);
+         for (size_t k = 0; k < sizeof(m_quants) / sizeof(m_quants[0]); k++)
+            fprintf(m_pStream, " %10.3f", M_quantile(m_pHist, m_quants[k]) / 1000.0);
+         fprintf(m_pStream, " %10.3f %10.3f (ms)\n", m_pHist -> m_max / 1000.0, (double) m_pHist -> m_sum / m_pHist -> m_num / 1000.0);
+      }
+   }
+   fflush(m_pStream);
+}
+
+bool M_printProm(const M_registry* restrict m_pReg,
+                 FILE* m_pStream)
+{
+   static const char m_strType[] = "# HELP %s %s\n# TYPE %s %s\n";
+   fprintf(m_pStream, m_strType, "wrctrl_requests_total", "Requests sent to a web relay array.", "wrctrl_requests_total", "counter");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      fputs("wrctrl_requests_total", m_pStream);
+      m_printLabels(m_pReg -> m_boards + i, m_pStream);
+      fprintf(m_pStream, "} %lu\n", m_pReg -> m_boards[i].m_numReq);
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_request_retries_total", "Attempts of a request that failed transiently and have been retried.", "wrctrl_request_retries_total", "counter");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      fputs("wrctrl_request_retries_total", m_pStream);
+      m_printLabels(m_pReg -> m_boards + i, m_pStream);
+      fprintf(m_pStream, "} %lu\n", m_pReg -> m_boards[i].m_numRetry);
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_hedges_total", "Requests duplicated on a fresh connection because they were slow.", "wrctrl_hedges_total", "counter");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      fputs("wrctrl_hedges_total", m_pStream);
+      m_printLabels(m_pReg -> m_boards + i, m_pStream);
+      fprintf(m_pStream, "} %lu\n", m_pReg -> m_boards[i].m_numHedge);
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_hedge_wins_total", "Hedges that were answered before the request they duplicated.", "wrctrl_hedge_wins_total", "counter");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      fputs("wrctrl_hedge_wins_total", m_pStream);
+      m_printLabels(m_pReg -> m_boards + i, m_pStream);
+      fprintf(m_pStream, "} %lu\n", m_pReg -> m_boards[i].m_numHedgeWon);
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_coalesced_total", "Commands superseded by a later command on the same relay before being sent.", "wrctrl_coalesced_total", "counter");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      fputs("wrctrl_coalesced_total", m_pStream);
+      m_printLabels(m_pReg -> m_boards + i, m_pStream);
+      fprintf(m_pStream, "} %lu\n", m_pReg -> m_boards[i].m_numCoal);
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_connections_total", "Requests that opened a connection towards a web relay array.", "wrctrl_connections_total", "counter");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      fputs("wrctrl_connections_total", m_pStream);
+      m_printLabels(m_pReg -> m_boards + i, m_pStream);
+      fprintf(m_pStream, "} %lu\n", m_pReg -> m_boards[i].m_numConn);
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_tls_handshakes_total", "Requests that performed a TLS handshake (a resumed session included).", "wrctrl_tls_handshakes_total", "counter");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      fputs("wrctrl_tls_handshakes_total", m_pStream);
+      m_printLabels(m_pReg -> m_boards + i, m_pStream);
+      fprintf(m_pStream, "} %lu\n", m_pReg -> m_boards[i].m_numHandshake);
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_connection_reuses_total", "Requests answered through a kept-alive connection (no handshake).", "wrctrl_connection_reuses_total", "counter");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      fputs("wrctrl_connection_reuses_total", m_pStream);
+      m_printLabels(m_pReg -> m_boards + i, m_pStream);
+      fprintf(m_pStream, "} %lu\n", m_pReg -> m_boards[i].m_numReuse);
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_queue_depth_max", "Largest number of requests towards a web relay array that were ahead of a request.", "wrctrl_queue_depth_max", "gauge");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      fputs("wrctrl_queue_depth_max", m_pStream);
+      m_printLabels(m_pReg -> m_boards + i, m_pStream);
+      fprintf(m_pStream, "} %lu\n", m_pReg -> m_boards[i].m_maxDepth);
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_http_errors_total", "Responses whose code is not 200 (code 0 gathers the codes that do not fit).", "wrctrl_http_errors_total", "counter");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      const M_board* m_pEntry = m_pReg -> m_boards + i;
+      for (unsigned j = 0; j < m_pEntry -> m_numResCd; j++) {
+         fputs("wrctrl_http_errors_total", m_pStream);
+         m_printLabels(m_pEntry, m_pStream);
+         fprintf(m_pStream, ",code=\"%ld\"} %lu\n", m_pEntry -> m_resCounts[j].m_resCode, m_pEntry -> m_resCounts[j].m_num);
+      }
+      if (m_pEntry -> m_resCounts[M_NUMRESCD - 1].m_num) {
+         fputs("wrctrl_http_errors_total", m_pStream);
+         m_printLabels(m_pEntry, m_pStream);
+         fprintf(m_pStream, ",code=\"0\"} %lu\n", m_pEntry -> m_resCounts[M_NUMRESCD - 1].m_num);
+      }
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_curl_errors_total", "Requests that failed within curl, by CURLcode.", "wrctrl_curl_errors_total", "counter");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      const M_board* m_pEntry = m_pReg -> m_boards + i;
+      for (unsigned j = 0; j < M_NUMLIBCD; j++) {
+         if (!(m_pEntry -> m_numLibErr[j]))
+            continue;
+         fputs("wrctrl_curl_errors_total", m_pStream);
+         m_printLabels(m_pEntry, m_pStream);
+         fprintf(m_pStream, ",code=\"%u\"} %lu\n", j, m_pEntry -> m_numLibErr[j]);
+      }
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_parse_failures_total", "Responses whose status of the relays could not be parsed.", "wrctrl_parse_failures_total", "counter");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      fputs("wrctrl_parse_failures_total", m_pStream);
+      m_printLabels(m_pReg -> m_boards + i, m_pStream);
+      fprintf(m_pStream, "} %lu\n", m_pReg -> m_boards[i].m_numParseFail);
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_received_bytes_total", "Bytes of the responses (the headers are not included).", "wrctrl_received_bytes_total", "counter");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      fputs("wrctrl_received_bytes_total", m_pStream);
+      m_printLabels(m_pReg -> m_boards + i, m_pStream);
+      fprintf(m_pStream, "} %llu\n", (unsigned long long) m_pReg -> m_boards[i].m_numBytes);
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_relay_on", "Last status read from a relay (1 stands for on).", "wrctrl_relay_on", "gauge");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      const M_board* m_pEntry = m_pReg -> m_boards + i;
+      if (!(m_pEntry -> m_fStat))
+         continue;
+      for (unsigned j = 0; j < P_CST_NUMREL; j++) {
+         fputs("wrctrl_relay_on", m_pStream);
+         m_printLabels(m_pEntry, m_pStream);
+         fprintf(m_pStream, ",relay=\"%u\"} %d\n", j + 1, (m_pEntry -> m_stat & R_ON_MASK(j)) ? 1
+                                                                                                 : 0);
+      }
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_request_duration_seconds", "Time elapsed from the beginning of a request until the end of each phase.", "wrctrl_request_duration_seconds", "summary");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      const M_board* m_pEntry = m_pReg -> m_boards + i;
+      for (unsigned j = 0; j < M_ph_num; j++) {
+         const M_hist* m_pHist = m_pEntry -> m_hists + j;
+         for (size_t k = 0; k < sizeof(m_quants) / sizeof(m_quants[0]); k++) {
+            fputs("wrctrl_request_duration_seconds", m_pStream);
+            m_printLabels(m_pEntry, m_pStream);
+            fprintf(m_pStream, ",phase=\"%s\",quantile=\"%g\"} %.6f\n", m_phaseLabels[j], m_quants[k], M_quantile(m_pHist, m_quants[k]) / 1e6);
+         }
+         fputs("wrctrl_request_duration_seconds_sum", m_pStream);
+         m_printLabels(m_pEntry, m_pStream);
+         fprintf(m_pStream, ",phase=\"%s\"} %.6f\n", m_phaseLabels[j], m_pHist -> m_sum / 1e6);
+         fputs("wrctrl_request_duration_seconds_count", m_pStream);
+         m_printLabels(m_pEntry, m_pStream);
+         fprintf(m_pStream, ",phase=\"%s\"} %llu\n", m_phaseLabels[j], (unsigned long long) m_pHist -> m_num);
+      }
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_queue_delay_seconds", "Time elapsed from the submission of a request until its first attempt.", "wrctrl_queue_delay_seconds", "summary");
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      const M_board* m_pEntry = m_pReg -> m_boards + i;
+      const M_hist* m_pHist = &(m_pEntry -> m_queue);
+      for (size_t k = 0; k < sizeof(m_quants) / sizeof(m_quants[0]); k++) {
+         fputs("wrctrl_queue_delay_seconds", m_pStream);
+         m_printLabels(m_pEntry, m_pStream);
+         fprintf(m_pStream, ",quantile=\"%g\"} %.6f\n", m_quants[k], M_quantile(m_pHist, m_quants[k]) / 1e6);
+      }
+      fputs("wrctrl_queue_delay_seconds_sum", m_pStream);
+      m_printLabels(m_pEntry, m_pStream);
+      fprintf(m_pStream, "} %.6f\n", m_pHist -> m_sum / 1e6);
+      fputs("wrctrl_queue_delay_seconds_count", m_pStream);
+      m_printLabels(m_pEntry, m_pStream);
+      fprintf(m_pStream, "} %llu\n", (unsigned long long) m_pHist -> m_num);
+   }
+   if (m_pReg -> m_fSched) {
+      const M_sched* m_pSched = &(m_pReg -> m_sched);
+      fprintf(m_pStream, m_strType, "wrctrl_schedule_runs_total", "Occurrences of the entries of the schedule that have been run.", "wrctrl_schedule_runs_total", "counter");
+      fprintf(m_pStream, "wrctrl_schedule_runs_total %lu\n", m_pSched -> m_numRun);
+      fprintf(m_pStream, m_strType, "wrctrl_schedule_missed_total", "Occurrences of the entries of the schedule that have not been run.", "wrctrl_schedule_missed_total", "counter");
+      fprintf(m_pStream, "wrctrl_schedule_missed_total %lu\n", m_pSched -> m_numMissed);
+      fprintf(m_pStream, m_strType, "wrctrl_schedule_drift_seconds", "Delay of a run in regards to its due instant.", "wrctrl_schedule_drift_seconds", "summary");
+      for (size_t k = 0; k < sizeof(m_quants) / sizeof(m_quants[0]); k++)
+         fprintf(m_pStream, "wrctrl_schedule_drift_seconds{quantile=\"%g\"} %.6f\n", m_quants[k], M_quantile(&(m_pSched -> m_drift), m_quants[k]) / 1e6);
+      fprintf(m_pStream, "wrctrl_schedule_drift_seconds_sum %.6f\n", m_pSched -> m_drift.m_sum / 1e6);
+      fprintf(m_pStream, "wrctrl_schedule_drift_seconds_count %llu\n", (unsigned long long) m_pSched -> m_drift.m_num);
+   }
+   fprintf(m_pStream, m_strType, "wrctrl_last_update_timestamp_seconds", "Instant at which the metrics have been written.", "wrctrl_last_update_timestamp_seconds", "gauge");
+   fprintf(m_pStream, "wrctrl_last_update_timestamp_seconds %lld\n", (long long) time(CST_PVOID));
+   return !ferror(m_pStream);
+}
+
+int M_writeProm(const M_registry* restrict m_pReg,
+                const char* const m_path)
+{
+   if (!m_pReg ||
+       !m_path)
+      return wRC_Cd_invP;
+   const size_t m_lenPath = strlen(m_path);
+   char* m_pathTmp = malloc(m_lenPath + sizeof(M_SUFF_TMP));
+   if (!m_pathTmp)
+      return wRC_Cd_heapManFail;
+   memcpy(m_pathTmp, m_path, m_lenPath);
+   memcpy(m_pathTmp + m_lenPath, M_SUFF_TMP, sizeof(M_SUFF_TMP));
+   int m_errCode = wRC_Cd_noError;
+   FILE* m_pFile = fopen(m_pathTmp, "w");
+   if (!m_pFile) {
+      m_errCode = wRC_Cd_wrPPar;
+      goto M_WRITEPROM_EXIT;
+   }
+   // the metrics reach the disk before the file is replaced
+   bool m_fOk = M_printProm(m_pReg, m_pFile);
+   m_fOk = !fflush(m_pFile) && m_fOk;
+   m_fOk = !fsync(fileno(m_pFile)) && m_fOk;
+   m_fOk = !fclose(m_pFile) && m_fOk;
+   if (!m_fOk ||
+       rename(m_pathTmp, m_path)) {
+      remove(m_pathTmp);
+      m_errCode = wRC_Cd_wrPPar;
+   }
+   M_WRITEPROM_EXIT:
+   free(m_pathTmp);
+   return m_errCode;
+}
+
+void M_cleanup(M_registry* restrict m_pReg)
+{
+   free(m_pReg -> m_boards);
+   memset(m_pReg, 0, sizeof(M_registry));
+}
+
+static M_board* m_find(const M_registry* restrict m_pReg,
+                       const B_board* restrict m_pBoard)
+{
+   // few web relay arrays are addressed by a single invocation: a linear search suffices
+   for (size_t i = 0; i < m_pReg -> m_numBoards; i++) {
+      M_board* m_pEntry = m_pReg -> m_boards + i;
+      if (m_pEntry -> m_hwMod == m_pBoard -> b_hwMod &&
+          !strcmp(m_pEntry -> m_strPref, m_pBoard -> b_strPref))
+         return m_pEntry;
+   }
+   return CST_PVOID;
+}
+
+static void m_printLabels(const M_board* restrict m_pEntry,
+                          FILE* m_pStream)
+{
+   // the URL prefix holds neither quotes nor back-slashes
+   const size_t m_lenPref = strlen(m_pEntry -> m_strPref);
+   const D_model* m_pMod = D_getModel(m_pEntry -> m_hwMod);
+   fprintf(m_pStream, "{array=\"%.*s\",model=\"%s\"", (int) (m_lenPref ? m_lenPref - 1
+                                                                          : 0), m_pEntry -> m_strPref,
+           m_pMod ? m_pMod -> d_name
+                  : "unknown");
+}
+
+static size_t m_index(uint64_t m_val)
+{
+   if (m_val < 2 * M_NUMSUB)
+      return (size_t) m_val;
+   const unsigned m_msb = 63 - __builtin_clzll(m_val);
+   const unsigned m_shift = m_msb - M_SUBBITS;
+   return (size_t) (m_shift + 1) * M_NUMSUB + (size_t) ((m_val >> m_shift) - M_NUMSUB);
+}
+
+static uint64_t m_upperBound(size_t m_idx)
+{
+   if (m_idx < 2 * M_NUMSUB)
+      return m_idx;
+   const unsigned m_shift = m_idx / M_NUMSUB - 1;
+   return ((uint64_t) (M_NUMSUB + m_idx % M_NUMSUB + 1) << m_shift) - 1;
+}
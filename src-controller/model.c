@@ -0,0 +1,58 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <string.h>
+#include "model.h"
+#include "constants.h"
+
+// the descriptors, indexed by the model. A new model needs a descriptor, a parser of its html
+// response (see P_respFeeder) and a code in r_mCodes
+static const D_model d_models[r_numMod] = {
+   [r_kmTronic] = {.d_name = "KMTronic_wr",
+                   .d_numRel = 8,
+                   .d_fPort = false,
+                   .d_comm = {{"FF0100", "FF0101"},
+                              {"FF0200", "FF0201"},
+                              {"FF0300", "FF0301"},
+                              {"FF0400", "FF0401"},
+                              {"FF0500", "FF0501"},
+                              {"FF0600", "FF0601"},
+                              {"FF0700", "FF0701"},
+                              {"FF0800", "FF0801"}},
+                   .d_stat = "relays.cgi",
+                   .d_mask = "FFE0",
+                   .d_szRow = 0,
+                   .d_feed = P_feedKMTronicResp},
+   [r_nc800]    = {.d_name = "NC800",
+                   .d_numRel = 8,
+                   .d_fPort = true,
+                   .d_comm = {{"00", "01"},
+                              {"02", "03"},
+                              {"04", "05"},
+                              {"06", "07"},
+                              {"08", "09"},
+                              {"10", "11"},
+                              {"12", "13"},
+                              {"14", "15"}},
+                   .d_stat = "", // the NC800 describes its relays on the main page
+                   .d_mask = CST_PVOID,
+                   .d_szRow = 4,
+                   .d_feed = P_feedNC800Resp}
+};
+
+const D_model* D_getModel(enum r_mCodes d_hwMod)
+{
+   if ((unsigned) d_hwMod >= r_numMod)
+      return CST_PVOID;
+   return d_models + d_hwMod;
+}
+
+enum r_mCodes D_findModel(const char* const d_strName)
+{
+   for (unsigned i = 0; i < r_numMod; i++)
+      if (!strcmp(d_strName, d_models[i].d_name))
+         return (enum r_mCodes) i;
+   return r_numMod;
+}
@@ -0,0 +1,147 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "output.h"
+#include "model.h"
+#include "parser_constants.h"
+#include "constants.h"
+
+// the status of the relays as a bit mask (bit i stands for relay i + 1)
+static unsigned o_relayBits(r_stat o_stat);
+
+void O_describeComm(const P_out* restrict o_pComm,
+                    char o_strComm[static O_MAXSZCOMM])
+{
+   if (o_pComm -> p_oAct == oAct_status)
+      strcpy(o_strComm, "status");
+   else
+      snprintf(o_strComm, O_MAXSZCOMM, "%s%d", o_pComm -> p_fAct ? "on"
+                                                                 : "off", o_pComm -> p_rID + 1);
+}
+
+size_t O_format(enum O_formats o_fmt,
+                const O_record* restrict o_pRec,
+                char o_strRec[static O_MAXSZREC])
+{
+   // the trailing separator of the URL prefix is dropped
+   const B_board* o_pBoard = o_pRec -> o_pBoard;
+   const char* o_strBoard = "-";
+   int o_lenBoard = 1;
+   const char* o_strMod = "-";
+   if (o_pBoard) {
+      o_strBoard = o_pBoard -> b_strPref;
+      o_lenBoard = (int) (o_pBoard -> b_lenPref ? o_pBoard -> b_lenPref - 1
+                                                : 0);
+      o_strMod = o_pBoard -> b_pMod ? o_pBoard -> b_pMod -> d_name
+                                    : "unknown";
+   }
+   const char* o_strComm = o_pRec -> o_strComm ? o_pRec -> o_strComm
+                                               : "invalid";
+   const bool o_fSent = o_pRec -> o_time >= 0;
+   const unsigned o_numAttempt = o_pRec -> o_numAttempt ? o_pRec -> o_numAttempt
+                                                        : 1;
+   const unsigned o_bits = o_relayBits(o_pRec -> o_stat);
+   // the fields that are not available are replaced by null (JSON) or - (the other formats)
+   char o_strCode[24] = "-";
+   char o_strLib[16] = "-";
+   char o_strTime[32] = "-";
+   char o_strAtt[16] = "-";
+   char o_strStat[P_CST_NUMREL + 1] = "-";
+   int o_len = 0;
+   switch (o_fmt) {
+      case O_fmt_json: if (o_fSent) {
+                          snprintf(o_strCode, sizeof(o_strCode), "%ld", o_pRec -> o_resCode);
+                          snprintf(o_strLib, sizeof(o_strLib), "%d", o_pRec -> o_libCode);
+                          snprintf(o_strTime, sizeof(o_strTime), "%.3f", o_pRec -> o_time / 1000.0);
+                          snprintf(o_strAtt, sizeof(o_strAtt), "%u", o_numAttempt);
+                       }
+                       else {
+                          strcpy(o_strCode, "null");
+                          strcpy(o_strLib, "null");
+                          strcpy(o_strTime, "null");
+                          strcpy(o_strAtt, "null");
+                       }
+                       if (o_pRec -> o_fStat)
+                          snprintf(o_strStat, sizeof(o_strStat), "%u", o_bits);
+                       else
+                          strcpy(o_strStat, "null");
+                       o_len = snprintf(o_strRec, O_MAXSZREC,
+                                        "{\"seq\":%zu,\"board\":\"%.*s\",\"model\":\"%s\",\"command\":\"%s\",\"code\":%s,\"curl\":%s,\"ms\":%s,\"status\":%s,\"attempts\":%s}\n",
+                                        o_pRec -> o_seq, o_lenBoard, o_strBoard, o_strMod, o_strComm,
+                                        o_strCode, o_strLib, o_strTime, o_strStat, o_strAtt);
+                       break;
+      case  O_fmt_tsv: if (o_fSent) {
+                          snprintf(o_strCode, sizeof(o_strCode), "%ld", o_pRec -> o_resCode);
+                          snprintf(o_strLib, sizeof(o_strLib), "%d", o_pRec -> o_libCode);
+                          snprintf(o_strTime, sizeof(o_strTime), "%.3f", o_pRec -> o_time / 1000.0);
+                          snprintf(o_strAtt, sizeof(o_strAtt), "%u", o_numAttempt);
+                       }
+                       if (o_pRec -> o_fStat) {
+                          for (unsigned i = 0; i < P_CST_NUMREL; i++)
+                             o_strStat[i] = (o_bits & (1U << i)) ? '1'
+                                                                 : '0';
+                          o_strStat[P_CST_NUMREL] = '\0';
+                       }
+                       o_len = snprintf(o_strRec, O_MAXSZREC, "%zu\t%.*s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\n",
+                                        o_pRec -> o_seq, o_lenBoard, o_strBoard, o_strMod, o_strComm,
+                                        o_strCode, o_strLib, o_strTime, o_strStat, o_strAtt);
+                       break;
+      case  O_fmt_raw: // the model is implied by the board
+                       if (o_fSent) {
+                          snprintf(o_strCode, sizeof(o_strCode), "%ld", o_pRec -> o_resCode);
+                          snprintf(o_strLib, sizeof(o_strLib), "%d", o_pRec -> o_libCode);
+                          snprintf(o_strTime, sizeof(o_strTime), "%lld", o_pRec -> o_time);
+                          snprintf(o_strAtt, sizeof(o_strAtt), "%u", o_numAttempt);
+                       }
+                       if (o_pRec -> o_fStat)
+                          snprintf(o_strStat, sizeof(o_strStat), "%02X", o_bits);
+                       o_len = snprintf(o_strRec, O_MAXSZREC, "%zu %.*s %s %s %s %s %s %s\n",
+                                        o_pRec -> o_seq, o_lenBoard, o_strBoard, o_strComm,
+                                        o_strCode, o_strLib, o_strTime, o_strStat, o_strAtt);
+                       break;
+      default:         return 0;
+   }
+   if (o_len < 0)
+      return 0;
+   return (size_t) o_len < O_MAXSZREC ? (size_t) o_len
+                                      : O_MAXSZREC - 1;
+}
+
+bool O_emit(enum O_formats o_fmt,
+            const O_record* restrict o_pRec,
+            int o_fd)
+{
+   char o_strRec[O_MAXSZREC];
+   const size_t o_lenRec = O_format(o_fmt,
+                                    o_pRec,
+                                    o_strRec);
+   if (!o_lenRec)
+      return o_fmt == O_fmt_text;
+   // a regular file or a pipe receives the whole record at once; a short write is completed anyway
+   size_t o_numWritten = 0;
+   while (o_numWritten < o_lenRec) {
+      const ssize_t o_num = write(o_fd, o_strRec + o_numWritten, o_lenRec - o_numWritten);
+      if (o_num < 0) {
+         if (errno == EINTR)
+            continue;
+         return false;
+      }
+      o_numWritten += (size_t) o_num;
+   }
+   return true;
+}
+
+static unsigned o_relayBits(r_stat o_stat)
+{
+   unsigned o_bits = 0;
+   for (unsigned i = 0; i < P_CST_NUMREL; i++)
+      if (o_stat & R_ON_MASK(i))
+         o_bits |= 1U << i;
+   return o_bits;
+}
@@ -0,0 +1,109 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sched.h"
+#include "err_wrapper.h"
+
+#define S_INITCAP  16U  // initial capacity of the array of events
+
+uint64_t S_now(void)
+{
+   struct timespec s_ts;
+   clock_gettime(CLOCK_MONOTONIC, &s_ts);
+   return (uint64_t) s_ts.tv_sec * 1000000000ULL + (uint64_t) s_ts.tv_nsec;
+}
+
+void S_init(S_heap* restrict s_pHeap)
+{
+   memset(s_pHeap, 0, sizeof(S_heap));
+}
+
+int S_push(S_heap* restrict s_pHeap,
+           uint64_t s_deadline,
+           void* s_pData)
+{
+   if (!s_pHeap)
+      return wRC_Cd_invP;
+   if (s_pHeap -> s_numEvts == s_pHeap -> s_cap) {
+      const size_t s_newCap = s_pHeap -> s_cap ? 2 * (s_pHeap -> s_cap)
+                                               : S_INITCAP;
+      S_event* s_newEvts = realloc(s_pHeap -> s_evts, s_newCap * sizeof(S_event));
+      if (!s_newEvts)
+         return wRC_Cd_heapManFail;
+      s_pHeap -> s_evts = s_newEvts;
+      s_pHeap -> s_cap = s_newCap;
+   }
+   // sifting up
+   size_t s_idx = s_pHeap -> s_numEvts++;
+   while (s_idx) {
+      const size_t s_parent = (s_idx - 1) / 2;
+      if (s_pHeap -> s_evts[s_parent].s_deadline <= s_deadline)
+         break;
+      s_pHeap -> s_evts[s_idx] = s_pHeap -> s_evts[s_parent];
+      s_idx = s_parent;
+   }
+   s_pHeap -> s_evts[s_idx].s_deadline = s_deadline;
+   s_pHeap -> s_evts[s_idx].s_pData = s_pData;
+   return wRC_Cd_noError;
+}
+
+bool S_peek(const S_heap* restrict s_pHeap,
+            S_event* restrict s_pEvt)
+{
+   if (!(s_pHeap -> s_numEvts))
+      return false;
+   *s_pEvt = s_pHeap -> s_evts[0];
+   return true;
+}
+
+bool S_pop(S_heap* restrict s_pHeap,
+           S_event* restrict s_pEvt)
+{
+   if (!(s_pHeap -> s_numEvts))
+      return false;
+   if (s_pEvt)
+      *s_pEvt = s_pHeap -> s_evts[0];
+   const S_event s_last = s_pHeap -> s_evts[--(s_pHeap -> s_numEvts)];
+   // sifting down the last event from the root
+   size_t s_idx = 0;
+   while (true) {
+      size_t s_child = 2 * s_idx + 1;
+      if (s_child >= s_pHeap -> s_numEvts)
+         break;
+      if (s_child + 1 < s_pHeap -> s_numEvts &&
+          s_pHeap -> s_evts[s_child + 1].s_deadline < s_pHeap -> s_evts[s_child].s_deadline)
+         s_child++;
+      if (s_last.s_deadline <= s_pHeap -> s_evts[s_child].s_deadline)
+         break;
+      s_pHeap -> s_evts[s_idx] = s_pHeap -> s_evts[s_child];
+      s_idx = s_child;
+   }
+   if (s_pHeap -> s_numEvts)
+      s_pHeap -> s_evts[s_idx] = s_last;
+   return true;
+}
+
+int S_waitTime(const S_heap* restrict s_pHeap,
+               int s_maxWait)
+{
+   if (!(s_pHeap -> s_numEvts))
+      return s_maxWait;
+   const uint64_t s_now = S_now();
+   const uint64_t s_deadline = s_pHeap -> s_evts[0].s_deadline;
+   if (s_deadline <= s_now)
+      return 0;
+   const uint64_t s_wait = (s_deadline - s_now + S_NSPERMS - 1) / S_NSPERMS;
+   return s_wait < (uint64_t) s_maxWait ? (int) s_wait
+                                        : s_maxWait;
+}
+
+void S_cleanup(S_heap* restrict s_pHeap)
+{
+   free(s_pHeap -> s_evts);
+   memset(s_pHeap, 0, sizeof(S_heap));
+}
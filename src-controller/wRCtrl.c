@@ -1,15 +1,21 @@
 /**************************************/
 /* Author: Pavlo Nykolyn              */
-/* Last modification date: 21/05/2023 */
+/* Last modification date: 17/10/2026 */
 /**************************************/
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <ctype.h>
 #include <stdbool.h>
 #include <curl/curl.h>
 #include "ctrl.h"
+#include "board.h"
+#include "model.h"
+#include "engine.h"
+#include "cache.h"
+#include "sched.h"
+#include "parser.h"
+#include "constants.h"
 #include "err_wrapper.h"
 
 // input parameter keys
@@ -19,19 +25,66 @@
 #define WRC_BEH_KEY     "--behaviour"
 #define WRC_MNEMCD_KEY  "--mnemonic-code"
 #define WRC_MODEL_KEY   "--model"
+#define WRC_TARG_KEY    "--targets"
+#define WRC_MAXIF_KEY   "--max-in-flight"
+#define WRC_PULSE_KEY   "--pulse"
+#define WRC_STTL_KEY    "--status-ttl"
+#define WRC_IDEM_KEY    "--idempotent"
+#define WRC_SCRIPT_KEY  "--script"
+#define WRC_MASK_KEY    "--mask"
+#define WRC_LAT_KEY     "--latency"
+#define WRC_METRICS_KEY "--metrics-file"
+#define WRC_OUTPUT_KEY  "--output"
+#define WRC_SOCKET_KEY  "--socket"
+#define WRC_SCHED_KEY   "--schedule"
+#define WRC_DEADL_KEY   "--deadline"
+#define WRC_CONNT_KEY   "--connect-timeout"
+#define WRC_RETRY_KEY   "--retries"
+#define WRC_HEDGE_KEY   "--hedge"
+#define WRC_QUEUE_KEY   "--queue"
+#define WRC_GROUPS_KEY  "--groups"
+#define WRC_RESOLVE_KEY "--resolve"
+#define WRC_SCHEME_KEY  "--scheme"
+#define WRC_CAFILE_KEY  "--ca-file"
 // error messages
-#define WRC_WRIPV4LEN_MSG  "[ERR] The length of an IPv4 address is not correct\n"
-#define WRC_WRIPV4SEQ_MSG  "[ERR] More than three digits or an unrecognised character belong to an IPv4 address sequence\n"
+#define WRC_WRHOST_MSG     "[ERR] The address is neither an IPv4 address, a host name nor a bracketed IPv6 address\n"
+#define WRC_WRTARG_MSG     "[ERR] The format of a target is not correct\n"
+#define WRC_NATIVE_MSG     "[ERR] The built-in transport supports only the single and the iterative sessions, through http\n"
 // program behaviour
 #define WRC_SINGLE  "single"
 #define WRC_ITER    "iter"
-// supported values for the --model key
-#define WRC_KMTRONIC  "KMTronic_wr"
-#define WRC_NC800     "NC800"
+#define WRC_CONC    "concurrent"
+#define WRC_PULSE   "pulse"
+#define WRC_BATCH   "batch"
+#define WRC_DAEMON  "daemon"
+#define WRC_CRON    "cron"
+// the value of the --idempotent key that indicates a status that never becomes stale
+#define WRC_UNBOUNDED  "unbounded"
+// supported values for the --latency key
+#define WRC_LAT_SIGNAL  "signal"
+#define WRC_LAT_EXIT    "exit"
+// supported values for the --output key
+#define WRC_OUT_TEXT  "text"
+#define WRC_OUT_JSON  "json"
+#define WRC_OUT_TSV   "tsv"
+#define WRC_OUT_RAW   "raw"
+// supported values for the --queue key
+#define WRC_QUEUE_SERIAL    "serial"
+#define WRC_QUEUE_COALESCE  "coalesce"
+// supported values for the --resolve key
+#define WRC_RESOLVE_STARTUP  "startup"
+// supported values for the --scheme key
+#define WRC_SCHEME_HTTP   "http"
+#define WRC_SCHEME_HTTPS  "https"
+// the supported values for the --model key are the names of the models (see model.h)
 // generic macros
-#define WRC_MINSZSTR_IPV4   8U  // minimum size of the string that contains an IPv4 address (the null character is included)
-#define WRC_MAXSZSTR_IPV4  16U  // maximum size of the string that contains an IPv4 address (the null character is included)
 #define WRC_MAXSZSTR_PRT    6U  // maximum size of the string that contains a port number
+#define WRC_TARG_SEP       ','  // separates the targets of the --targets key
+#define WRC_MNEMCD_SEP     ","  // separates the mnemonic codes of the --mnemonic-code key
+#define WRC_MAXNUMMNEMCD   16U  // maximum number of mnemonic codes of a single invocation
+#define WRC_PULSE_SEP      ","  // separates the pulses of the --pulse key
+#define WRC_MAXNUMPULSE     8U  // maximum number of pulses of a single invocation
+#define WRC_TARGF_SEP      ";"  // separates the fields of a target
 // macros related to initial checks
 // bit masks
 #define WRC_PROT_NONE   0x00  // no protocol is supported
@@ -41,15 +94,45 @@
 
 typedef unsigned char wRC_supProt_t; // indicates the protocols needed by this tool that are supported by the underlying libcurl
 
-enum wRC_keyCodes {wRC_ipv4,      /**< IPv4 address of the web relay */
+enum wRC_keyCodes {wRC_ipv4,      /**< address (IPv4, name or IPv6) of the web relay */
                    wRC_port,      /**< port associated to a web relay */
                    wRC_beh,       /**< behaviour adopted by the program */
                    wRc_mnemCode,  /**< mnemonic code */
                    wRC_model,     /**< model of the web relay */
+                   wRC_targ,      /**< targets of a concurrent session */
+                   wRC_maxIF,     /**< maximum number of concurrent transfers */
+                   wRC_pulse,     /**< pulses of a pulse session */
+                   wRC_sTTL,      /**< validity of the status cache */
+                   wRC_idem,      /**< idempotent mode */
+                   wRC_script,    /**< script of a batch session */
+                   wRC_mask,      /**< status of every relay of a single session */
+                   wRC_lat,       /**< latency report */
+                   wRC_metrics,   /**< file that receives the metrics */
+                   wRC_output,    /**< format of the output */
+                   wRC_socket,    /**< socket of a daemon */
+                   wRC_sched,     /**< schedule of a cron session */
+                   wRC_deadl,     /**< deadline of a request */
+                   wRC_connT,     /**< maximum duration of the establishment of a connection */
+                   wRC_retry,     /**< maximum number of retries of a request */
+                   wRC_hedge,     /**< percentile that delays the hedge of a request */
+                   wRC_queue,     /**< queueing of the commands towards the same array */
+                   wRC_groups,    /**< groups of arrays of a batch session */
+                   wRC_resolve,   /**< resolution of the names of the arrays */
+                   wRC_scheme,    /**< scheme of the URLs of the arrays */
+                   wRC_caFile,    /**< certificates that verify the arrays */
                    wRC_help,      /**< information on how to use the program */
                    wRC_maxNumCds  /**< maximum number of codes */
                   };
 
+enum wRC_behCodes {wRC_bSingle,  /**< a single operation */
+                   wRC_bIter,    /**< an iterative session */
+                   wRC_bConc,    /**< concurrent operations on several web relay arrays */
+                   wRC_bPulse,   /**< pulses on several web relay arrays */
+                   wRC_bBatch,   /**< the commands of a script */
+                   wRC_bDaemon,  /**< the commands received on a Unix domain socket */
+                   wRC_bCron     /**< the entries of a schedule */
+                  };
+
 typedef struct wRC_iPar {
 // indicates whether a parameter has been specified on the command line
    bool wRC_fDef;
@@ -63,21 +146,56 @@ typedef struct wRC_iPar {
 static void wRC_usage(void)
 {
    fputs("wRCtrl --ipv4=<address> [--port=<port>] --model=<model> [--behaviour=<type> [--mnemonic-code=<code>]]\n\
+                 [--status-ttl=<milliseconds>] [--idempotent=<milliseconds>|unbounded] [--latency=signal|exit]\n\
+                 [--metrics-file=<file>] [--output=<format>]\n\
+          wRCtrl --ipv4=<address> [--port=<port>] --model=<model> [--behaviour=single] --mask=<relays>\n\
+                 [--metrics-file=<file>] [--output=<format>]\n\
+          wRCtrl --behaviour=concurrent --targets=<target>{,<target>} [--max-in-flight=<number>]\n\
+                 [--metrics-file=<file>] [--output=<format>]\n\
+          wRCtrl --behaviour=pulse (--ipv4=<address> [--port=<port>] --model=<model> | --targets=<array>{,<array>})\n\
+                 --pulse=<pulse>{,<pulse>} [--max-in-flight=<number>] [--metrics-file=<file>] [--output=<format>]\n\
+          wRCtrl --behaviour=batch (--ipv4=<address> [--port=<port>] --model=<model> [--groups=<file>] |\n\
+                 --groups=<file>) [--script=<file>] [--max-in-flight=<number>] [--metrics-file=<file>]\n\
+                 [--output=<format>]\n\
+          wRCtrl --behaviour=daemon (--ipv4=<address> [--port=<port>] --model=<model> | --targets=<array>{,<array>})\n\
+                 --socket=<file> [--max-in-flight=<number>] [--metrics-file=<file>] [--output=<format>]\n\
+          wRCtrl --behaviour=cron (--ipv4=<address> [--port=<port>] --model=<model> | --targets=<array>{,<array>})\n\
+                 --schedule=<file> [--max-in-flight=<number>] [--metrics-file=<file>] [--output=<format>]\n\
+          every behaviour also accepts [--deadline=<milliseconds>] [--connect-timeout=<milliseconds>]\n\
+                 [--retries=<number>] [--scheme=http|https [--ca-file=<file>]]; every behaviour but single and iter accepts either [--hedge=<percentile>]\n\
+                 or [--queue=serial|coalesce] (pulse accepts only serial) and [--resolve=startup]\n\
           wRCtrl --help\n\
+          --ipv4 and the <address> of a target or an array accept an IPv4 address, a host name or an IPv6\n\
+          address enclosed within square brackets (for instance, [fd00::20]). Every request of the\n\
+          process shares the names that have been resolved (each name is kept for 60 s);\n\
           --port has to be defined only for specific models;\n\
-          --behaviour can be one of two types: single, meaning that the program\n\
+          --behaviour can be one of seven types: single, meaning that the program\n\
           will attempt to perform a single operation and then will quit execution;\n\
           iter, meaning that the program will provide the ability to perform an\n\
-          undefined number of operations sequentially.\n\
+          undefined number of operations sequentially;\n\
+          concurrent, meaning that the program will perform the commands of several\n\
+          targets at the same time and then will quit execution;\n\
+          pulse, meaning that the program will turn on, and then turn off, several relays of\n\
+          one or more arrays at the same time and then will quit execution;\n\
+          batch, meaning that the program will perform the commands of a script (one command per line,\n\
+          empty lines and lines beginning with # are ignored) and then will quit execution;\n\
+          daemon, meaning that the program will keep the connections towards one or more arrays open and\n\
+          will perform the commands received on a Unix domain socket until SIGINT or SIGTERM is received;\n\
+          cron, meaning that the program will run the entries of a schedule on one or more arrays until\n\
+          SIGINT or SIGTERM is received.\n\
           The following commands are supported:\n\
           1) turn [on|off] <relay-ID>\n\
              switches the current state of a relay. It is assumed that\n\
              its identifier is an Arab digit (either 0 or 9 will not be accepted);\n\
           2) quit\n\
              terminates an iterative session;\n\
+          3) status\n\
+             reads the status of the relays without commanding any of them;\n\
           if the user enters an unrecognized command, an appropriate error will be displayed but,\n\
           the session will not be terminated;\n\
-          --mnemonic-code indicates the code used to convey a command. It makes sense only when --behaviour\n\
+          --mnemonic-code indicates the code used to convey a command. A list of at most 16 codes, separated\n\
+          by commas, may be supplied (for instance, t_on_1,t_on_3,t_off_5): the codes are performed in order\n\
+          over the same connection. It makes sense only when --behaviour\n\
           is set to single. As such, using this parameter within an iterative instance of the controller will\n\
           cause an error. The structure of the code is the following:\n\
           <action>_<relay-ID> where:\n\
@@ -85,12 +203,113 @@ static void wRC_usage(void)
              1) t_on indicates that the default state of relay has to switch;\n\
              2) t_off indicates that the default state of relay has to be restored;\n\
           b) <relay-ID> <= 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 ;\n\
+          the code status reads the status of the relays without commanding any of them;\n\
+          --mask sets the status of every relay at once, in place of --mnemonic-code (single session only).\n\
+          It holds one character for each relay, from 1 to 8: 1 stands for on and 0 stands for off (for\n\
+          instance, 10100000). The KMTronic_wr receives a single request; the NC800 receives a status query\n\
+          followed by a command for each relay whose status differs. The number of requests is reported;\n\
           --model defines the web relay that is to be queried. The supported devices are:\n\
           a) KMTronic_wr\n\
           b) NC800 (requires the --port option);\n\
           it should be noted that both the \"turn [on|off] <relay-ID>\" and <action>_<relay-ID>\n\
           are absolute commands. That is, if multiple instances of the same command are invoked in\n\
-          a row, only the first one will result in its intended action\n", stdout);
+          a row, only the first one will result in its intended action;\n\
+          --targets is needed only by a concurrent session. Each target has the following structure:\n\
+          <address>;[<port>];<model>;<code>\n\
+          where <port> has to be defined only for specific models;\n\
+          the targets of a pulse or a cron session or of a daemon do not hold a code (<address>;[<port>];<model>);\n\
+          --max-in-flight indicates the maximum number of concurrent transfers of a concurrent, a pulse,\n\
+          a batch or a cron session or of a daemon (it belongs to the interval [1, 256], the default value being 8);\n\
+          --script indicates the file read by a batch session (stdin if it is not given). The commands on\n\
+          different relays are performed concurrently while the commands on the same relay keep the order\n\
+          of the script (a status query waits for every previous command). A failed command does not stop\n\
+          the session; one result line per command is printed, in the order of the script:\n\
+          <line> <on|off><relay-ID>|status <response code>|curl:<code>|input <milliseconds> <relays 1 to 8>\n\
+          --groups indicates the file that names the groups of arrays of a batch session. Each line (empty\n\
+          lines and lines beginning with # are ignored) holds a group:\n\
+          <name> <array>{ <array>} where <name> is made of letters, digits, - and _ and <array> is\n\
+          <address>;[<port>];<model>. A command of the script followed by @<name> (for instance, turn on 3\n\
+          @lab) is sent to every member of the group at once (at most --max-in-flight transfers); it waits\n\
+          for every previous command and the following commands wait for it. A result line per member\n\
+          (whose last field is the array) is printed, followed by the number of arrays, the number of\n\
+          failures and the total duration. Without --ipv4, every command has to be addressed to a group;\n\
+          --pulse indicates at most eight pulses, separated by commas. Each pulse is applied to every\n\
+          array and has the following structure:\n\
+          <relay-ID>:<duration>[<unit>] where <unit> <= ms | s | m (s is the default unit)\n\
+          a pulse turns on a relay and turns it off once its duration has elapsed. Every pulse\n\
+          starts at once; the width and the scheduling jitter of each pulse are reported;\n\
+          --status-ttl indicates for how long (at most one day) the status read from an array is\n\
+          considered valid by either a single or an iterative session. A status query issued within\n\
+          that time does not reach the array; the hits and misses of the cache are reported;\n\
+          --idempotent makes either a single or an iterative session skip a command if the last status\n\
+          read from the array (not older than the given number of milliseconds, unless unbounded is\n\
+          given) shows that the relay is already in the requested state. The number of skipped\n\
+          commands is reported;\n\
+          --latency makes either a single or an iterative session print the breakdown of each request\n\
+          (name lookup, connection, first byte, total and bytes received) and record it within latency\n\
+          histograms. The percentiles of the histograms are printed on stderr once SIGUSR1 is received\n\
+          and, if exit is given, at the end of the session;\n\
+          --metrics-file indicates the file that receives the metrics of the requests in the Prometheus\n\
+          text format (requests, response codes other than 200, curl errors, responses that could not\n\
+          be parsed, bytes received, status of each relay and latency quantiles). The file is replaced\n\
+          atomically (for instance, within the directory of the textfile collector of the node exporter)\n\
+          at the end of the session; a pulse or a batch session also replaces it at most once per second\n\
+          and an iterative session after each request. For --mask, it holds the last request;\n\
+          --output selects the format of the outcome of each operation: text (the default), json, tsv or\n\
+          raw. Every format but text writes a single record per operation (by a single system call) in\n\
+          place of the messages: a JSON object per line, tab-separated values or space-separated values.\n\
+          A record holds the sequence number of the operation (the line of a batch script), the array,\n\
+          the model (except raw), the command, the response code, the curl error code, the duration\n\
+          (milliseconds, microseconds for raw), the status of relays 1 to 8 (a number whose bit 0 is\n\
+          relay 1 for json, eight characters among 0 and 1 for tsv, two hexadecimal digits for raw) and\n\
+          the number of attempts of the request.\n\
+          An iterative session does not support it;\n\
+          --socket indicates the Unix domain socket on which a daemon receives its requests, one per line:\n\
+          <array> <mnemonic code> (<array> is the position of the array, starting from 1), metrics (the\n\
+          metrics in the Prometheus text format, terminated by # EOF) or quit (closes the connection).\n\
+          The response to a command is a record (raw, unless --output selects another format) whose\n\
+          sequence number is the position of the request within the connection. The commands are\n\
+          performed concurrently: the responses may not follow the order of the requests;\n\
+          --schedule indicates the file read by a cron session. Each line (empty lines and lines beginning\n\
+          with # are ignored) holds an entry:\n\
+          <minute> <hour> <day of the month> <month> <day of the week> <array> <relay-ID>{,<relay-ID>} <action>\n\
+          where the first five fields form a cron expression evaluated in local time (*, values, ranges\n\
+          <first>-<last>, steps /<step> and lists separated by commas; @hourly, @daily, @weekly, @monthly\n\
+          and @yearly replace the five fields), <array> is the position of the array (starting from 1) and\n\
+          <action> is either on, off or a pulse duration (<duration>[<unit>], as for --pulse). An occurrence\n\
+          that cannot be run within a minute, or whose previous run is not over, is missed. The runs, missed\n\
+          occurrences, failures and maximum drift of each entry are printed at the end and on stderr once\n\
+          SIGUSR1 is received;\n\
+          --deadline bounds each request, every attempt and every backoff included (5000 ms by default,\n\
+          0 disables it, at most one day). A request whose attempt fails to connect, times out, loses\n\
+          its connection or yields a response code 5xx is retried after a random delay (exponential\n\
+          backoff with jitter, from 100 ms up to 1 s) unless the deadline would be exceeded;\n\
+          --connect-timeout bounds the establishment of a connection (1000 ms by default);\n\
+          --retries indicates the maximum number of retries of a request (from 0 to 7, 2 by default).\n\
+          The failed attempts are printed on stderr, the records hold the number of attempts;\n\
+          --hedge duplicates, on a fresh connection, a request that has not been answered within the\n\
+          given percentile (from 50 to 99) of the last 64 durations of its array; the first answer is\n\
+          taken. An array is hedged once 16 durations have been measured. The hedged requests and the\n\
+          hedges that answered first are reported;\n\
+          --queue sends a single request at a time to each array (serial), the other commands towards the\n\
+          array waiting in order of submission; the arrays are still addressed concurrently. With coalesce,\n\
+          a waiting command is dropped once a later command on the same relay is submitted, unless a status\n\
+          query lies between them. The coalesced commands, the largest queue depth and the queueing delay\n\
+          of each array are reported;\n\
+          --resolve=startup resolves the name of every array (once per name) before the session starts, so\n\
+          that the first commands do not wait for it. A name that cannot be resolved is reported;\n\
+          --scheme addresses every array through either http (the default) or https. The requests of the\n\
+          process share the kept-alive connections and the TLS sessions: a command reuses the connection\n\
+          of a previous command towards the same array, or resumes its TLS session once the connection has\n\
+          been closed. The new connections, the TLS handshakes and the reused connections of each array are\n\
+          part of the latency report and of the metrics;\n\
+          --ca-file holds the certificates (PEM) that verify the arrays through https, in place of the\n\
+          bundle of libcurl\n", stdout);
+#ifdef WRC_NATIVE_HTTP
+   fputs("This build relies on the built-in transport in place of libcurl: only the single and the iterative\n\
+sessions are available, through http. An attempt fails once its transfer has been idle for the low speed\n\
+time of libwrctrl (in place of a rate below the low speed limit)\n", stdout);
+#endif
 }
 
 static enum wRC_keyCodes wRC_getIParType(const char* const wRC_strIParID)
@@ -107,29 +326,163 @@ static enum wRC_keyCodes wRC_getIParType(const char* const wRC_strIParID)
       return wRc_mnemCode;
    else if (!strcmp(wRC_strIParID, WRC_MODEL_KEY))
       return wRC_model;
+   else if (!strcmp(wRC_strIParID, WRC_TARG_KEY))
+      return wRC_targ;
+   else if (!strcmp(wRC_strIParID, WRC_MAXIF_KEY))
+      return wRC_maxIF;
+   else if (!strcmp(wRC_strIParID, WRC_PULSE_KEY))
+      return wRC_pulse;
+   else if (!strcmp(wRC_strIParID, WRC_STTL_KEY))
+      return wRC_sTTL;
+   else if (!strcmp(wRC_strIParID, WRC_IDEM_KEY))
+      return wRC_idem;
+   else if (!strcmp(wRC_strIParID, WRC_SCRIPT_KEY))
+      return wRC_script;
+   else if (!strcmp(wRC_strIParID, WRC_MASK_KEY))
+      return wRC_mask;
+   else if (!strcmp(wRC_strIParID, WRC_LAT_KEY))
+      return wRC_lat;
+   else if (!strcmp(wRC_strIParID, WRC_METRICS_KEY))
+      return wRC_metrics;
+   else if (!strcmp(wRC_strIParID, WRC_OUTPUT_KEY))
+      return wRC_output;
+   else if (!strcmp(wRC_strIParID, WRC_SOCKET_KEY))
+      return wRC_socket;
+   else if (!strcmp(wRC_strIParID, WRC_SCHED_KEY))
+      return wRC_sched;
+   else if (!strcmp(wRC_strIParID, WRC_DEADL_KEY))
+      return wRC_deadl;
+   else if (!strcmp(wRC_strIParID, WRC_CONNT_KEY))
+      return wRC_connT;
+   else if (!strcmp(wRC_strIParID, WRC_RETRY_KEY))
+      return wRC_retry;
+   else if (!strcmp(wRC_strIParID, WRC_HEDGE_KEY))
+      return wRC_hedge;
+   else if (!strcmp(wRC_strIParID, WRC_QUEUE_KEY))
+      return wRC_queue;
+   else if (!strcmp(wRC_strIParID, WRC_GROUPS_KEY))
+      return wRC_groups;
+   else if (!strcmp(wRC_strIParID, WRC_RESOLVE_KEY))
+      return wRC_resolve;
+   else if (!strcmp(wRC_strIParID, WRC_SCHEME_KEY))
+      return wRC_scheme;
+   else if (!strcmp(wRC_strIParID, WRC_CAFILE_KEY))
+      return wRC_caFile;
    return wRC_maxNumCds;
 }
 
-static bool wRC_chkIPv4(const size_t wRC_szStrIPv4, const char* const wRC_strIPv4)
+static bool wRC_chkHost(size_t wRC_lenHost, const char* const wRC_strHost)
+{
+   if (!B_chkHost(wRC_lenHost, wRC_strHost)) {
+      fputs(WRC_WRHOST_MSG, stderr);
+      return false;
+   }
+   return true;
+}
+
+// the URL of a model holds the port (false if the model is not supported)
+static bool wRC_needsPort(enum r_mCodes wRC_hwModel)
+{
+   const D_model* wRC_pMod = D_getModel(wRC_hwModel);
+   return wRC_pMod &&
+          wRC_pMod -> d_fPort;
+}
+
+static enum O_formats wRC_getFormat(const char* const wRC_strFmt)
+{
+   if (!strcmp(wRC_strFmt, WRC_OUT_TEXT))
+      return O_fmt_text;
+   else if (!strcmp(wRC_strFmt, WRC_OUT_JSON))
+      return O_fmt_json;
+   else if (!strcmp(wRC_strFmt, WRC_OUT_TSV))
+      return O_fmt_tsv;
+   else if (!strcmp(wRC_strFmt, WRC_OUT_RAW))
+      return O_fmt_raw;
+   return O_fmt_num;
+}
+
+// parses the value of the --targets key. Both the array of web relay arrays and the array
+// of targets are allocated on the heap (the caller HAS TO release them)
+// if wRC_fCode is false, the targets do not hold a mnemonic code (<address>;[<port>];<model>)
+static bool wRC_parseTargets(const char* const wRC_strTargs,
+                             bool wRC_fCode,
+                             size_t* restrict wRC_pNumTarg,
+                             B_board** restrict wRC_ppBoards,
+                             E_target** restrict wRC_ppTargs)
 {
-   if (wRC_szStrIPv4 < WRC_MINSZSTR_IPV4 ||
-       wRC_szStrIPv4 > WRC_MAXSZSTR_IPV4) {
-      fputs(WRC_WRIPV4LEN_MSG, stderr);
+   const unsigned wRC_numExpFields = wRC_fCode ? 4
+                                               : 3;
+   size_t wRC_numTarg = 1;
+   for (const char* wRC_pCurr = wRC_strTargs; *wRC_pCurr; wRC_pCurr++)
+      if (*wRC_pCurr == WRC_TARG_SEP)
+         wRC_numTarg++;
+   *wRC_ppBoards = calloc(wRC_numTarg, sizeof(B_board));
+   *wRC_ppTargs = calloc(wRC_numTarg, sizeof(E_target));
+   if (!(*wRC_ppBoards) ||
+       !(*wRC_ppTargs)) {
+      fputs(WRC_MSG_HEAPMANFAIL, stderr);
       return false;
    }
-   unsigned wRC_numDgs = 0; // number of digits of an IPv4 section (resets on each iteration)
-   for (size_t i = 0; i < wRC_szStrIPv4 &&
-                      wRC_strIPv4[i]; i++) {
-      if (isdigit(wRC_strIPv4[i]))
-         wRC_numDgs++;
-      if (!wRC_numDgs ||
-          wRC_numDgs == 4) {
-         fputs(WRC_WRIPV4SEQ_MSG, stderr);
+   *wRC_pNumTarg = wRC_numTarg;
+   const char* wRC_pTarg = wRC_strTargs;
+   for (size_t i = 0; i < wRC_numTarg; i++) {
+      const size_t wRC_lenTarg = strcspn(wRC_pTarg, ",");
+      char wRC_strTarg[wRC_lenTarg + 1];
+      wRC_strTarg[wRC_lenTarg] = '\0';
+      memcpy(wRC_strTarg, wRC_pTarg, wRC_lenTarg);
+      wRC_pTarg += wRC_lenTarg + 1;
+      // splitting the fields (<address>;[<port>];<model>[;<code>])
+      char* wRC_fields[4] = {wRC_strTarg, "", "", ""};
+      unsigned wRC_numFields = 1;
+      for (char* wRC_pCurr = wRC_strTarg; *wRC_pCurr; wRC_pCurr++) {
+         if (*wRC_pCurr == *WRC_TARGF_SEP) {
+            if (wRC_numFields == wRC_numExpFields) {
+               fputs(WRC_WRTARG_MSG, stderr);
+               return false;
+            }
+            *wRC_pCurr = '\0';
+            wRC_fields[wRC_numFields++] = wRC_pCurr + 1;
+         }
+      }
+      if (wRC_numFields != wRC_numExpFields) {
+         fputs(WRC_WRTARG_MSG, stderr);
+         return false;
+      }
+      const size_t wRC_lenIPv4 = strlen(wRC_fields[0]);
+      if (!wRC_chkHost(wRC_lenIPv4, wRC_fields[0]))
+         return false;
+      const size_t wRC_lenPort = strlen(wRC_fields[1]);
+      const enum r_mCodes wRC_hwModel = D_findModel(wRC_fields[2]);
+      const size_t wRC_lenMnemCd = strlen(wRC_fields[3]);
+      if (wRC_lenPort >= WRC_MAXSZSTR_PRT ||
+          strspn(wRC_fields[1], "0123456789") != wRC_lenPort ||
+          strtoul(wRC_fields[1], 0, 10) > 65535 ||
+          wRC_hwModel == r_numMod ||
+          (wRC_needsPort(wRC_hwModel) &&
+           !wRC_lenPort) ||
+          (wRC_fCode &&
+           !wRC_lenMnemCd) ||
+          wRC_lenMnemCd > P_CST_MAXLEN_MNEMCD) {
+         fputs(WRC_WRTARG_MSG, stderr);
+         return false;
+      }
+      if (B_initBoard(*wRC_ppBoards + i,
+                      wRC_lenIPv4 + 1, wRC_fields[0],
+                      wRC_lenPort + 1, wRC_fields[1],
+                      wRC_hwModel)) {
+         fputs(WRC_WRTARG_MSG, stderr);
          return false;
       }
-      else if (wRC_numDgs &&
-               wRC_strIPv4[i] == '.')
-         wRC_numDgs = 0;
+      E_target* wRC_pCurrTarg = *wRC_ppTargs + i;
+      wRC_pCurrTarg -> e_pBoard = *wRC_ppBoards + i;
+      wRC_pCurrTarg -> e_comm.p_oAct = oAct_numOAct;
+      if (!wRC_fCode)
+         continue;
+      char wRC_strMnemCd[P_CST_MAXSZSTR_MNEMCD] = {0};
+      memcpy(wRC_strMnemCd, wRC_fields[3], wRC_lenMnemCd);
+      if (P_parseMnemCode(&(wRC_pCurrTarg -> e_comm),
+                          wRC_strMnemCd))
+         return false;
    }
    return true;
 }
@@ -138,7 +491,7 @@ int main(int argc, char* argv[])
 {
    wRC_iPar wRC_iParColl[wRC_maxNumCds] = {0}; // has a key been defined?
    if (argc == 1 ||
-       argc > 6) {
+       argc > wRC_maxNumCds) {
       wRC_usage();
       return EXIT_FAILURE;
    }
@@ -153,25 +506,46 @@ int main(int argc, char* argv[])
          wRC_usage();
          return EXIT_FAILURE;
       }
+      if (wRC_keyType == wRC_maxNumCds) {
+         fputs(WRC_MSG_WRPPAR, stderr);
+         return EXIT_FAILURE;
+      }
       wRC_iParColl[wRC_keyType].wRC_fDef = true;
       wRC_iParColl[wRC_keyType].wRC_idxPar = i;
       if (wRC_keyType != wRC_help ) {
-         if (*(argv[i] + wRC_next) &&
-             wRC_keyType != wRC_maxNumCds)
+         if (*(argv[i] + wRC_next))
             wRC_iParColl[wRC_keyType].wRC_posVal = wRC_next + 1;
          else {
             fputs(WRC_MSG_WRPPAR, stderr);
-            return false;
+            return EXIT_FAILURE;
          }
       }
    }
-   size_t wRC_szStrIPv4 = WRC_MAXSZSTR_IPV4;
-   char wRC_strIPv4[WRC_MAXSZSTR_IPV4] = {0};
+   size_t wRC_szStrIPv4 = B_MAXSZSTR_HOST;
+   char wRC_strIPv4[B_MAXSZSTR_HOST] = {0};
    size_t wRC_szStrPort = WRC_MAXSZSTR_PRT;
    char wRC_strPort[WRC_MAXSZSTR_PRT] = {0};
-   bool wRC_fBeh = false;
-   char wRC_strMnemCd[P_CST_MAXSZSTR_MNEMCD] = {0};
+   enum wRC_behCodes wRC_behType = wRC_bSingle;
+   size_t wRC_numMnemCd = 0;
+   char wRC_strMnemCds[WRC_MAXNUMMNEMCD][P_CST_MAXSZSTR_MNEMCD] = {0};
    enum r_mCodes wRC_hwModel = r_numMod;
+   unsigned wRC_maxInFlight = E_DEF_MAXINFLIGHT;
+   size_t wRC_numPulse = 0;
+   P_pulse wRC_pulses[WRC_MAXNUMPULSE] = {0};
+   const char* wRC_pathScript = CST_PVOID;
+   const char* wRC_pathSock = CST_PVOID;
+   const char* wRC_pathSched = CST_PVOID;
+   const char* wRC_pathGroups = CST_PVOID;
+   bool wRC_fTls = false;
+   const char* wRC_pathCA = CST_PVOID;
+   r_stat wRC_statMask = R_DEF;
+   rC_opts wRC_opts = {.rC_statTTL = 0,
+                       .rC_fIdem = false,
+                       .rC_maxStale = RC_UNBOUNDED_STALE,
+                       .rC_latRep = rC_lr_none,
+                       .rC_pathMetrics = CST_PVOID,
+                       .rC_outFmt = O_fmt_text};
+   L_defPolicy(&(wRC_opts.rC_policy));
    for (size_t i = 0; i < wRC_maxNumCds; i++) {
       if (wRC_iParColl[i].wRC_fDef) {
          const size_t wRC_lenVal = strlen(argv[wRC_iParColl[i].wRC_idxPar]) - wRC_iParColl[i].wRC_posVal;
@@ -184,12 +558,13 @@ int main(int argc, char* argv[])
          switch (i) {
             case     wRC_help: wRC_usage();
                                return EXIT_SUCCESS;
-            case     wRC_ipv4: if (!wRC_chkIPv4(wRC_lenVal + 1, wRC_pVal))
+            case     wRC_ipv4: if (!wRC_chkHost(wRC_lenVal, wRC_pVal))
                                   return EXIT_FAILURE;
                                memcpy(wRC_strIPv4, wRC_pVal, wRC_lenVal);
                                wRC_szStrIPv4 = wRC_lenVal + 1;
                                break;
-            case     wRC_port: if (strspn(wRC_pVal, "0123456789") != wRC_lenVal ||
+            case     wRC_port: if (wRC_lenVal >= WRC_MAXSZSTR_PRT ||
+                                   strspn(wRC_pVal, "0123456789") != wRC_lenVal ||
                                    strtoul(wRC_pVal, 0, 10) > 65535) {
                                  fputs(WRC_MSG_WRPPAR, stderr);
                                  return EXIT_FAILURE;
@@ -198,22 +573,166 @@ int main(int argc, char* argv[])
                                wRC_szStrPort = wRC_lenVal + 1;
                                break;
             case      wRC_beh: if (!strcmp(wRC_pVal, WRC_ITER))
-                                  wRC_fBeh = true;
+                                  wRC_behType = wRC_bIter;
+                               else if (!strcmp(wRC_pVal, WRC_CONC))
+                                  wRC_behType = wRC_bConc;
+                               else if (!strcmp(wRC_pVal, WRC_PULSE))
+                                  wRC_behType = wRC_bPulse;
+                               else if (!strcmp(wRC_pVal, WRC_BATCH))
+                                  wRC_behType = wRC_bBatch;
+                               else if (!strcmp(wRC_pVal, WRC_DAEMON))
+                                  wRC_behType = wRC_bDaemon;
+                               else if (!strcmp(wRC_pVal, WRC_CRON))
+                                  wRC_behType = wRC_bCron;
                                else if (strcmp(wRC_pVal, WRC_SINGLE)) {
                                   fputs(WRC_MSG_WRPPAR, stderr);
                                   return EXIT_FAILURE;
                                }
                                break;
-            case wRc_mnemCode: if (wRC_lenVal > P_CST_MAXLEN_MNEMCD) {
+            case wRc_mnemCode: // a list of codes separated by commas
+                               while (true) {
+                                  const size_t wRC_lenMnemCd = strcspn(wRC_pVal, WRC_MNEMCD_SEP);
+                                  if (!wRC_lenMnemCd ||
+                                      wRC_lenMnemCd > P_CST_MAXLEN_MNEMCD ||
+                                      wRC_numMnemCd == WRC_MAXNUMMNEMCD) {
+                                     fputs(WRC_MSG_WRPPAR, stderr);
+                                     return EXIT_FAILURE;
+                                  }
+                                  memcpy(wRC_strMnemCds[wRC_numMnemCd], wRC_pVal, wRC_lenMnemCd);
+                                  wRC_numMnemCd++;
+                                  if (!wRC_pVal[wRC_lenMnemCd])
+                                     break;
+                                  wRC_pVal += wRC_lenMnemCd + 1;
+                               }
+                               break;
+            case    wRC_model: wRC_hwModel = D_findModel(wRC_pVal);
+                               if (wRC_hwModel == r_numMod) {
+                                  fputs(WRC_MSG_WRPPAR, stderr);
+                                  return EXIT_FAILURE;
+                               }
+                               break;
+            case     wRC_targ: break; // parsed once the behaviour is known
+            case    wRC_maxIF: if (strspn(wRC_pVal, "0123456789") != wRC_lenVal ||
+                                   wRC_lenVal > 3 ||
+                                   !(wRC_maxInFlight = strtoul(wRC_pVal, 0, 10)) ||
+                                   wRC_maxInFlight > E_MAX_MAXINFLIGHT) {
+                                  fputs(WRC_MSG_WRPPAR, stderr);
+                                  return EXIT_FAILURE;
+                               }
+                               break;
+            case    wRC_pulse: // a list of pulses separated by commas
+                               while (true) {
+                                  const size_t wRC_lenPulse = strcspn(wRC_pVal, WRC_PULSE_SEP);
+                                  if (wRC_numPulse == WRC_MAXNUMPULSE ||
+                                      P_parsePulse(wRC_pulses + wRC_numPulse,
+                                                   wRC_lenPulse, wRC_pVal)) {
+                                     fputs(WRC_MSG_WRPPAR, stderr);
+                                     return EXIT_FAILURE;
+                                  }
+                                  wRC_numPulse++;
+                                  if (!wRC_pVal[wRC_lenPulse])
+                                     break;
+                                  wRC_pVal += wRC_lenPulse + 1;
+                               }
+                               break;
+            case     wRC_sTTL: if (strspn(wRC_pVal, "0123456789") != wRC_lenVal ||
+                                   wRC_lenVal > 8 ||
+                                   (wRC_opts.rC_statTTL = strtoul(wRC_pVal, 0, 10)) > C_MAX_TTL) {
+                                  fputs(WRC_MSG_WRPPAR, stderr);
+                                  return EXIT_FAILURE;
+                               }
+                               break;
+            case     wRC_idem: wRC_opts.rC_fIdem = true;
+                               if (!strcmp(wRC_pVal, WRC_UNBOUNDED))
+                                  break;
+                               if (strspn(wRC_pVal, "0123456789") != wRC_lenVal ||
+                                   wRC_lenVal > 8 ||
+                                   strtoul(wRC_pVal, 0, 10) > C_MAX_TTL) {
+                                  fputs(WRC_MSG_WRPPAR, stderr);
+                                  return EXIT_FAILURE;
+                               }
+                               wRC_opts.rC_maxStale = (uint64_t) strtoul(wRC_pVal, 0, 10) * S_NSPERMS;
+                               break;
+            case   wRC_script: wRC_pathScript = wRC_pVal;
+                               break;
+            case     wRC_mask: if (P_parseMask(&wRC_statMask,
+                                               wRC_lenVal, wRC_pVal)) {
                                   fputs(WRC_MSG_WRPPAR, stderr);
                                   return EXIT_FAILURE;
                                }
-                               memcpy(wRC_strMnemCd, wRC_pVal, wRC_lenVal);
                                break;
-            case    wRC_model: if (!strcmp(wRC_pVal, WRC_KMTRONIC))
-                                  wRC_hwModel = r_kmTronic;
-                               else if (!strcmp(wRC_pVal, WRC_NC800))
-                                  wRC_hwModel = r_nc800;
+            case      wRC_lat: if (!strcmp(wRC_pVal, WRC_LAT_SIGNAL))
+                                  wRC_opts.rC_latRep = rC_lr_signal;
+                               else if (!strcmp(wRC_pVal, WRC_LAT_EXIT))
+                                  wRC_opts.rC_latRep = rC_lr_exit;
+                               else {
+                                  fputs(WRC_MSG_WRPPAR, stderr);
+                                  return EXIT_FAILURE;
+                               }
+                               break;
+            case  wRC_metrics: wRC_opts.rC_pathMetrics = wRC_pVal;
+                               break;
+            case   wRC_output: wRC_opts.rC_outFmt = wRC_getFormat(wRC_pVal);
+                               if (wRC_opts.rC_outFmt == O_fmt_num) {
+                                  fputs(WRC_MSG_WRPPAR, stderr);
+                                  return EXIT_FAILURE;
+                               }
+                               break;
+            case   wRC_socket: wRC_pathSock = wRC_pVal;
+                               break;
+            case    wRC_sched: wRC_pathSched = wRC_pVal;
+                               break;
+            case   wRC_groups: wRC_pathGroups = wRC_pVal;
+                               break;
+            case  wRC_resolve: if (strcmp(wRC_pVal, WRC_RESOLVE_STARTUP)) {
+                                  fputs(WRC_MSG_WRPPAR, stderr);
+                                  return EXIT_FAILURE;
+                               }
+                               wRC_opts.rC_fPreRes = true;
+                               break;
+            case   wRC_scheme: if (!strcmp(wRC_pVal, WRC_SCHEME_HTTPS))
+                                  wRC_fTls = true;
+                               else if (strcmp(wRC_pVal, WRC_SCHEME_HTTP)) {
+                                  fputs(WRC_MSG_WRPPAR, stderr);
+                                  return EXIT_FAILURE;
+                               }
+                               break;
+            case   wRC_caFile: wRC_pathCA = wRC_pVal;
+                               break;
+            case    wRC_deadl: if (strspn(wRC_pVal, "0123456789") != wRC_lenVal ||
+                                   wRC_lenVal > 8 ||
+                                   (wRC_opts.rC_policy.l_deadline = strtoul(wRC_pVal, 0, 10)) > L_MAX_DEADLINE) {
+                                  fputs(WRC_MSG_WRPPAR, stderr);
+                                  return EXIT_FAILURE;
+                               }
+                               break;
+            case    wRC_connT: if (strspn(wRC_pVal, "0123456789") != wRC_lenVal ||
+                                   wRC_lenVal > 8 ||
+                                   !(wRC_opts.rC_policy.l_connTimeout = strtoul(wRC_pVal, 0, 10)) ||
+                                   wRC_opts.rC_policy.l_connTimeout > L_MAX_DEADLINE) {
+                                  fputs(WRC_MSG_WRPPAR, stderr);
+                                  return EXIT_FAILURE;
+                               }
+                               break;
+            case    wRC_retry: if (strspn(wRC_pVal, "0123456789") != wRC_lenVal ||
+                                   wRC_lenVal > 1 ||
+                                   (wRC_opts.rC_policy.l_maxRetry = (unsigned) strtoul(wRC_pVal, 0, 10)) >= L_MAXATTEMPTS) {
+                                  fputs(WRC_MSG_WRPPAR, stderr);
+                                  return EXIT_FAILURE;
+                               }
+                               break;
+            case    wRC_hedge: if (strspn(wRC_pVal, "0123456789") != wRC_lenVal ||
+                                   wRC_lenVal > 2 ||
+                                   (wRC_opts.rC_hedgePct = (unsigned) strtoul(wRC_pVal, 0, 10)) < E_MIN_HEDGEPCT ||
+                                   wRC_opts.rC_hedgePct > E_MAX_HEDGEPCT) {
+                                  fputs(WRC_MSG_WRPPAR, stderr);
+                                  return EXIT_FAILURE;
+                               }
+                               break;
+            case    wRC_queue: if (!strcmp(wRC_pVal, WRC_QUEUE_SERIAL))
+                                  wRC_opts.rC_qMode = E_qm_serial;
+                               else if (!strcmp(wRC_pVal, WRC_QUEUE_COALESCE))
+                                  wRC_opts.rC_qMode = E_qm_coalesce;
                                else {
                                   fputs(WRC_MSG_WRPPAR, stderr);
                                   return EXIT_FAILURE;
@@ -221,21 +740,173 @@ int main(int argc, char* argv[])
          }
       }
    }
-   if ((wRC_fBeh &&
-        wRC_strMnemCd[0]) ||
-       (!wRC_fBeh &&
-        !wRC_strMnemCd[0])) {
+   // a hedge would open a second connection towards a serialized array; the turn off command of a
+   // pulse cannot supersede its turn on command; the certificates are meaningful only through https
+   if ((wRC_iParColl[wRC_hedge].wRC_fDef &&
+        wRC_iParColl[wRC_queue].wRC_fDef) ||
+       (wRC_behType == wRC_bPulse &&
+        wRC_opts.rC_qMode == E_qm_coalesce) ||
+       (wRC_iParColl[wRC_caFile].wRC_fDef &&
+        !wRC_fTls)) {
       fputs(WRC_MSG_WRPPAR, stderr);
       return EXIT_FAILURE;
    }
-   if (wRC_hwModel == r_nc800 &&
-       !(*wRC_strPort)) {
-      fputs(WRC_MSG_WRPPAR, stderr);
+#ifdef WRC_NATIVE_HTTP
+   // the sessions that rely on the multi interface of libcurl are not part of this build
+   if ((wRC_behType != wRC_bSingle &&
+        wRC_behType != wRC_bIter) ||
+       wRC_fTls) {
+      fputs(WRC_NATIVE_MSG, stderr);
       return EXIT_FAILURE;
    }
+   (void) wRC_pathScript;
+   (void) wRC_pathSock;
+   (void) wRC_pathSched;
+   (void) wRC_pathGroups;
+   (void) wRC_pathCA;
+#endif
+   switch (wRC_behType) {
+      case  wRC_bConc: // a concurrent session draws everything from its targets
+                       if (!wRC_iParColl[wRC_targ].wRC_fDef ||
+                           wRC_iParColl[wRC_ipv4].wRC_fDef ||
+                           wRC_iParColl[wRC_port].wRC_fDef ||
+                           wRC_iParColl[wRC_model].wRC_fDef ||
+                           wRC_iParColl[wRC_pulse].wRC_fDef ||
+                           wRC_iParColl[wRC_sTTL].wRC_fDef ||
+                           wRC_iParColl[wRC_idem].wRC_fDef ||
+                           wRC_iParColl[wRC_script].wRC_fDef ||
+                           wRC_iParColl[wRC_mask].wRC_fDef ||
+                           wRC_iParColl[wRC_lat].wRC_fDef ||
+                           wRC_iParColl[wRC_socket].wRC_fDef ||
+                           wRC_iParColl[wRC_sched].wRC_fDef ||
+                           wRC_iParColl[wRC_groups].wRC_fDef ||
+                           wRC_numMnemCd) {
+                          fputs(WRC_MSG_WRPPAR, stderr);
+                          return EXIT_FAILURE;
+                       }
+                       break;
+      case wRC_bPulse: // the arrays are either described by the targets or by --ipv4, --port and --model
+      case wRC_bDaemon:
+      case   wRC_bCron:
+                       if ((wRC_behType == wRC_bPulse) == !wRC_numPulse ||
+                           (wRC_behType == wRC_bDaemon) != wRC_iParColl[wRC_socket].wRC_fDef ||
+                           (wRC_behType == wRC_bCron) != wRC_iParColl[wRC_sched].wRC_fDef ||
+                           wRC_numMnemCd ||
+                           wRC_iParColl[wRC_mask].wRC_fDef ||
+                           wRC_iParColl[wRC_lat].wRC_fDef ||
+                           wRC_iParColl[wRC_sTTL].wRC_fDef ||
+                           wRC_iParColl[wRC_idem].wRC_fDef ||
+                           wRC_iParColl[wRC_script].wRC_fDef ||
+                           wRC_iParColl[wRC_groups].wRC_fDef ||
+                           (wRC_iParColl[wRC_targ].wRC_fDef &&
+                            (wRC_iParColl[wRC_ipv4].wRC_fDef ||
+                             wRC_iParColl[wRC_port].wRC_fDef ||
+                             wRC_iParColl[wRC_model].wRC_fDef)) ||
+                           (!wRC_iParColl[wRC_targ].wRC_fDef &&
+                            (!wRC_iParColl[wRC_ipv4].wRC_fDef ||
+                             wRC_hwModel == r_numMod ||
+                             (wRC_needsPort(wRC_hwModel) &&
+                              !(*wRC_strPort))))) {
+                          fputs(WRC_MSG_WRPPAR, stderr);
+                          return EXIT_FAILURE;
+                       }
+                       break;
+      case wRC_bBatch: // a batch session addresses a single array, described by --ipv4, --port and --model,
+                       // and the groups (without them, the array is required)
+                       if (wRC_numMnemCd ||
+                           wRC_iParColl[wRC_mask].wRC_fDef ||
+                           wRC_iParColl[wRC_lat].wRC_fDef ||
+                           wRC_iParColl[wRC_targ].wRC_fDef ||
+                           wRC_iParColl[wRC_pulse].wRC_fDef ||
+                           wRC_iParColl[wRC_sTTL].wRC_fDef ||
+                           wRC_iParColl[wRC_idem].wRC_fDef ||
+                           wRC_iParColl[wRC_socket].wRC_fDef ||
+                           wRC_iParColl[wRC_sched].wRC_fDef ||
+                           (wRC_iParColl[wRC_groups].wRC_fDef &&
+                            !wRC_iParColl[wRC_ipv4].wRC_fDef &&
+                            (wRC_iParColl[wRC_port].wRC_fDef ||
+                             wRC_iParColl[wRC_model].wRC_fDef)) ||
+                           ((!wRC_iParColl[wRC_groups].wRC_fDef ||
+                             wRC_iParColl[wRC_ipv4].wRC_fDef) &&
+                            (!wRC_iParColl[wRC_ipv4].wRC_fDef ||
+                             wRC_hwModel == r_numMod ||
+                             (wRC_needsPort(wRC_hwModel) &&
+                              !(*wRC_strPort))))) {
+                          fputs(WRC_MSG_WRPPAR, stderr);
+                          return EXIT_FAILURE;
+                       }
+                       break;
+      default:         if (wRC_iParColl[wRC_targ].wRC_fDef ||
+                           wRC_iParColl[wRC_maxIF].wRC_fDef ||
+                           // the single and the iterative sessions send one request at a time
+                           wRC_iParColl[wRC_hedge].wRC_fDef ||
+                           wRC_iParColl[wRC_queue].wRC_fDef ||
+                           wRC_iParColl[wRC_resolve].wRC_fDef ||
+                           wRC_iParColl[wRC_pulse].wRC_fDef ||
+                           wRC_iParColl[wRC_script].wRC_fDef ||
+                           wRC_iParColl[wRC_socket].wRC_fDef ||
+                           wRC_iParColl[wRC_sched].wRC_fDef ||
+                           wRC_iParColl[wRC_groups].wRC_fDef ||
+                           // an iterative session is meant for a person
+                           (wRC_behType == wRC_bIter &&
+                            (wRC_numMnemCd ||
+                             wRC_iParColl[wRC_mask].wRC_fDef ||
+                             wRC_opts.rC_outFmt != O_fmt_text)) ||
+                           (wRC_behType == wRC_bSingle &&
+                            !wRC_numMnemCd == !wRC_iParColl[wRC_mask].wRC_fDef) ||
+                           // the status of every relay is set at once: neither the cache nor the idempotent mode apply
+                           (wRC_iParColl[wRC_mask].wRC_fDef &&
+                            (wRC_iParColl[wRC_sTTL].wRC_fDef ||
+                             wRC_iParColl[wRC_idem].wRC_fDef ||
+                             wRC_iParColl[wRC_lat].wRC_fDef))) {
+                          fputs(WRC_MSG_WRPPAR, stderr);
+                          return EXIT_FAILURE;
+                       }
+                       if (wRC_needsPort(wRC_hwModel) &&
+                           !(*wRC_strPort)) {
+                          fputs(WRC_MSG_WRPPAR, stderr);
+                          return EXIT_FAILURE;
+                       }
+   }
+   int wRC_exitCode = EXIT_SUCCESS;
+   size_t wRC_numTarg = 0;
+   B_board* wRC_boards = CST_PVOID;
+   E_target* wRC_targs = CST_PVOID;
+   if (wRC_iParColl[wRC_targ].wRC_fDef) {
+      if (!wRC_parseTargets(argv[wRC_iParColl[wRC_targ].wRC_idxPar] + wRC_iParColl[wRC_targ].wRC_posVal,
+                            wRC_behType == wRC_bConc,
+                            &wRC_numTarg,
+                            &wRC_boards,
+                            &wRC_targs)) {
+         wRC_exitCode = EXIT_FAILURE;
+         goto WRC_MAIN_EXIT;
+      }
+   }
+   else if (wRC_behType == wRC_bPulse ||
+            wRC_behType == wRC_bDaemon ||
+            wRC_behType == wRC_bCron) {
+      // a single array, described by --ipv4, --port and --model
+      wRC_numTarg = 1;
+      wRC_boards = calloc(1, sizeof(B_board));
+      if (!wRC_boards) {
+         fputs(WRC_MSG_HEAPMANFAIL, stderr);
+         wRC_exitCode = EXIT_FAILURE;
+         goto WRC_MAIN_EXIT;
+      }
+      if (B_initBoard(wRC_boards,
+                      wRC_szStrIPv4, wRC_strIPv4,
+                      wRC_szStrPort, wRC_strPort,
+                      wRC_hwModel)) {
+         fputs(WRC_MSG_WRPPAR, stderr);
+         wRC_exitCode = EXIT_FAILURE;
+         goto WRC_MAIN_EXIT;
+      }
+   }
+#ifndef WRC_NATIVE_HTTP
    if (curl_global_init(CURL_GLOBAL_NOTHING)) {
       fputs(WRC_MSG_UNSCINIT, stderr);
-      return EXIT_FAILURE;
+      wRC_exitCode = EXIT_FAILURE;
+      goto WRC_MAIN_EXIT;
    }
    wRC_supProt_t wRC_protInd = WRC_PROT_NONE;
    curl_version_info_data* wRC_pCurlInfo = curl_version_info(CURLVERSION_NOW);
@@ -249,19 +920,92 @@ int main(int argc, char* argv[])
          break;
       wRC_pStrArr_prot++;
    }
+   // the handles of the process share the cache of the resolved names, the TLS sessions and the
+   // connections (the controller performs every transfer within a single thread)
+   B_setTls(wRC_fTls,
+            wRC_pathCA);
+   if (!B_initShare(true)) {
+      fputs(WRC_MSG_UNSCINIT, stderr);
+      wRC_exitCode = EXIT_FAILURE;
+      goto WRC_MAIN_CLEANUP;
+   }
+   if (wRC_opts.rC_fPreRes &&
+       wRC_numTarg)
+      rC_preResolve(wRC_numTarg, wRC_boards,
+                    &wRC_opts);
    if (wRC_protInd == WRC_PROT_VALID) {
-      if (!wRC_fBeh)
-         rC_doSingleOperation(wRC_szStrIPv4, wRC_strIPv4,
-                              wRC_szStrPort, wRC_strPort,
-                              wRC_strMnemCd,
-                              wRC_hwModel);
-      else
-         rC_doMultipleOperations(wRC_szStrIPv4, wRC_strIPv4,
-                                 wRC_szStrPort, wRC_strPort,
-                                 wRC_hwModel);
+#endif
+      switch (wRC_behType) {
+         case wRC_bSingle: if (wRC_iParColl[wRC_mask].wRC_fDef) {
+                              if (rC_doMaskOperation(wRC_szStrIPv4, wRC_strIPv4,
+                                                     wRC_szStrPort, wRC_strPort,
+                                                     wRC_hwModel,
+                                                     wRC_statMask,
+                                                     &wRC_opts))
+                                 wRC_exitCode = EXIT_FAILURE;
+                           }
+                           else if (rC_doSingleOperation(wRC_szStrIPv4, wRC_strIPv4,
+                                                         wRC_szStrPort, wRC_strPort,
+                                                         wRC_numMnemCd,
+                                                         wRC_strMnemCds,
+                                                         wRC_hwModel,
+                                                         &wRC_opts))
+                              wRC_exitCode = EXIT_FAILURE;
+                           break;
+         case   wRC_bIter: if (rC_doMultipleOperations(wRC_szStrIPv4, wRC_strIPv4,
+                                                       wRC_szStrPort, wRC_strPort,
+                                                       wRC_hwModel,
+                                                       &wRC_opts))
+                              wRC_exitCode = EXIT_FAILURE;
+                           break;
+#ifdef WRC_NATIVE_HTTP
+         default:          break; // rejected along with the parameters
+#else
+         case   wRC_bConc: if (rC_doConcurrentOperations(wRC_numTarg, wRC_targs,
+                                                         wRC_maxInFlight,
+                                                         &wRC_opts))
+                              wRC_exitCode = EXIT_FAILURE;
+                           break;
+         case  wRC_bPulse: // a relay may have been left on: a failure is reported by the exit status
+                           if (rC_doPulseOperations(wRC_numTarg, wRC_boards,
+                                                    wRC_numPulse, wRC_pulses,
+                                                    wRC_maxInFlight,
+                                                    &wRC_opts))
+                              wRC_exitCode = EXIT_FAILURE;
+                           break;
+         case  wRC_bBatch: // the scripts are generated by other tools: a failure is reported by the exit status
+                           if (rC_doBatchOperations(wRC_szStrIPv4, wRC_strIPv4,
+                                                    wRC_szStrPort, wRC_strPort,
+                                                    wRC_hwModel,
+                                                    wRC_pathScript,
+                                                    wRC_pathGroups,
+                                                    wRC_maxInFlight,
+                                                    &wRC_opts))
+                              wRC_exitCode = EXIT_FAILURE;
+                           break;
+         case wRC_bDaemon: if (rC_doDaemonOperations(wRC_numTarg, wRC_boards,
+                                                     wRC_pathSock,
+                                                     wRC_maxInFlight,
+                                                     &wRC_opts))
+                              wRC_exitCode = EXIT_FAILURE;
+                           break;
+         case   wRC_bCron: if (rC_doCronOperations(wRC_numTarg, wRC_boards,
+                                                   wRC_pathSched,
+                                                   wRC_maxInFlight,
+                                                   &wRC_opts))
+                              wRC_exitCode = EXIT_FAILURE;
+#endif
+      }
+#ifndef WRC_NATIVE_HTTP
    }
    else
       fputs(WRC_MSG_HLPROT, stderr);
+   B_cleanupShare();
+   WRC_MAIN_CLEANUP:
    curl_global_cleanup();
-   return EXIT_SUCCESS;
+#endif
+   WRC_MAIN_EXIT:
+   free(wRC_targs);
+   free(wRC_boards);
+   return wRC_exitCode;
 }
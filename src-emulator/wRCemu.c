@@ -0,0 +1,604 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+// an emulator of the web relay arrays supported by the controller. It serves the URL scheme used
+// by the controller and keeps the status of eight relays:
+// - /FF0<relay-ID>0<0|1>, /FFE0<mask> and /relays.cgi (KMTronic);
+// - /<port>/<code> and /<port>/ (NC800);
+// the latency, the jitter and the size of each response, the probability of a connection drop and
+// the maximum number of simultaneous connections are configurable
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "sched.h"
+#include "constants.h"
+#include "err_wrapper.h"
+
+// input parameter keys
+#define WRE_HELP_KEY     "--help"
+#define WRE_LISTEN_KEY   "--listen"
+#define WRE_TCPPORT_KEY  "--tcp-port"
+#define WRE_LAT_KEY      "--latency"
+#define WRE_JIT_KEY      "--jitter"
+#define WRE_PGSZ_KEY     "--page-size"
+#define WRE_DROP_KEY     "--drop"
+#define WRE_MAXCONN_KEY  "--max-connections"
+#define WRE_SEED_KEY     "--seed"
+#define WRE_IDLE_KEY     "--idle-timeout"
+// generic macros
+#define WRE_SZIN          4096U   // size of the input buffer of a connection
+#define WRE_DEF_MAXCONN     64U   // default maximum number of simultaneous connections
+#define WRE_MAX_MAXCONN   1024U   // upper bound of the maximum number of simultaneous connections
+#define WRE_MAX_PGSZ      (64UL * 1024UL * 1024UL)  // maximum size of a page
+#define WRE_MAXWAIT       1000    // maximum time (milliseconds) spent waiting by the event loop
+#define WRE_NUMREL           8U   // number of relays
+#define WRE_BACKLOG         64    // backlog of the listening socket
+#define WRE_DEF_IDLE      5000UL  // default time (milliseconds) after which an idle connection is closed
+
+#define WRE_FILLER  "<p>this line only enlarges the page of the emulated web relay array</p>\n"
+
+enum wRE_pages {wRE_pgKMTronic,  /**< the status page of the KMTronic */
+                wRE_pgNC800,     /**< the main page of the NC800 */
+                wRE_pgNotFound   /**< an unknown URL */
+               };
+
+// a connection with a client
+typedef struct wRE_conn {
+// socket (-1 if the slot is free or the connection has been closed)
+   int wRE_fd;
+// a request is waiting for its response to be due (the slot cannot be reused until then)
+   bool wRE_fBusy;
+// the connection is closed once the response has been sent
+   bool wRE_fClose;
+// bytes received but not yet processed
+   char wRE_in[WRE_SZIN];
+   size_t wRE_lenIn;
+// path of the pending request (null-terminated)
+   char wRE_path[64];
+// response that is being sent
+   char* wRE_out;
+   size_t wRE_lenOut;
+   size_t wRE_posOut;
+// instant (monotonic clock) of the last activity
+   uint64_t wRE_tLast;
+} wRE_conn;
+
+// the configuration of the emulator
+typedef struct wRE_cfg {
+   struct in_addr wRE_addr;
+   unsigned short wRE_tcpPort;
+// milliseconds
+   unsigned long wRE_latency;
+   unsigned long wRE_jitter;
+// minimum size (bytes) of a page
+   unsigned long wRE_pgSz;
+// probability (percentage) that a request is answered by closing the connection
+   unsigned wRE_drop;
+   unsigned wRE_maxConn;
+   unsigned wRE_seed;
+// time (milliseconds) after which an idle connection is closed (zero if it is never closed)
+   unsigned long wRE_idle;
+} wRE_cfg;
+
+// counters reported at exit
+typedef struct wRE_stats {
+   unsigned long wRE_numConn;
+   unsigned long wRE_numReq;
+   unsigned long wRE_numDrop;
+   unsigned long wRE_numNotFound;
+} wRE_stats;
+
+static volatile sig_atomic_t wRE_fStop = 0;
+// status of the relays (the first element describes relay 1)
+static bool wRE_relays[WRE_NUMREL] = {false};
+
+static void wRE_onSignal(int wRE_sig)
+{
+   wRE_fStop = 1;
+}
+
+static void wRE_usage(void)
+{
+   fputs("wRCemu [--listen=<address>] [--tcp-port=<port>] [--latency=<milliseconds>] [--jitter=<milliseconds>]\n\
+              [--page-size=<bytes>] [--drop=<percentage>] [--max-connections=<number>]\n\
+              [--idle-timeout=<milliseconds>] [--seed=<number>]\n\
+          wRCemu --help\n\
+          --listen is the IPv4 address the emulator listens on (127.0.0.1 by default);\n\
+          --tcp-port is the TCP port the emulator listens on (80 by default, as the controller does\n\
+          not specify any port within its URLs);\n\
+          --latency is the time waited before answering a request (0 by default);\n\
+          --jitter is the upper bound of a random delay added to the latency (0 by default);\n\
+          --page-size is the minimum size of a page (the description of the relays lies in its middle);\n\
+          --drop is the probability (in the interval [0, 100]) that a request is answered by closing\n\
+          the connection;\n\
+          --max-connections is the maximum number of simultaneous connections (the other ones wait\n\
+          within the backlog). A real array serves a single connection at a time (use 1);\n\
+          --idle-timeout is the time after which a kept-alive connection without requests is closed\n\
+          (5000 by default, 0 disables it);\n\
+          --seed initializes the pseudo-random generator;\n\
+          the emulator serves both models at once and keeps the status of eight relays. The counters\n\
+          of the served requests are printed once SIGINT or SIGTERM are received\n", stdout);
+}
+
+// parses an unsigned decimal value that does not exceed wRE_max
+static bool wRE_parseNum(const char* const wRE_strVal,
+                         unsigned long wRE_max,
+                         unsigned long* restrict wRE_pVal)
+{
+   const size_t wRE_lenVal = strlen(wRE_strVal);
+   if (!wRE_lenVal ||
+       wRE_lenVal > 9 ||
+       strspn(wRE_strVal, "0123456789") != wRE_lenVal)
+      return false;
+   *wRE_pVal = strtoul(wRE_strVal, 0, 10);
+   return *wRE_pVal <= wRE_max;
+}
+
+static bool wRE_parseArgs(int argc, char* argv[],
+                          wRE_cfg* restrict wRE_pCfg)
+{
+   wRE_pCfg -> wRE_addr.s_addr = htonl(INADDR_LOOPBACK);
+   wRE_pCfg -> wRE_tcpPort = 80;
+   wRE_pCfg -> wRE_maxConn = WRE_DEF_MAXCONN;
+   wRE_pCfg -> wRE_seed = (unsigned) time(CST_PVOID);
+   wRE_pCfg -> wRE_idle = WRE_DEF_IDLE;
+   for (int i = 1; i < argc; i++) {
+      const size_t wRE_lenKey = strcspn(argv[i], "=");
+      const char* wRE_pVal = argv[i] + wRE_lenKey;
+      if (*wRE_pVal)
+         wRE_pVal++;
+      unsigned long wRE_val = 0;
+      if (wRE_lenKey == strlen(WRE_LISTEN_KEY) &&
+          !strncmp(argv[i], WRE_LISTEN_KEY, wRE_lenKey)) {
+         if (inet_pton(AF_INET, wRE_pVal, &(wRE_pCfg -> wRE_addr)) != 1)
+            return false;
+         continue;
+      }
+      if (wRE_lenKey == strlen(WRE_TCPPORT_KEY) &&
+          !strncmp(argv[i], WRE_TCPPORT_KEY, wRE_lenKey) &&
+          wRE_parseNum(wRE_pVal, 65535, &wRE_val) &&
+          wRE_val)
+         wRE_pCfg -> wRE_tcpPort = (unsigned short) wRE_val;
+      else if (wRE_lenKey == strlen(WRE_LAT_KEY) &&
+               !strncmp(argv[i], WRE_LAT_KEY, wRE_lenKey) &&
+               wRE_parseNum(wRE_pVal, 3600000UL, &wRE_val))
+         wRE_pCfg -> wRE_latency = wRE_val;
+      else if (wRE_lenKey == strlen(WRE_JIT_KEY) &&
+               !strncmp(argv[i], WRE_JIT_KEY, wRE_lenKey) &&
+               wRE_parseNum(wRE_pVal, 3600000UL, &wRE_val))
+         wRE_pCfg -> wRE_jitter = wRE_val;
+      else if (wRE_lenKey == strlen(WRE_PGSZ_KEY) &&
+               !strncmp(argv[i], WRE_PGSZ_KEY, wRE_lenKey) &&
+               wRE_parseNum(wRE_pVal, WRE_MAX_PGSZ, &wRE_val))
+         wRE_pCfg -> wRE_pgSz = wRE_val;
+      else if (wRE_lenKey == strlen(WRE_DROP_KEY) &&
+               !strncmp(argv[i], WRE_DROP_KEY, wRE_lenKey) &&
+               wRE_parseNum(wRE_pVal, 100, &wRE_val))
+         wRE_pCfg -> wRE_drop = (unsigned) wRE_val;
+      else if (wRE_lenKey == strlen(WRE_MAXCONN_KEY) &&
+               !strncmp(argv[i], WRE_MAXCONN_KEY, wRE_lenKey) &&
+               wRE_parseNum(wRE_pVal, WRE_MAX_MAXCONN, &wRE_val) &&
+               wRE_val)
+         wRE_pCfg -> wRE_maxConn = (unsigned) wRE_val;
+      else if (wRE_lenKey == strlen(WRE_SEED_KEY) &&
+               !strncmp(argv[i], WRE_SEED_KEY, wRE_lenKey) &&
+               wRE_parseNum(wRE_pVal, 999999999UL, &wRE_val))
+         wRE_pCfg -> wRE_seed = (unsigned) wRE_val;
+      else if (wRE_lenKey == strlen(WRE_IDLE_KEY) &&
+               !strncmp(argv[i], WRE_IDLE_KEY, wRE_lenKey) &&
+               wRE_parseNum(wRE_pVal, 3600000UL, &wRE_val))
+         wRE_pCfg -> wRE_idle = wRE_val;
+      else
+         return false;
+   }
+   return true;
+}
+
+// applies the command conveyed by a path and selects the page of the response
+static enum wRE_pages wRE_route(const char* const wRE_path)
+{
+   const size_t wRE_lenPath = strlen(wRE_path);
+   // KMTronic: /FF0<relay-ID>0<0|1> or /relays.cgi
+   if (wRE_lenPath == 7 &&
+       !strncmp(wRE_path, "/FF0", 4) &&
+       wRE_path[4] >= '1' && wRE_path[4] <= '8' &&
+       wRE_path[5] == '0' &&
+       (wRE_path[6] == '0' || wRE_path[6] == '1')) {
+      wRE_relays[wRE_path[4] - '1'] = wRE_path[6] == '1';
+      return wRE_pgKMTronic;
+   }
+   // KMTronic: /FFE0<mask> sets every relay at once (<mask> is a two-digit hexadecimal number whose
+   // least significant bit stands for relay 1)
+   if (wRE_lenPath == 7 &&
+       !strncmp(wRE_path, "/FFE0", 5) &&
+       isxdigit(wRE_path[5]) &&
+       isxdigit(wRE_path[6])) {
+      const unsigned long wRE_mask = strtoul(wRE_path + 5, CST_PVOID, 16);
+      for (unsigned i = 0; i < WRE_NUMREL; i++)
+         wRE_relays[i] = (wRE_mask >> i) & 1U;
+      return wRE_pgKMTronic;
+   }
+   if (!strcmp(wRE_path, "/relays.cgi"))
+      return wRE_pgKMTronic;
+   // NC800: /<port>/ or /<port>/<code> where <code> belongs to [00, 15]
+   const size_t wRE_lenPort = strspn(wRE_path + 1, "0123456789");
+   if (wRE_path[0] != '/' ||
+       !wRE_lenPort ||
+       wRE_path[1 + wRE_lenPort] != '/')
+      return wRE_pgNotFound;
+   const char* wRE_pCode = wRE_path + 2 + wRE_lenPort;
+   if (!(*wRE_pCode))
+      return wRE_pgNC800;
+   if (strlen(wRE_pCode) != 2 ||
+       !isdigit(wRE_pCode[0]) ||
+       !isdigit(wRE_pCode[1]))
+      return wRE_pgNotFound;
+   const unsigned wRE_code = 10 * (wRE_pCode[0] - '0') + (wRE_pCode[1] - '0');
+   if (wRE_code > 15)
+      return wRE_pgNotFound;
+   wRE_relays[wRE_code / 2] = wRE_code % 2;
+   return wRE_pgNC800;
+}
+
+// appends filler lines until a page holds at least wRE_upTo bytes
+static size_t wRE_fill(char* wRE_page, size_t wRE_len, size_t wRE_upTo)
+{
+   const size_t wRE_lenFill = sizeof(WRE_FILLER) - 1;
+   while (wRE_len < wRE_upTo) {
+      memcpy(wRE_page + wRE_len, WRE_FILLER, wRE_lenFill);
+      wRE_len += wRE_lenFill;
+   }
+   return wRE_len;
+}
+
+// composes the whole response (header and page) of a request on the heap
+static char* wRE_respond(enum wRE_pages wRE_page,
+                         const wRE_cfg* restrict wRE_pCfg,
+                         bool wRE_fClose,
+                         size_t* restrict wRE_pLenResp)
+{
+   const size_t wRE_szBody = wRE_pCfg -> wRE_pgSz + 2 * (sizeof(WRE_FILLER) - 1) + 1024U;
+   char* wRE_body = malloc(wRE_szBody);
+   char* wRE_resp = malloc(wRE_szBody + 256U);
+   if (!wRE_body ||
+       !wRE_resp) {
+      free(wRE_body);
+      free(wRE_resp);
+      return CST_PVOID;
+   }
+   size_t wRE_lenBody = 0;
+   const char* wRE_strCode = "200 OK";
+   switch (wRE_page) {
+      case wRE_pgKMTronic: wRE_lenBody = sprintf(wRE_body, "<html><head><title>KMTronic</title></head><body>\n");
+                           wRE_lenBody = wRE_fill(wRE_body, wRE_lenBody, wRE_pCfg -> wRE_pgSz / 2);
+                           wRE_lenBody += sprintf(wRE_body + wRE_lenBody, "Status:");
+                           for (unsigned i = 0; i < WRE_NUMREL; i++)
+                              wRE_lenBody += sprintf(wRE_body + wRE_lenBody, " %d", wRE_relays[i] ? 1
+                                                                                                  : 0);
+                           wRE_lenBody += sprintf(wRE_body + wRE_lenBody, "\n");
+                           break;
+      case wRE_pgNC800:    wRE_lenBody = sprintf(wRE_body, "<html><head><title>NC800</title></head><body><table>\n");
+                           wRE_lenBody = wRE_fill(wRE_body, wRE_lenBody, wRE_pCfg -> wRE_pgSz / 2);
+                           for (unsigned i = 0; i < WRE_NUMREL; i++)
+                              wRE_lenBody += sprintf(wRE_body + wRE_lenBody, "<tr><td>Relay-0%u</td><td bgcolor=\"#%s\">%s</td></tr>\n",
+                                                     i + 1, wRE_relays[i] ? "00FF00"
+                                                                          : "FF0000",
+                                                     wRE_relays[i] ? "ON"
+                                                                   : "OFF");
+                           wRE_lenBody += sprintf(wRE_body + wRE_lenBody, "</table>\n");
+                           break;
+      default:             wRE_strCode = "404 Not Found";
+                           wRE_lenBody = sprintf(wRE_body, "<html><body>not found</body></html>\n");
+   }
+   if (wRE_page != wRE_pgNotFound) {
+      wRE_lenBody = wRE_fill(wRE_body, wRE_lenBody, wRE_pCfg -> wRE_pgSz);
+      wRE_lenBody += sprintf(wRE_body + wRE_lenBody, "</body></html>\n");
+   }
+   const int wRE_lenHead = sprintf(wRE_resp, "HTTP/1.1 %s\r\nContent-Type: text/html\r\nContent-Length: %zu\r\nConnection: %s\r\n\r\n",
+                                   wRE_strCode, wRE_lenBody, wRE_fClose ? "close"
+                                                                        : "keep-alive");
+   memcpy(wRE_resp + wRE_lenHead, wRE_body, wRE_lenBody);
+   free(wRE_body);
+   *wRE_pLenResp = wRE_lenHead + wRE_lenBody;
+   return wRE_resp;
+}
+
+static void wRE_close(wRE_conn* restrict wRE_pConn)
+{
+   if (wRE_pConn -> wRE_fd >= 0)
+      close(wRE_pConn -> wRE_fd);
+   wRE_pConn -> wRE_fd = -1;
+   free(wRE_pConn -> wRE_out);
+   wRE_pConn -> wRE_out = CST_PVOID;
+   wRE_pConn -> wRE_lenOut = wRE_pConn -> wRE_posOut = 0;
+   wRE_pConn -> wRE_lenIn = 0;
+}
+
+// extracts the next complete request of a connection and schedules its response
+// returns false if the request is malformed
+static bool wRE_nextRequest(wRE_conn* restrict wRE_pConn,
+                            const wRE_cfg* restrict wRE_pCfg,
+                            S_heap* restrict wRE_pHeap)
+{
+   if (wRE_pConn -> wRE_fBusy ||
+       wRE_pConn -> wRE_out ||
+       wRE_pConn -> wRE_fd < 0)
+      return true;
+   wRE_pConn -> wRE_in[wRE_pConn -> wRE_lenIn] = '\0';
+   char* wRE_pEnd = strstr(wRE_pConn -> wRE_in, "\r\n\r\n");
+   if (!wRE_pEnd)
+      return wRE_pConn -> wRE_lenIn < WRE_SZIN - 1;
+   *wRE_pEnd = '\0';
+   // <method> <path> <version>
+   char* wRE_pPath = strchr(wRE_pConn -> wRE_in, ' ');
+   if (!wRE_pPath)
+      return false;
+   wRE_pPath++;
+   const size_t wRE_lenPath = strcspn(wRE_pPath, " \r\n");
+   if (!wRE_lenPath ||
+       wRE_lenPath >= sizeof(wRE_pConn -> wRE_path))
+      return false;
+   memcpy(wRE_pConn -> wRE_path, wRE_pPath, wRE_lenPath);
+   wRE_pConn -> wRE_path[wRE_lenPath] = '\0';
+   // HTTP/1.0 and "Connection: close" end the connection after the response
+   wRE_pConn -> wRE_fClose = strstr(wRE_pPath + wRE_lenPath, "HTTP/1.0") ||
+                             strstr(wRE_pPath + wRE_lenPath, "Connection: close") ||
+                             strstr(wRE_pPath + wRE_lenPath, "connection: close");
+   const size_t wRE_lenReq = wRE_pEnd + 4 - wRE_pConn -> wRE_in;
+   memmove(wRE_pConn -> wRE_in, wRE_pConn -> wRE_in + wRE_lenReq, wRE_pConn -> wRE_lenIn - wRE_lenReq);
+   wRE_pConn -> wRE_lenIn -= wRE_lenReq;
+   uint64_t wRE_delay = wRE_pCfg -> wRE_latency;
+   if (wRE_pCfg -> wRE_jitter)
+      wRE_delay += (uint64_t) rand() % (wRE_pCfg -> wRE_jitter + 1);
+   if (S_push(wRE_pHeap, S_now() + wRE_delay * S_NSPERMS, (void*) wRE_pConn))
+      return false;
+   wRE_pConn -> wRE_fBusy = true;
+   return true;
+}
+
+// a kept-alive connection that neither holds nor waits for a request
+static bool wRE_isIdle(const wRE_conn* restrict wRE_pConn)
+{
+   return wRE_pConn -> wRE_fd >= 0 &&
+          !(wRE_pConn -> wRE_fBusy) &&
+          !(wRE_pConn -> wRE_out) &&
+          !(wRE_pConn -> wRE_lenIn);
+}
+
+// sends as much of the pending response as possible
+static void wRE_send(wRE_conn* restrict wRE_pConn)
+{
+   while (wRE_pConn -> wRE_posOut < wRE_pConn -> wRE_lenOut) {
+      const ssize_t wRE_numSent = send(wRE_pConn -> wRE_fd,
+                                       wRE_pConn -> wRE_out + wRE_pConn -> wRE_posOut,
+                                       wRE_pConn -> wRE_lenOut - wRE_pConn -> wRE_posOut,
+                                       MSG_NOSIGNAL);
+      if (wRE_numSent < 0) {
+         if (errno != EAGAIN &&
+             errno != EWOULDBLOCK)
+            wRE_close(wRE_pConn);
+         return;
+      }
+      wRE_pConn -> wRE_posOut += wRE_numSent;
+   }
+   free(wRE_pConn -> wRE_out);
+   wRE_pConn -> wRE_out = CST_PVOID;
+   wRE_pConn -> wRE_lenOut = wRE_pConn -> wRE_posOut = 0;
+   if (wRE_pConn -> wRE_fClose)
+      wRE_close(wRE_pConn);
+}
+
+int main(int argc, char* argv[])
+{
+   wRE_cfg wRE_config = {0};
+   if (argc == 2 &&
+       !strcmp(argv[1], WRE_HELP_KEY)) {
+      wRE_usage();
+      return EXIT_SUCCESS;
+   }
+   if (!wRE_parseArgs(argc, argv, &wRE_config)) {
+      fputs(WRC_MSG_WRPPAR, stderr);
+      wRE_usage();
+      return EXIT_FAILURE;
+   }
+   srand(wRE_config.wRE_seed);
+   struct sigaction wRE_act;
+   memset(&wRE_act, 0, sizeof(wRE_act));
+   wRE_act.sa_handler = wRE_onSignal;
+   sigaction(SIGINT, &wRE_act, CST_PVOID);
+   sigaction(SIGTERM, &wRE_act, CST_PVOID);
+   int wRE_exitCode = EXIT_FAILURE;
+   wRE_stats wRE_counters = {0};
+   S_heap wRE_heap;
+   S_init(&wRE_heap);
+   wRE_conn* wRE_conns = calloc(wRE_config.wRE_maxConn, sizeof(wRE_conn));
+   struct pollfd* wRE_pfds = calloc(wRE_config.wRE_maxConn + 1, sizeof(struct pollfd));
+   // the connection of each polled descriptor (the first one is the listening socket)
+   wRE_conn** wRE_pfdConns = calloc(wRE_config.wRE_maxConn + 1, sizeof(wRE_conn*));
+   int wRE_lsn = -1;
+   if (!wRE_conns ||
+       !wRE_pfds ||
+       !wRE_pfdConns) {
+      fputs(WRC_MSG_HEAPMANFAIL, stderr);
+      goto WRE_MAIN_EXIT;
+   }
+   for (unsigned i = 0; i < wRE_config.wRE_maxConn; i++)
+      wRE_conns[i].wRE_fd = -1;
+   wRE_lsn = socket(AF_INET, SOCK_STREAM, 0);
+   const int wRE_optOn = 1;
+   struct sockaddr_in wRE_sa = {.sin_family = AF_INET,
+                                .sin_port = htons(wRE_config.wRE_tcpPort),
+                                .sin_addr = wRE_config.wRE_addr};
+   if (wRE_lsn < 0 ||
+       setsockopt(wRE_lsn, SOL_SOCKET, SO_REUSEADDR, &wRE_optOn, sizeof(wRE_optOn)) ||
+       bind(wRE_lsn, (struct sockaddr*) &wRE_sa, sizeof(wRE_sa)) ||
+       listen(wRE_lsn, WRE_BACKLOG) ||
+       fcntl(wRE_lsn, F_SETFL, O_NONBLOCK)) {
+      perror("[ERR] unable to listen");
+      goto WRE_MAIN_EXIT;
+   }
+   fprintf(stdout, "[INF] listening on %s:%u\n", inet_ntoa(wRE_config.wRE_addr), wRE_config.wRE_tcpPort);
+   fflush(stdout);
+   while (!wRE_fStop) {
+      // the listening socket is polled only if a slot is free (the other clients wait within the backlog)
+      nfds_t wRE_numPfds = 0;
+      unsigned wRE_numOpen = 0;
+      for (unsigned i = 0; i < wRE_config.wRE_maxConn; i++)
+         if (wRE_conns[i].wRE_fd >= 0 ||
+             wRE_conns[i].wRE_fBusy)
+            wRE_numOpen++;
+      if (wRE_numOpen < wRE_config.wRE_maxConn) {
+         wRE_pfds[wRE_numPfds].fd = wRE_lsn;
+         wRE_pfds[wRE_numPfds].events = POLLIN;
+         wRE_pfdConns[wRE_numPfds] = CST_PVOID;
+         wRE_numPfds++;
+      }
+      for (unsigned i = 0; i < wRE_config.wRE_maxConn; i++) {
+         wRE_conn* wRE_pConn = wRE_conns + i;
+         if (wRE_pConn -> wRE_fd < 0)
+            continue;
+         wRE_pfds[wRE_numPfds].fd = wRE_pConn -> wRE_fd;
+         // a full input buffer is not read until its content has been processed
+         if (wRE_pConn -> wRE_out)
+            wRE_pfds[wRE_numPfds].events = POLLOUT;
+         else
+            wRE_pfds[wRE_numPfds].events = wRE_pConn -> wRE_lenIn < WRE_SZIN - 1 ? POLLIN
+                                                                                : 0;
+         wRE_pfdConns[wRE_numPfds] = wRE_pConn;
+         wRE_numPfds++;
+      }
+      // the poll ends either when the earliest response is due or when the earliest idle connection expires
+      int wRE_wait = S_waitTime(&wRE_heap, WRE_MAXWAIT);
+      const uint64_t wRE_tPoll = S_now();
+      for (unsigned i = 0; wRE_config.wRE_idle && i < wRE_config.wRE_maxConn; i++) {
+         if (!wRE_isIdle(wRE_conns + i))
+            continue;
+         const uint64_t wRE_tExp = wRE_conns[i].wRE_tLast + wRE_config.wRE_idle * S_NSPERMS;
+         const int wRE_left = wRE_tExp <= wRE_tPoll ? 0
+                                                    : (int) ((wRE_tExp - wRE_tPoll + S_NSPERMS - 1) / S_NSPERMS);
+         if (wRE_left < wRE_wait)
+            wRE_wait = wRE_left;
+      }
+      const int wRE_numReady = poll(wRE_pfds, wRE_numPfds,
+                                    wRE_wait);
+      if (wRE_numReady < 0 &&
+          errno != EINTR) {
+         perror("[ERR] poll");
+         goto WRE_MAIN_EXIT;
+      }
+      for (nfds_t i = 0; wRE_numReady > 0 && i < wRE_numPfds; i++) {
+         if (!(wRE_pfds[i].revents))
+            continue;
+         wRE_conn* wRE_pConn = wRE_pfdConns[i];
+         if (wRE_pConn)
+            wRE_pConn -> wRE_tLast = S_now();
+         else {
+            // a new connection occupies a free slot
+            for (unsigned j = 0; j < wRE_config.wRE_maxConn; j++) {
+               wRE_conn* wRE_pFree = wRE_conns + j;
+               if (wRE_pFree -> wRE_fd >= 0 ||
+                   wRE_pFree -> wRE_fBusy)
+                  continue;
+               const int wRE_fd = accept(wRE_lsn, CST_PVOID, CST_PVOID);
+               if (wRE_fd >= 0) {
+                  fcntl(wRE_fd, F_SETFL, O_NONBLOCK);
+                  memset(wRE_pFree, 0, sizeof(wRE_conn));
+                  wRE_pFree -> wRE_fd = wRE_fd;
+                  wRE_pFree -> wRE_tLast = S_now();
+                  wRE_counters.wRE_numConn++;
+               }
+               break;
+            }
+            continue;
+         }
+         if (wRE_pfds[i].revents & POLLOUT) {
+            wRE_send(wRE_pConn);
+            if (!wRE_nextRequest(wRE_pConn, &wRE_config, &wRE_heap))
+               wRE_close(wRE_pConn);
+            continue;
+         }
+         const ssize_t wRE_numRecv = recv(wRE_pConn -> wRE_fd,
+                                          wRE_pConn -> wRE_in + wRE_pConn -> wRE_lenIn,
+                                          WRE_SZIN - 1 - wRE_pConn -> wRE_lenIn,
+                                          0);
+         if (wRE_numRecv <= 0) {
+            if (!wRE_numRecv ||
+                (errno != EAGAIN &&
+                 errno != EWOULDBLOCK))
+               wRE_close(wRE_pConn);
+            continue;
+         }
+         wRE_pConn -> wRE_lenIn += wRE_numRecv;
+         if (!wRE_nextRequest(wRE_pConn, &wRE_config, &wRE_heap))
+            wRE_close(wRE_pConn);
+      }
+      // the responses that are due
+      S_event wRE_evt;
+      const uint64_t wRE_now = S_now();
+      while (S_peek(&wRE_heap, &wRE_evt) &&
+             wRE_evt.s_deadline <= wRE_now) {
+         S_pop(&wRE_heap, CST_PVOID);
+         wRE_conn* wRE_pConn = (wRE_conn*) wRE_evt.s_pData;
+         wRE_pConn -> wRE_fBusy = false;
+         if (wRE_pConn -> wRE_fd < 0)
+            continue; // the client went away
+         wRE_counters.wRE_numReq++;
+         if (wRE_config.wRE_drop &&
+             (unsigned) (rand() % 100) < wRE_config.wRE_drop) {
+            wRE_counters.wRE_numDrop++;
+            wRE_close(wRE_pConn);
+            continue;
+         }
+         const enum wRE_pages wRE_page = wRE_route(wRE_pConn -> wRE_path);
+         if (wRE_page == wRE_pgNotFound)
+            wRE_counters.wRE_numNotFound++;
+         wRE_pConn -> wRE_out = wRE_respond(wRE_page,
+                                            &wRE_config,
+                                            wRE_pConn -> wRE_fClose,
+                                            &(wRE_pConn -> wRE_lenOut));
+         if (!(wRE_pConn -> wRE_out)) {
+            fputs(WRC_MSG_HEAPMANFAIL, stderr);
+            goto WRE_MAIN_EXIT;
+         }
+         wRE_send(wRE_pConn);
+         wRE_pConn -> wRE_tLast = S_now();
+         if (!wRE_nextRequest(wRE_pConn, &wRE_config, &wRE_heap))
+            wRE_close(wRE_pConn);
+      }
+      // closing the connections that have been idle for too long
+      const uint64_t wRE_tIdle = S_now();
+      for (unsigned i = 0; wRE_config.wRE_idle && i < wRE_config.wRE_maxConn; i++)
+         if (wRE_isIdle(wRE_conns + i) &&
+             wRE_tIdle - wRE_conns[i].wRE_tLast >= wRE_config.wRE_idle * S_NSPERMS)
+            wRE_close(wRE_conns + i);
+   }
+   fprintf(stdout, "[INF] %lu connection(s), %lu request(s), %lu dropped, %lu not found\n",
+           wRE_counters.wRE_numConn, wRE_counters.wRE_numReq,
+           wRE_counters.wRE_numDrop, wRE_counters.wRE_numNotFound);
+   wRE_exitCode = EXIT_SUCCESS;
+   WRE_MAIN_EXIT:
+   if (wRE_lsn >= 0)
+      close(wRE_lsn);
+   if (wRE_conns)
+      for (unsigned i = 0; i < wRE_config.wRE_maxConn; i++)
+         wRE_close(wRE_conns + i);
+   free(wRE_conns);
+   free(wRE_pfds);
+   free(wRE_pfdConns);
+   S_cleanup(&wRE_heap);
+   return wRE_exitCode;
+}
@@ -0,0 +1,583 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "http.h"
+#include "constants.h"
+
+#define H_MAXSZREQ    512U                 // maximum size of a request
+#define H_NOLIMIT     ((uint64_t) -1)      // an instant that is never reached
+#define H_USPERMS     1000ULL              // microseconds per millisecond
+#define H_EOL         "\r\n"
+#define H_EOH         "\r\n\r\n"
+
+// the framing of the body of a response
+enum h_framing {h_fr_length,   /**< Content-Length */
+                h_fr_chunked,  /**< Transfer-Encoding: chunked */
+                h_fr_close     /**< the end of the connection */
+               };
+
+// a request in progress
+typedef struct h_xfer {
+   H_conn* h_pConn;
+// instant (microseconds of the monotonic clock) at which the request began and at which it expires
+   uint64_t h_tStart;
+   uint64_t h_deadline;
+// maximum time (milliseconds) spent waiting for data (zero if there is no such limit)
+   unsigned long h_idle;
+// a byte of the response has been received
+   bool h_fRecv;
+   H_times* h_pTimes;
+} h_xfer;
+
+// current instant (microseconds) of the monotonic clock
+static uint64_t h_now(void);
+// waits until a socket is ready (1), the time is over (0) or an error occurs (-1)
+static int h_wait(int h_fd,
+                  short h_events,
+                  uint64_t h_deadline,
+                  unsigned long h_idle);
+// opens a connection towards a host (the brackets of an IPv6 address are included)
+static CURLcode h_connect(h_xfer* restrict h_pXfer,
+                          size_t h_lenHost, const char* h_strHost,
+                          unsigned long h_connTimeout);
+// sends the whole request
+static CURLcode h_send(const h_xfer* restrict h_pXfer,
+                       size_t h_len, const char* h_buf);
+// receives more bytes of the response (*h_pfEof is set if the array closed the connection)
+static CURLcode h_fill(h_xfer* restrict h_pXfer,
+                       bool* restrict h_pfEof);
+// looks for the end of a line (or of the header) among the bytes that have not been consumed
+static const char* h_find(const H_conn* restrict h_pConn,
+                          const char* const h_marker);
+// a header value holds a token (the case is ignored)
+static bool h_holds(const char* h_strVal,
+                    const char* const h_token);
+// receives and parses the header of a response
+static CURLcode h_readHead(h_xfer* restrict h_pXfer,
+                           long* restrict h_pResCode,
+                           enum h_framing* restrict h_pFraming,
+                           long long* restrict h_pLenCont,
+                           bool* restrict h_pfKeep);
+// receives the body of a response and delivers it to the sink
+static CURLcode h_readBody(h_xfer* restrict h_pXfer,
+                           enum h_framing h_framing,
+                           long long h_lenCont,
+                           H_sink h_sink,
+                           void* h_uD);
+
+void H_init(H_conn* restrict h_pConn)
+{
+   memset(h_pConn, 0, sizeof(H_conn));
+   h_pConn -> h_fd = -1;
+}
+
+CURLcode H_get(H_conn* restrict h_pConn,
+               const char* const h_strUrl,
+               const H_limits* restrict h_pLimits,
+               H_sink h_sink,
+               void* h_uD,
+               long* restrict h_pResCode,
+               H_times* restrict h_pTimes)
+{
+   memset(h_pTimes, 0, sizeof(H_times));
+   *h_pResCode = 0;
+   h_xfer h_xf = {.h_pConn = h_pConn,
+                  .h_tStart = h_now(),
+                  .h_deadline = H_NOLIMIT,
+                  .h_idle = h_pLimits -> h_idleTimeout,
+                  .h_fRecv = false,
+                  .h_pTimes = h_pTimes};
+   if (h_pLimits -> h_timeout)
+      h_xf.h_deadline = h_xf.h_tStart + h_pLimits -> h_timeout * H_USPERMS;
+   // <host>/<path>: the path of an IPv6 address follows its closing bracket
+   const char* h_strPath = h_strUrl;
+   if (*h_strPath == '[')
+      h_strPath = strchr(h_strPath, ']');
+   h_strPath = h_strPath ? strchr(h_strPath, '/')
+                         : CST_PVOID;
+   const size_t h_lenHost = h_strPath ? (size_t) (h_strPath - h_strUrl)
+                                      : strlen(h_strUrl);
+   if (!h_lenHost ||
+       h_lenHost >= H_MAXSZHOST)
+      return CURLE_URL_MALFORMAT;
+   char h_req[H_MAXSZREQ];
+   const int h_lenReq = snprintf(h_req, sizeof(h_req), "GET %s HTTP/1.1" H_EOL "Host: %.*s" H_EOL "Accept: */*" H_EOL H_EOL,
+                                 h_strPath ? h_strPath : "/", (int) h_lenHost, h_strUrl);
+   if (h_lenReq < 0 ||
+       (size_t) h_lenReq >= sizeof(h_req))
+      return CURLE_URL_MALFORMAT;
+   // a kept-alive connection is reused only towards the same host and only if the array has not
+   // closed it (nothing can be read from an idle connection)
+   if (h_pConn -> h_fd >= 0 &&
+       (strlen(h_pConn -> h_host) != h_lenHost ||
+        memcmp(h_pConn -> h_host, h_strUrl, h_lenHost) ||
+        h_wait(h_pConn -> h_fd, POLLIN, h_now(), 0)))
+      H_close(h_pConn);
+   CURLcode h_libCode = CURLE_OK;
+   long h_resCode = 0;
+   enum h_framing h_framing = h_fr_close;
+   long long h_lenCont = -1;
+   bool h_fKeep = false;
+   for (unsigned h_numTry = 0; ; h_numTry++) {
+      const bool h_fReused = h_pConn -> h_fd >= 0;
+      if (!h_fReused) {
+         h_libCode = h_connect(&h_xf,
+                               h_lenHost, h_strUrl,
+                               h_pLimits -> h_connTimeout);
+         if (h_libCode)
+            break;
+         h_pTimes -> h_fNewConn = true;
+      }
+      h_pConn -> h_pos = 0;
+      h_pConn -> h_len = 0;
+      h_libCode = h_send(&h_xf,
+                         (size_t) h_lenReq, h_req);
+      if (!h_libCode)
+         h_libCode = h_readHead(&h_xf,
+                                &h_resCode,
+                                &h_framing,
+                                &h_lenCont,
+                                &h_fKeep);
+      // the array may have closed the kept-alive connection while the request was being sent
+      if (h_libCode &&
+          h_fReused &&
+          !h_numTry &&
+          !(h_xf.h_fRecv) &&
+          (h_libCode == CURLE_SEND_ERROR ||
+           h_libCode == CURLE_RECV_ERROR ||
+           h_libCode == CURLE_GOT_NOTHING)) {
+         H_close(h_pConn);
+         continue;
+      }
+      break;
+   }
+   if (!h_libCode) {
+      *h_pResCode = h_resCode;
+      h_libCode = h_readBody(&h_xf,
+                             h_framing,
+                             h_lenCont,
+                             h_sink,
+                             h_uD);
+   }
+   // a connection is kept only once a whole response, and nothing more, has been received
+   if (h_libCode ||
+       !h_fKeep ||
+       h_framing == h_fr_close ||
+       h_pConn -> h_pos != h_pConn -> h_len)
+      H_close(h_pConn);
+   h_pTimes -> h_totTime = (long long) (h_now() - h_xf.h_tStart);
+   return h_libCode;
+}
+
+void H_close(H_conn* restrict h_pConn)
+{
+   if (h_pConn -> h_fd < 0)
+      return;
+   close(h_pConn -> h_fd);
+   h_pConn -> h_fd = -1;
+   h_pConn -> h_host[0] = '\0';
+   h_pConn -> h_pos = 0;
+   h_pConn -> h_len = 0;
+}
+
+static uint64_t h_now(void)
+{
+   struct timespec h_ts;
+   clock_gettime(CLOCK_MONOTONIC, &h_ts);
+   return (uint64_t) h_ts.tv_sec * 1000000ULL + (uint64_t) h_ts.tv_nsec / 1000ULL;
+}
+
+static int h_wait(int h_fd,
+                  short h_events,
+                  uint64_t h_deadline,
+                  unsigned long h_idle)
+{
+   struct pollfd h_pfd = {.fd = h_fd, .events = h_events, .revents = 0};
+   while (true) {
+      // the timeout is rounded up, so that the deadline is not missed by less than a millisecond
+      const uint64_t h_curr = h_now();
+      uint64_t h_timeout = h_deadline == H_NOLIMIT ? (uint64_t) -1
+                                                   : (h_deadline > h_curr ? (h_deadline - h_curr + H_USPERMS - 1) / H_USPERMS
+                                                                          : 0);
+      if (h_idle &&
+          h_idle < h_timeout)
+         h_timeout = h_idle;
+      const int h_numReady = poll(&h_pfd, 1, h_timeout > (uint64_t) INT32_MAX ? -1
+                                                                             : (int) h_timeout);
+      if (h_numReady >= 0)
+         return h_numReady;
+      if (errno != EINTR)
+         return -1;
+   }
+}
+
+static CURLcode h_connect(h_xfer* restrict h_pXfer,
+                          size_t h_lenHost, const char* h_strHost,
+                          unsigned long h_connTimeout)
+{
+   H_conn* h_pConn = h_pXfer -> h_pConn;
+   // the brackets of an IPv6 address are not part of the address
+   char h_strAddr[H_MAXSZHOST] = {0};
+   const bool h_fIPv6 = *h_strHost == '[';
+   if (h_fIPv6)
+      memcpy(h_strAddr, h_strHost + 1, h_lenHost > 2 ? h_lenHost - 2
+                                                     : 0);
+   else
+      memcpy(h_strAddr, h_strHost, h_lenHost);
+   // an address is converted without resorting to the resolver
+   struct addrinfo h_hints = {0};
+   h_hints.ai_family = AF_UNSPEC;
+   h_hints.ai_socktype = SOCK_STREAM;
+   h_hints.ai_flags = (h_fIPv6 ||
+                       strspn(h_strAddr, "0123456789.") == strlen(h_strAddr)) ? AI_NUMERICHOST
+                                                                               : 0;
+   struct addrinfo* h_pAddrs = CST_PVOID;
+   if (getaddrinfo(h_strAddr, H_PORT, &h_hints, &h_pAddrs))
+      return CURLE_COULDNT_RESOLVE_HOST;
+   const uint64_t h_tLookup = h_now();
+   h_pXfer -> h_pTimes -> h_lookupTime = (long long) (h_tLookup - h_pXfer -> h_tStart);
+   uint64_t h_deadline = h_pXfer -> h_deadline;
+   if (h_connTimeout &&
+       h_tLookup + h_connTimeout * H_USPERMS < h_deadline)
+      h_deadline = h_tLookup + h_connTimeout * H_USPERMS;
+   CURLcode h_libCode = CURLE_COULDNT_CONNECT;
+   for (const struct addrinfo* h_pCurr = h_pAddrs; h_pCurr; h_pCurr = h_pCurr -> ai_next) {
+      const int h_fd = socket(h_pCurr -> ai_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+      if (h_fd < 0)
+         continue;
+      int h_sockErr = 0;
+      socklen_t h_szErr = sizeof(h_sockErr);
+      if (connect(h_fd, h_pCurr -> ai_addr, h_pCurr -> ai_addrlen) &&
+          errno != EINPROGRESS)
+         h_sockErr = errno;
+      else {
+         const int h_numReady = h_wait(h_fd, POLLOUT, h_deadline, 0);
+         if (!h_numReady) {
+            close(h_fd);
+            h_libCode = CURLE_OPERATION_TIMEDOUT;
+            break;
+         }
+         if (h_numReady < 0 ||
+             getsockopt(h_fd, SOL_SOCKET, SO_ERROR, &h_sockErr, &h_szErr))
+            h_sockErr = errno;
+      }
+      if (h_sockErr) {
+         close(h_fd);
+         continue;
+      }
+      // the requests are small: they are not delayed
+      const int h_fOn = 1;
+      setsockopt(h_fd, IPPROTO_TCP, TCP_NODELAY, &h_fOn, sizeof(h_fOn));
+      h_pConn -> h_fd = h_fd;
+      memcpy(h_pConn -> h_host, h_strHost, h_lenHost);
+      h_pConn -> h_host[h_lenHost] = '\0';
+      h_libCode = CURLE_OK;
+      break;
+   }
+   freeaddrinfo(h_pAddrs);
+   h_pXfer -> h_pTimes -> h_connTime = (long long) (h_now() - h_pXfer -> h_tStart);
+   return h_libCode;
+}
+
+static CURLcode h_send(const h_xfer* restrict h_pXfer,
+                       size_t h_len, const char* h_buf)
+{
+   const int h_fd = h_pXfer -> h_pConn -> h_fd;
+   size_t h_numSent = 0;
+   while (h_numSent < h_len) {
+      const ssize_t h_num = send(h_fd, h_buf + h_numSent, h_len - h_numSent, MSG_NOSIGNAL);
+      if (h_num >= 0) {
+         h_numSent += (size_t) h_num;
+         continue;
+      }
+      if (errno == EINTR)
+         continue;
+      if (errno != EAGAIN &&
+          errno != EWOULDBLOCK)
+         return CURLE_SEND_ERROR;
+      const int h_numReady = h_wait(h_fd, POLLOUT, h_pXfer -> h_deadline, h_pXfer -> h_idle);
+      if (!h_numReady)
+         return CURLE_OPERATION_TIMEDOUT;
+      if (h_numReady < 0)
+         return CURLE_SEND_ERROR;
+   }
+   return CURLE_OK;
+}
+
+static CURLcode h_fill(h_xfer* restrict h_pXfer,
+                       bool* restrict h_pfEof)
+{
+   H_conn* h_pConn = h_pXfer -> h_pConn;
+   *h_pfEof = false;
+   // the bytes that have not been consumed are moved to the beginning of the buffer
+   if (h_pConn -> h_pos) {
+      memmove(h_pConn -> h_buf, h_pConn -> h_buf + h_pConn -> h_pos, h_pConn -> h_len - h_pConn -> h_pos);
+      h_pConn -> h_len -= h_pConn -> h_pos;
+      h_pConn -> h_pos = 0;
+   }
+   // a line (or the header) that does not fit within the buffer
+   if (h_pConn -> h_len == H_SZBUF)
+      return CURLE_WEIRD_SERVER_REPLY;
+   while (true) {
+      const ssize_t h_num = recv(h_pConn -> h_fd, h_pConn -> h_buf + h_pConn -> h_len, H_SZBUF - h_pConn -> h_len, 0);
+      if (h_num > 0) {
+         if (!(h_pXfer -> h_fRecv)) {
+            h_pXfer -> h_fRecv = true;
+            h_pXfer -> h_pTimes -> h_ttfbTime = (long long) (h_now() - h_pXfer -> h_tStart);
+         }
+         h_pConn -> h_len += (size_t) h_num;
+         return CURLE_OK;
+      }
+      if (!h_num) {
+         *h_pfEof = true;
+         return CURLE_OK;
+      }
+      if (errno == EINTR)
+         continue;
+      if (errno != EAGAIN &&
+          errno != EWOULDBLOCK)
+         return CURLE_RECV_ERROR;
+      const int h_numReady = h_wait(h_pConn -> h_fd, POLLIN, h_pXfer -> h_deadline, h_pXfer -> h_idle);
+      if (!h_numReady)
+         return CURLE_OPERATION_TIMEDOUT;
+      if (h_numReady < 0)
+         return CURLE_RECV_ERROR;
+   }
+}
+
+static const char* h_find(const H_conn* restrict h_pConn,
+                          const char* const h_marker)
+{
+   const size_t h_lenMarker = strlen(h_marker);
+   const char* h_pEnd = h_pConn -> h_buf + h_pConn -> h_len;
+   for (const char* h_pCurr = h_pConn -> h_buf + h_pConn -> h_pos; h_pCurr + h_lenMarker <= h_pEnd; h_pCurr++) {
+      h_pCurr = memchr(h_pCurr, *h_marker, (size_t) (h_pEnd - h_pCurr));
+      if (!h_pCurr ||
+          h_pCurr + h_lenMarker > h_pEnd)
+         return CST_PVOID;
+      if (!memcmp(h_pCurr, h_marker, h_lenMarker))
+         return h_pCurr;
+   }
+   return CST_PVOID;
+}
+
+static bool h_holds(const char* h_strVal,
+                    const char* const h_token)
+{
+   const size_t h_lenToken = strlen(h_token);
+   for (; *h_strVal; h_strVal++)
+      if (!strncasecmp(h_strVal, h_token, h_lenToken))
+         return true;
+   return false;
+}
+
+static CURLcode h_readHead(h_xfer* restrict h_pXfer,
+                           long* restrict h_pResCode,
+                           enum h_framing* restrict h_pFraming,
+                           long long* restrict h_pLenCont,
+                           bool* restrict h_pfKeep)
+{
+   H_conn* h_pConn = h_pXfer -> h_pConn;
+   while (true) {
+      const char* h_pEoh = h_find(h_pConn, H_EOH);
+      while (!h_pEoh) {
+         bool h_fEof;
+         const CURLcode h_libCode = h_fill(h_pXfer,
+                                           &h_fEof);
+         if (h_libCode)
+            return h_libCode;
+         if (h_fEof)
+            return h_pXfer -> h_fRecv ? CURLE_RECV_ERROR
+                                      : CURLE_GOT_NOTHING;
+         h_pEoh = h_find(h_pConn, H_EOH);
+      }
+      // the status line: HTTP/1.<minor> <code> <reason>
+      const char* h_pLine = h_pConn -> h_buf + h_pConn -> h_pos;
+      if (h_pEoh - h_pLine < 12 ||
+          memcmp(h_pLine, "HTTP/1.", 7) ||
+          h_pLine[8] != ' ' ||
+          strspn(h_pLine + 9, "0123456789") < 3)
+         return CURLE_WEIRD_SERVER_REPLY;
+      const bool h_fHttp10 = h_pLine[7] == '0';
+      *h_pResCode = (h_pLine[9] - '0') * 100L + (h_pLine[10] - '0') * 10L + (h_pLine[11] - '0');
+      *h_pFraming = h_fr_close;
+      *h_pLenCont = -1;
+      *h_pfKeep = !h_fHttp10;
+      // the header fields (the names are not case-sensitive); the status line may end the header
+      h_pLine = (const char*) memchr(h_pLine, '\r', (size_t) (h_pEoh - h_pLine) + 1) + 2;
+      while (h_pLine < h_pEoh + 2) {
+         const char* h_pEol = h_pLine;
+         while (*h_pEol != '\r')
+            h_pEol++;
+         const size_t h_lenLine = (size_t) (h_pEol - h_pLine);
+         char h_field[128] = {0};
+         memcpy(h_field, h_pLine, h_lenLine < sizeof(h_field) - 1 ? h_lenLine
+                                                                 : sizeof(h_field) - 1);
+         if (!strncasecmp(h_field, "Content-Length:", 15)) {
+            char* h_pEnd;
+            const long long h_len = strtoll(h_field + 15, &h_pEnd, 10);
+            if (h_len < 0 ||
+                h_pEnd == h_field + 15)
+               return CURLE_WEIRD_SERVER_REPLY;
+            if (*h_pFraming != h_fr_chunked) {
+               *h_pFraming = h_fr_length;
+               *h_pLenCont = h_len;
+            }
+         }
+         else if (!strncasecmp(h_field, "Transfer-Encoding:", 18) &&
+                  h_holds(h_field + 18, "chunked")) {
+            *h_pFraming = h_fr_chunked;
+            *h_pLenCont = -1;
+         }
+         else if (!strncasecmp(h_field, "Connection:", 11)) {
+            if (h_holds(h_field + 11, "close"))
+               *h_pfKeep = false;
+            else if (h_holds(h_field + 11, "keep-alive"))
+               *h_pfKeep = true;
+         }
+         h_pLine = h_pEol + 2;
+      }
+      h_pConn -> h_pos = (size_t) (h_pEoh - h_pConn -> h_buf) + 4;
+      // an interim response (for instance, 100 Continue) precedes the actual one
+      if (*h_pResCode >= 200)
+         break;
+   }
+   // these responses have no body
+   if (*h_pResCode == 204 ||
+       *h_pResCode == 304) {
+      *h_pFraming = h_fr_length;
+      *h_pLenCont = 0;
+   }
+   return CURLE_OK;
+}
+
+static CURLcode h_readBody(h_xfer* restrict h_pXfer,
+                           enum h_framing h_framing,
+                           long long h_lenCont,
+                           H_sink h_sink,
+                           void* h_uD)
+{
+   H_conn* h_pConn = h_pXfer -> h_pConn;
+   bool h_fEof = false;
+   CURLcode h_libCode = CURLE_OK;
+   if (h_framing != h_fr_chunked) {
+      long long h_remain = h_lenCont;
+      while (h_framing == h_fr_close ||
+             h_remain > 0) {
+         if (h_pConn -> h_pos == h_pConn -> h_len) {
+            h_libCode = h_fill(h_pXfer,
+                               &h_fEof);
+            if (h_libCode)
+               return h_libCode;
+            if (h_fEof)
+               return h_framing == h_fr_close ? CURLE_OK
+                                              : CURLE_PARTIAL_FILE;
+         }
+         size_t h_num = h_pConn -> h_len - h_pConn -> h_pos;
+         if (h_framing == h_fr_length &&
+             (long long) h_num > h_remain)
+            h_num = (size_t) h_remain;
+         if (!h_sink(h_uD,
+                     h_num, h_pConn -> h_buf + h_pConn -> h_pos,
+                     h_lenCont))
+            return CURLE_WRITE_ERROR;
+         h_pConn -> h_pos += h_num;
+         h_remain -= (long long) h_num;
+      }
+      return CURLE_OK;
+   }
+   // each chunk is made of a line holding its size (hexadecimal), the data and an empty line. The last
+   // chunk has no data and is followed by the trailer fields
+   while (true) {
+      const char* h_pEol;
+      while (!(h_pEol = h_find(h_pConn, H_EOL))) {
+         h_libCode = h_fill(h_pXfer,
+                            &h_fEof);
+         if (h_libCode)
+            return h_libCode;
+         if (h_fEof)
+            return CURLE_PARTIAL_FILE;
+      }
+      const char* h_pLine = h_pConn -> h_buf + h_pConn -> h_pos;
+      unsigned long long h_szChunk = 0;
+      size_t h_numDigit = 0;
+      for (; h_pLine + h_numDigit < h_pEol; h_numDigit++) {
+         const char h_ch = h_pLine[h_numDigit];
+         const int h_val = h_ch >= '0' && h_ch <= '9' ? h_ch - '0'
+                                                      : (h_ch | 0x20) >= 'a' && (h_ch | 0x20) <= 'f' ? (h_ch | 0x20) - 'a' + 10
+                                                                                                     : -1;
+         if (h_val < 0)
+            break;
+         if (h_szChunk >> 56)
+            return CURLE_WEIRD_SERVER_REPLY;
+         h_szChunk = (h_szChunk << 4) | (unsigned) h_val;
+      }
+      if (!h_numDigit)
+         return CURLE_WEIRD_SERVER_REPLY;
+      h_pConn -> h_pos = (size_t) (h_pEol - h_pConn -> h_buf) + 2;
+      if (!h_szChunk)
+         break;
+      while (h_szChunk) {
+         if (h_pConn -> h_pos == h_pConn -> h_len) {
+            h_libCode = h_fill(h_pXfer,
+                               &h_fEof);
+            if (h_libCode)
+               return h_libCode;
+            if (h_fEof)
+               return CURLE_PARTIAL_FILE;
+         }
+         size_t h_num = h_pConn -> h_len - h_pConn -> h_pos;
+         if (h_num > h_szChunk)
+            h_num = (size_t) h_szChunk;
+         if (!h_sink(h_uD,
+                     h_num, h_pConn -> h_buf + h_pConn -> h_pos,
+                     -1))
+            return CURLE_WRITE_ERROR;
+         h_pConn -> h_pos += h_num;
+         h_szChunk -= h_num;
+      }
+      // the empty line that follows the data
+      while (h_pConn -> h_len - h_pConn -> h_pos < 2) {
+         h_libCode = h_fill(h_pXfer,
+                            &h_fEof);
+         if (h_libCode)
+            return h_libCode;
+         if (h_fEof)
+            return CURLE_PARTIAL_FILE;
+      }
+      if (memcmp(h_pConn -> h_buf + h_pConn -> h_pos, H_EOL, 2))
+         return CURLE_WEIRD_SERVER_REPLY;
+      h_pConn -> h_pos += 2;
+   }
+   // the trailer fields end with an empty line
+   while (true) {
+      const char* h_pEol;
+      while (!(h_pEol = h_find(h_pConn, H_EOL))) {
+         h_libCode = h_fill(h_pXfer,
+                            &h_fEof);
+         if (h_libCode)
+            return h_libCode;
+         if (h_fEof)
+            return CURLE_PARTIAL_FILE;
+      }
+      const bool h_fEmpty = h_pEol == h_pConn -> h_buf + h_pConn -> h_pos;
+      h_pConn -> h_pos = (size_t) (h_pEol - h_pConn -> h_buf) + 2;
+      if (h_fEmpty)
+         return CURLE_OK;
+   }
+}
@@ -0,0 +1,399 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <curl/curl.h>
+#include "wrctrl.h"
+#include "board.h"
+#ifdef WRC_NATIVE_HTTP
+#include "http.h"
+#endif
+#include "parser.h"
+#include "parser_constants.h"
+#include "constants.h"
+#include "err_wrapper.h"
+
+struct L_board {
+// the description of the web relay array
+   B_board l_board;
+#ifdef WRC_NATIVE_HTTP
+// the connection (it is kept alive among the requests)
+   H_conn l_conn;
+#else
+// the easy handle (it is reused, so that the connection is kept alive)
+   CURL* l_pHan;
+#endif
+// the data that receive the html response
+   B_dl_data l_dlData;
+// serializes the requests performed on the handle
+   pthread_mutex_t l_mutex;
+// the limits of the requests
+   L_policy l_policy;
+// state of the generator of the jitter of the backoff
+   uint32_t l_seed;
+};
+
+#ifdef WRC_NATIVE_HTTP
+// the sink of the built-in transport
+static bool l_sink(void* l_uD,
+                   size_t l_len, const char* l_buf,
+                   long long l_lenCont)
+{
+   return B_feed((B_dl_data*) l_uD,
+                 l_len, l_buf,
+                 l_lenCont);
+}
+#else
+// curl is initialized only once per process
+static pthread_once_t l_onceInit = PTHREAD_ONCE_INIT;
+static CURLcode l_initCode = CURLE_OK;
+
+static void l_init(void)
+{
+   l_initCode = curl_global_init(CURL_GLOBAL_DEFAULT);
+   // the handles of the process share the cache of the resolved names and the TLS sessions (each
+   // handle keeps its own connection: libcurl does not share the connections among threads)
+   if (!l_initCode &&
+       !B_initShare(false))
+      l_initCode = CURLE_FAILED_INIT;
+}
+#endif
+
+// milliseconds elapsed since a given instant of the monotonic clock
+static unsigned long l_elapsed(const struct timespec* restrict l_pStart)
+{
+   struct timespec l_now;
+   clock_gettime(CLOCK_MONOTONIC, &l_now);
+   return (unsigned long) ((l_now.tv_sec - l_pStart -> tv_sec) * 1000L +
+                           (l_now.tv_nsec - l_pStart -> tv_nsec) / 1000000L);
+}
+
+// performs a single attempt of the request of a URL on a handle (its outcome is stored within l_pRes)
+static CURLcode l_attempt(L_board* l_pBoard,
+                          const char* const l_strUrl,
+                          unsigned long l_remain,
+                          L_result* restrict l_pRes)
+{
+   l_pRes -> l_resCode = 0;
+   l_pRes -> l_stat = R_DEF;
+   B_resetDlData(&(l_pBoard -> l_dlData),
+                 &(l_pBoard -> l_board));
+#ifdef WRC_NATIVE_HTTP
+   // the minimum transfer rate is approximated by the longest wait for data
+   const L_policy* l_pPolicy = &(l_pBoard -> l_policy);
+   const H_limits l_limits = {.h_timeout = l_remain,
+                              .h_connTimeout = l_pPolicy -> l_connTimeout,
+                              .h_idleTimeout = l_pPolicy -> l_lowSpeed ? l_pPolicy -> l_lowTime * 1000UL
+                                                                       : 0};
+   H_times l_times;
+   CURLcode l_libCode = B_chkResult(H_get(&(l_pBoard -> l_conn),
+                                          l_strUrl,
+                                          &l_limits,
+                                          l_sink,
+                                          &(l_pBoard -> l_dlData),
+                                          &(l_pRes -> l_resCode),
+                                          &l_times),
+                                    &(l_pBoard -> l_dlData));
+   const B_xferInfo l_info = {.b_lookupTime = l_times.h_lookupTime,
+                              .b_connTime = l_times.h_connTime,
+                              .b_ttfbTime = l_times.h_ttfbTime,
+                              .b_totTime = l_times.h_totTime,
+                              .b_numRecv = l_pBoard -> l_dlData.b_numRecv,
+                              .b_fParsed = l_pBoard -> l_dlData.b_resp.p_fDone,
+                              .b_fNewConn = l_times.h_fNewConn,
+                              .b_fHandshake = false};
+#else
+   CURLcode l_libCode = B_setLimits(l_pBoard -> l_pHan,
+                                    &(l_pBoard -> l_policy),
+                                    l_remain);
+   if (!l_libCode)
+      l_libCode = curl_easy_setopt(l_pBoard -> l_pHan,
+                                   CURLOPT_URL,
+                                   l_strUrl);
+   if (!l_libCode)
+      l_libCode = B_chkResult(curl_easy_perform(l_pBoard -> l_pHan),
+                              &(l_pBoard -> l_dlData));
+   if (!l_libCode) {
+      l_pRes -> l_resCode = 200;
+      l_libCode = curl_easy_getinfo(l_pBoard -> l_pHan,
+                                    CURLINFO_RESPONSE_CODE,
+                                    &(l_pRes -> l_resCode));
+   }
+   // the breakdown of the duration of the attempt
+   B_xferInfo l_info;
+   B_readXferInfo(l_pBoard -> l_pHan,
+                  &(l_pBoard -> l_dlData),
+                  &l_info);
+#endif
+   l_pRes -> l_totTime = l_info.b_totTime;
+   l_pRes -> l_lookupTime = l_info.b_lookupTime;
+   l_pRes -> l_connTime = l_info.b_connTime;
+   l_pRes -> l_ttfbTime = l_info.b_ttfbTime;
+   l_pRes -> l_numRecv = l_info.b_numRecv;
+   l_pRes -> l_fParsed = l_info.b_fParsed;
+   l_pRes -> l_fNewConn = l_info.b_fNewConn;
+   l_pRes -> l_fHandshake = l_info.b_fHandshake;
+   if (!l_libCode &&
+       l_pRes -> l_resCode == 200)
+      l_pRes -> l_stat = l_pBoard -> l_dlData.b_resp.p_stat;
+   l_pRes -> l_libCode = l_libCode;
+   l_pRes -> l_attempts[l_pRes -> l_numAttempt] = (L_attempt) {.l_resCode = l_pRes -> l_resCode,
+                                                               .l_libCode = l_libCode,
+                                                               .l_totTime = l_info.b_totTime};
+   l_pRes -> l_numAttempt++;
+   return l_libCode;
+}
+
+// performs the request of a URL on a handle, retrying the transient failures as long as the policy allows it
+static int l_perform(L_board* l_pBoard,
+                     const char* const l_strUrl,
+                     L_result* restrict l_pRes)
+{
+   memset(l_pRes, 0, sizeof(L_result));
+   pthread_mutex_lock(&(l_pBoard -> l_mutex));
+   const L_policy* l_pPolicy = &(l_pBoard -> l_policy);
+   struct timespec l_start;
+   clock_gettime(CLOCK_MONOTONIC, &l_start);
+   CURLcode l_libCode = CURLE_OK;
+   while (true) {
+      // an attempt that starts late (the backoff may oversleep) is granted a millisecond
+      unsigned long l_remain = 0;
+      if (l_pPolicy -> l_deadline) {
+         const unsigned long l_elapsedMs = l_elapsed(&l_start);
+         l_remain = l_elapsedMs < l_pPolicy -> l_deadline ? l_pPolicy -> l_deadline - l_elapsedMs
+                                                          : 1;
+      }
+      l_libCode = l_attempt(l_pBoard,
+                            l_strUrl,
+                            l_remain,
+                            l_pRes);
+      if (l_pRes -> l_numAttempt > l_pPolicy -> l_maxRetry ||
+          !B_isTransient(l_libCode,
+                         l_pRes -> l_resCode))
+         break;
+      // a retry that could not start before the deadline is not attempted
+      const unsigned long l_delay = B_backoff(l_pPolicy,
+                                              l_pRes -> l_numAttempt - 1,
+                                              &(l_pBoard -> l_seed));
+      if (l_pPolicy -> l_deadline &&
+          l_elapsed(&l_start) + l_delay >= l_pPolicy -> l_deadline)
+         break;
+      struct timespec l_wait = {.tv_sec = (time_t) (l_delay / 1000),
+                                .tv_nsec = (long) (l_delay % 1000) * 1000000L};
+      // a signal does not shorten the backoff
+      while (nanosleep(&l_wait, &l_wait)) {
+         if (errno != EINTR)
+            break;
+      }
+   }
+   pthread_mutex_unlock(&(l_pBoard -> l_mutex));
+   if (l_libCode)
+      return wRC_Cd_curl;
+   return l_pRes -> l_resCode == 200 ? wRC_Cd_noError
+                                     : wRC_Cd_resp;
+}
+
+// performs the request of a command (or of a status query) on a handle
+static int l_exchange(L_board* l_pBoard,
+                      const P_out* restrict l_pComm,
+                      L_result* restrict l_pRes)
+{
+   return l_perform(l_pBoard,
+                    B_getUrl(&(l_pBoard -> l_board),
+                             l_pComm),
+                    l_pRes);
+}
+
+int L_openBoard(L_board** l_ppBoard,
+                size_t l_szStr_IPv4, const char* const l_str_IPv4,
+                size_t l_szStr_port, const char* const l_str_port,
+                enum r_mCodes l_hwMod)
+{
+   if (!l_ppBoard)
+      return wRC_Cd_invP;
+   *l_ppBoard = CST_PVOID;
+#ifndef WRC_NATIVE_HTTP
+   pthread_once(&l_onceInit,
+                l_init);
+   if (l_initCode)
+      return wRC_Cd_curl;
+#endif
+   L_board* l_pBoard = calloc(1, sizeof(L_board));
+   if (!l_pBoard)
+      return wRC_Cd_heapManFail;
+   int l_errCode = B_initBoard(&(l_pBoard -> l_board),
+                               l_szStr_IPv4, l_str_IPv4,
+                               l_szStr_port, l_str_port,
+                               l_hwMod);
+   if (l_errCode) {
+      free(l_pBoard);
+      return l_errCode;
+   }
+#ifdef WRC_NATIVE_HTTP
+   H_init(&(l_pBoard -> l_conn));
+   if (pthread_mutex_init(&(l_pBoard -> l_mutex), CST_PVOID)) {
+      free(l_pBoard);
+      return wRC_Cd_heapManFail;
+   }
+#else
+   l_pBoard -> l_pHan = curl_easy_init();
+   if (!(l_pBoard -> l_pHan)) {
+      free(l_pBoard);
+      return wRC_Cd_curl;
+   }
+   // signals cannot be used by a library that may be invoked by several threads
+   if (B_prepHandle(l_pBoard -> l_pHan,
+                    &(l_pBoard -> l_dlData)) ||
+       curl_easy_setopt(l_pBoard -> l_pHan,
+                        CURLOPT_NOSIGNAL,
+                        1L)) {
+      curl_easy_cleanup(l_pBoard -> l_pHan);
+      free(l_pBoard);
+      return wRC_Cd_curl;
+   }
+   if (pthread_mutex_init(&(l_pBoard -> l_mutex), CST_PVOID)) {
+      curl_easy_cleanup(l_pBoard -> l_pHan);
+      free(l_pBoard);
+      return wRC_Cd_heapManFail;
+   }
+#endif
+   L_defPolicy(&(l_pBoard -> l_policy));
+   // the seed differs among the handles and among the processes
+   struct timespec l_now;
+   clock_gettime(CLOCK_MONOTONIC, &l_now);
+   l_pBoard -> l_seed = (uint32_t) ((uintptr_t) l_pBoard ^ (uintptr_t) l_now.tv_nsec) | 1U;
+   *l_ppBoard = l_pBoard;
+   return wRC_Cd_noError;
+}
+
+void L_defPolicy(L_policy* restrict l_pPolicy)
+{
+   *l_pPolicy = (L_policy) {.l_deadline = L_DEF_DEADLINE,
+                            .l_connTimeout = L_DEF_CONNTIME,
+                            .l_lowSpeed = L_DEF_LOWSPEED,
+                            .l_lowTime = L_DEF_LOWTIME,
+                            .l_maxRetry = L_DEF_MAXRETRY,
+                            .l_backoff = L_DEF_BACKOFF,
+                            .l_maxBackoff = L_DEF_MAXBACKOFF};
+}
+
+int L_setPolicy(L_board* l_pBoard,
+                const L_policy* restrict l_pPolicy)
+{
+   if (!l_pBoard ||
+       !l_pPolicy ||
+       !B_chkPolicy(l_pPolicy))
+      return wRC_Cd_invP;
+   pthread_mutex_lock(&(l_pBoard -> l_mutex));
+   l_pBoard -> l_policy = *l_pPolicy;
+   pthread_mutex_unlock(&(l_pBoard -> l_mutex));
+   return wRC_Cd_noError;
+}
+
+int L_sendCommand(L_board* l_pBoard,
+                  unsigned l_rID,
+                  bool l_fAct,
+                  L_result* restrict l_pRes)
+{
+   if (!l_pBoard ||
+       !l_pRes ||
+       l_rID >= P_CST_NUMREL)
+      return wRC_Cd_invP;
+   const P_out l_comm = {.p_rID = (int) l_rID, .p_fAct = l_fAct, .p_oAct = oAct_numOAct};
+   return l_exchange(l_pBoard,
+                     &l_comm,
+                     l_pRes);
+}
+
+int L_readStat(L_board* l_pBoard,
+               L_result* restrict l_pRes)
+{
+   if (!l_pBoard ||
+       !l_pRes)
+      return wRC_Cd_invP;
+   const P_out l_comm = {.p_rID = 0, .p_fAct = false, .p_oAct = oAct_status};
+   return l_exchange(l_pBoard,
+                     &l_comm,
+                     l_pRes);
+}
+
+int L_setMask(L_board* l_pBoard,
+              r_stat l_stat,
+              const r_stat* l_pCurrStat,
+              L_result* restrict l_pRes,
+              unsigned* restrict l_pNumReq)
+{
+   if (!l_pBoard ||
+       !l_pRes ||
+       !l_pNumReq)
+      return wRC_Cd_invP;
+   *l_pNumReq = 0;
+   if (l_pCurrStat &&
+       *l_pCurrStat == l_stat) {
+      memset(l_pRes, 0, sizeof(L_result));
+      l_pRes -> l_stat = l_stat;
+      return wRC_Cd_noError;
+   }
+   // the whole change is conveyed by a single request, if the model allows it
+   char l_strUrl[B_MAXSZSTR_URL];
+   if (B_renderMaskUrl(&(l_pBoard -> l_board),
+                       l_stat,
+                       l_strUrl)) {
+      *l_pNumReq = 1;
+      return l_perform(l_pBoard,
+                       l_strUrl,
+                       l_pRes);
+   }
+   // otherwise, only the relays whose status differs are commanded
+   int l_errCode = wRC_Cd_noError;
+   r_stat l_currStat = R_DEF;
+   if (l_pCurrStat)
+      l_currStat = *l_pCurrStat;
+   else {
+      l_errCode = L_readStat(l_pBoard,
+                             l_pRes);
+      (*l_pNumReq)++;
+      if (l_errCode)
+         return l_errCode;
+      l_currStat = l_pRes -> l_stat;
+   }
+   for (unsigned i = 0; i < P_CST_NUMREL; i++) {
+      const r_stat l_relMask = R_ON_MASK(i);
+      if ((l_currStat & l_relMask) == (l_stat & l_relMask))
+         continue;
+      l_errCode = L_sendCommand(l_pBoard,
+                                i,
+                                (l_stat & l_relMask) != 0,
+                                l_pRes);
+      (*l_pNumReq)++;
+      if (l_errCode)
+         return l_errCode;
+   }
+   return wRC_Cd_noError;
+}
+
+const struct B_board* L_getBoard(const L_board* l_pBoard)
+{
+   return l_pBoard ? &(l_pBoard -> l_board)
+                   : CST_PVOID;
+}
+
+void L_closeBoard(L_board* l_pBoard)
+{
+   if (!l_pBoard)
+      return;
+#ifdef WRC_NATIVE_HTTP
+   H_close(&(l_pBoard -> l_conn));
+#else
+   curl_easy_cleanup(l_pBoard -> l_pHan);
+#endif
+   pthread_mutex_destroy(&(l_pBoard -> l_mutex));
+   free(l_pBoard);
+}
@@ -1,27 +1,31 @@
 /**************************************/
 /* Author: Pavlo Nykolyn              */
-/* Last modification date: 21/05/2023 */
+/* Last modification date: 17/10/2026 */
 /**************************************/
 
 #include <stdio.h>
 #include <string.h>
 #include <ctype.h>
 #include "parser.h"
+#include "scan.h"
 #include "err_wrapper.h"
 
 #define PARSE_LINELEN  101U  // length of an input line
 
 // a dictionary of words recognized by the parser
 // each line of the dictionary is associated with a word position in the input line
-static const char* p_dict[2][2] = {{"turn", "quit"},
-                                   {"on", "off"}};
+static const char* p_dict[2][3] = {{"turn", "quit", "status"},
+                                   {"on", "off", ""}};
 // templates of mnemonic codes. The # character indicates a relay-ID
 static const char* p_templ[2] = {"t_on_#",
                                  "t_off_#"};
+// the mnemonic code that reads the status of the relays
+static const char p_statMnemCd[] = "status";
 
-enum p_fstWords {p_turn,  /**< turn */
-                 p_quit,  /**< quit */
-                 p_numFW  /**< number of words that occupy the first position */
+enum p_fstWords {p_turn,    /**< turn */
+                 p_quit,    /**< quit */
+                 p_status,  /**< status */
+                 p_numFW    /**< number of words that occupy the first position */
                 };
 
 enum p_secWords {p_on,    /**< on */
@@ -35,6 +39,8 @@ static enum p_fstWords p_checkFstW(const char* const p_pWord)
       return p_turn;
    else if (!strcmp(p_pWord, p_dict[0][1]))
       return p_quit;
+   else if (!strcmp(p_pWord, p_dict[0][2]))
+      return p_status;
    return p_numFW;
 }
 
@@ -58,26 +64,26 @@ static int p_checkWord(unsigned p_wPos,
                        const char* const p_pWord,
                        P_out* restrict p_pIntData);
 // HTML RESPONSE PARSING
-static r_stat p_parseKMTronicResp(size_t p_szStrResp, const char* const p_strResp);
-static r_stat p_parseNC800Resp(size_t p_szStrResp, const char* const p_strResp);
+// the position from which the search of a marker has to be resumed: either the first complete
+// occurrence of the marker or the beginning of the characters that may hold a truncated one
+static size_t p_skipTo(size_t p_szChunk, const char* const p_chunk,
+                       size_t p_lenMarker, const char* const p_marker);
 // status extraction
-static r_stat p_extrStat_KMTronic(unsigned p_szTarg, const char* const p_targ); // target string
-static r_stat p_extrStat_NC800(const char p_chID, // relay identifier (an Arab digit)
-                               r_stat p_rStat);
+static r_stat p_extrStat(const char p_chID, // relay identifier (an Arab digit)
+                         r_stat p_rStat);
 
 int P_parseInput(P_out* restrict p_pIntData)
 {
-   int p_errCode = wRC_Cd_noError;
    if (!p_pIntData) {
       fputs(WRC_MSG_INVPAR, stderr);
-      p_errCode = wRC_Cd_invP;
-      goto P_PARSEIN_EXIT;
+      return wRC_Cd_invP;
    }
    char line[PARSE_LINELEN] = {0};
    unsigned numCh = 0;
-   char p_ch = getchar();
+   int p_ch = getchar();
    while (numCh < PARSE_LINELEN - 1 &&
-          p_ch != '\n') {
+          p_ch != '\n' &&
+          p_ch != EOF) {
       // multiple spaces are coalesced into a single space and leading spaces are ignored
       if (!isspace(p_ch) ||
           (numCh &&
@@ -88,32 +94,85 @@ int P_parseInput(P_out* restrict p_pIntData)
       }
       p_ch = getchar();
    }
+   // the end of the input terminates the session
+   if (p_ch == EOF &&
+       !numCh) {
+      p_pIntData -> p_oAct = oAct_quit;
+      return wRC_Cd_noError;
+   }
    if (numCh == PARSE_LINELEN - 1 &&
        p_ch != '\n') {
-      while (getchar() != '\n') ; // discarding the un-read characters
+      // discarding the un-read characters
+      while ((p_ch = getchar()) != '\n' &&
+             p_ch != EOF) ;
       fputs("[NOT] the internal buffer length has been reached. Every un-read character will be discarded\n", stderr);
    }
+   return P_parseLine(p_pIntData,
+                      numCh, line);
+}
+
+int P_parseLine(P_out* restrict p_pIntData,
+                size_t p_lenLine, const char* const p_line)
+{
+   int p_errCode = wRC_Cd_noError;
+   if (!p_pIntData ||
+       (p_lenLine &&
+        !p_line)) {
+      fputs(WRC_MSG_INVPAR, stderr);
+      p_errCode = wRC_Cd_invP;
+      goto P_PARSELINE_EXIT;
+   }
+   char line[PARSE_LINELEN] = {0};
+   unsigned numCh = 0;
+   for (size_t i = 0; i < p_lenLine && p_line[i]; i++) {
+      // multiple spaces are coalesced into a single space and leading spaces are ignored
+      if (!isspace(p_line[i]) ||
+          (numCh &&
+           !isspace(line[numCh - 1]))) {
+         // no command is that long (one character is reserved to the trailing space)
+         if (numCh == PARSE_LINELEN - 2) {
+            fputs(WRC_MSG_WRUSRI, stderr);
+            p_errCode = wRC_Cd_wrI;
+            goto P_PARSELINE_EXIT;
+         }
+         line[numCh] = isspace(p_line[i]) ? ' '
+                                          : p_line[i];
+         numCh++;
+      }
+   }
+   if (!numCh) {
+      fputs(WRC_MSG_WRUSRI, stderr);
+      p_errCode = wRC_Cd_wrI;
+      goto P_PARSELINE_EXIT;
+   }
    if (!isspace(line[numCh - 1])) {
       line[numCh] = ' '; // needed for "tokenization"
       numCh++;
    }
-   if (numCh) {
-      unsigned p_numW = p_tokenize(numCh, line);
-      unsigned p_off = 0; // an offset used to "select" the first character of a word that resulted from "tokenization"
-      for (unsigned i = 0; i < p_numW; i++) {
-         p_errCode = p_checkWord(i,
-                                 line + p_off,
-                                 p_pIntData);
-         if (p_errCode == wRC_Cd_wrI ||
-             (i &&
-             (p_pIntData -> p_oAct == oAct_quit))) {
-            fputs(WRC_MSG_WRUSRI, stderr);
-            goto P_PARSEIN_EXIT;
-         }
-         p_off += strlen(line + p_off) + 1;
+   unsigned p_numW = p_tokenize(numCh, line);
+   unsigned p_off = 0; // an offset used to "select" the first character of a word that resulted from "tokenization"
+   for (unsigned i = 0; i < p_numW; i++) {
+      p_errCode = p_checkWord(i,
+                              line + p_off,
+                              p_pIntData);
+      // quit and status are made of a single word
+      if (p_errCode == wRC_Cd_wrI ||
+          (i &&
+          (p_pIntData -> p_oAct != oAct_numOAct))) {
+         fputs(WRC_MSG_WRUSRI, stderr);
+         p_errCode = wRC_Cd_wrI;
+         goto P_PARSELINE_EXIT;
       }
+      p_off += strlen(line + p_off) + 1;
    }
-   P_PARSEIN_EXIT:
+   // turn is followed by the action and the relay (a truncated command does not act on the relay
+   // left within the output by the caller)
+   if (p_checkFstW(line) == p_turn &&
+       p_numW != 3) {
+      fputs(WRC_MSG_WRUSRI, stderr);
+      p_errCode = wRC_Cd_wrI;
+   }
+   P_PARSELINE_EXIT:
    return p_errCode;
 }
 
@@ -126,6 +185,10 @@ int P_parseMnemCode(P_out* restrict p_pIntData,
       p_errCode = wRC_Cd_invP;
       goto P_PARSEMNEMCODE_EXIT;
    }
+   if (!strncmp(p_strMnemCd, p_statMnemCd, P_CST_MAXSZSTR_MNEMCD)) {
+      p_pIntData -> p_oAct = oAct_status;
+      goto P_PARSEMNEMCODE_EXIT;
+   }
    unsigned p_strLen = P_CST_MAXLEN_MNEMCD - 1;
    const char* p_pStrTempl = p_templ[1];
    if (!p_strMnemCd[p_strLen]) {
@@ -149,92 +212,268 @@ int P_parseMnemCode(P_out* restrict p_pIntData,
    return p_errCode;
 }
 
-r_stat P_parseHtmlResp(size_t p_szStrResp, const char* const p_strResp,
-                       const enum r_mCodes p_hwMod)
+int P_parsePulse(P_pulse* restrict p_pPulse,
+                 size_t p_lenStrPulse, const char* const p_strPulse)
 {
-   switch (p_hwMod) {
-      case r_kmTronic: return p_parseKMTronicResp(p_szStrResp, p_strResp);
-      case r_nc800: return p_parseNC800Resp(p_szStrResp, p_strResp);
-      default: ; // suppresses a needless warning
+   if (!p_pPulse ||
+       !p_strPulse) {
+      fputs(WRC_MSG_INVPAR, stderr);
+      return wRC_Cd_invP;
+   }
+   // <relay-ID>:<duration>
+   if (p_lenStrPulse < 3 ||
+       !isdigit(p_strPulse[0]) ||
+       p_strPulse[0] == '0' || p_strPulse[0] == '9' ||
+       p_strPulse[1] != ':') {
+      fputs(WRC_MSG_WRUSRI, stderr);
+      return wRC_Cd_wrI;
+   }
+   unsigned long p_dur = 0;
+   if (P_parseDuration(&p_dur,
+                       p_lenStrPulse - 2, p_strPulse + 2)) {
+      fputs(WRC_MSG_WRUSRI, stderr);
+      return wRC_Cd_wrI;
    }
-   return R_DEF;
+   p_pPulse -> p_rID = p_strPulse[0] - '1';
+   p_pPulse -> p_dur = p_dur;
+   return wRC_Cd_noError;
 }
 
-static r_stat p_parseKMTronicResp(size_t p_szStrResp, const char* const p_strResp)
+int P_parseDuration(unsigned long* restrict p_pDur,
+                    size_t p_lenStrDur, const char* const p_strDur)
 {
+   if (!p_pDur ||
+       !p_strDur)
+      return wRC_Cd_invP;
+   // <digit>{<digit>}[<unit>]
+   if (!p_lenStrDur ||
+       !isdigit(p_strDur[0]))
+      return wRC_Cd_wrI;
+   unsigned long p_dur = 0;
    size_t p_currPos = 0;
-   while (p_currPos < p_szStrResp &&
-          *(p_strResp + p_currPos)) {
-      size_t p_lineLen = strcspn(p_strResp + p_currPos, "\n"); // assuming that each line is terminated with a new-line character
-      if (p_lineLen > 6 &&
-          !strncmp(p_strResp +  p_currPos, "Status", 6)) {
-         char p_statLine[p_lineLen + 1];
-         p_statLine[p_lineLen] = '\0';
-         memcpy(p_statLine, p_strResp + p_currPos, p_lineLen);
-         return p_extrStat_KMTronic(p_lineLen + 1, p_statLine);
+   while (p_currPos < p_lenStrDur &&
+          isdigit(p_strDur[p_currPos])) {
+      p_dur = 10 * p_dur + (p_strDur[p_currPos] - '0');
+      if (p_dur > P_CST_MAXDUR_PULSE)
+         return wRC_Cd_wrI;
+      p_currPos++;
+   }
+   const size_t p_lenUnit = p_lenStrDur - p_currPos;
+   const char* const p_pUnit = p_strDur + p_currPos;
+   if (!p_lenUnit ||
+       (p_lenUnit == 1 &&
+        *p_pUnit == 's'))
+      p_dur *= 1000;
+   else if (p_lenUnit == 1 &&
+            *p_pUnit == 'm')
+      p_dur *= 60000;
+   else if (p_lenUnit != 2 ||
+            memcmp(p_pUnit, "ms", 2))
+      return wRC_Cd_wrI;
+   if (!p_dur ||
+       p_dur > P_CST_MAXDUR_PULSE)
+      return wRC_Cd_wrI;
+   *p_pDur = p_dur;
+   return wRC_Cd_noError;
+}
+
+int P_parseMask(r_stat* restrict p_pStat,
+                size_t p_lenStrMask, const char* const p_strMask)
+{
+   if (!p_pStat ||
+       !p_strMask) {
+      fputs(WRC_MSG_INVPAR, stderr);
+      return wRC_Cd_invP;
+   }
+   if (p_lenStrMask != P_CST_NUMREL) {
+      fputs(WRC_MSG_WRUSRI, stderr);
+      return wRC_Cd_wrI;
+   }
+   r_stat p_stat = R_DEF;
+   for (unsigned i = 0; i < P_CST_NUMREL; i++) {
+      if (p_strMask[i] == '1')
+         p_stat |= R_ON_MASK(i);
+      else if (p_strMask[i] != '0') {
+         fputs(WRC_MSG_WRUSRI, stderr);
+         return wRC_Cd_wrI;
       }
-      p_currPos += p_lineLen + 1;
    }
-   return R_DEF;
+   *p_pStat = p_stat;
+   return wRC_Cd_noError;
 }
 
-static r_stat p_parseNC800Resp(size_t p_szStrResp, const char* const p_strResp)
+void P_initResp(P_respState* restrict p_pState,
+                P_respFeeder p_feed)
 {
-   r_stat p_rStat = R_DEF;
-   size_t p_currPos = 0;
-   while (p_currPos < p_szStrResp &&
-          *(p_strResp + p_currPos)) {
-      if (*(p_strResp + p_currPos) == 'R' &&
-          !strncmp(p_strResp + p_currPos, "Relay-0", 7)) {
-         size_t p_hopLen = p_currPos + 7;
-         const char p_rID = *(p_strResp + p_hopLen);
-         // now p_hopLen refers to the first position of the font color identifier
-         p_hopLen += strcspn(p_strResp + p_hopLen + 1, "#") + 2;
-         if (strncmp(p_strResp + p_hopLen, "FF0000", 6))
-            p_rStat = p_extrStat_NC800(p_rID,
-                                       p_rStat);
-         p_currPos = p_hopLen + 6;
-         continue;
+   memset(p_pState, 0, sizeof(P_respState));
+   p_pState -> p_feed = p_feed;
+   p_pState -> p_stat = R_DEF;
+   p_pState -> p_state = P_RS_LINE;
+}
+
+bool P_feedResp(P_respState* restrict p_pState,
+                size_t p_szChunk, const char* const p_chunk)
+{
+   if (!(p_pState -> p_fDone) &&
+       p_szChunk) {
+      if (p_pState -> p_feed)
+         p_pState -> p_feed(p_pState,
+                            p_szChunk, p_chunk);
+      else
+         p_pState -> p_fDone = true;
+   }
+   return p_pState -> p_fDone;
+}
+
+r_stat P_parseHtmlResp(size_t p_szStrResp, const char* const p_strResp,
+                       P_respFeeder p_feed)
+{
+   P_respState p_state;
+   P_initResp(&p_state,
+              p_feed);
+   // the response ends either at its size or at the first null character
+   P_feedResp(&p_state,
+              strnlen(p_strResp, p_szStrResp), p_strResp);
+   return p_state.p_stat;
+}
+
+void P_feedKMTronicResp(P_respState* restrict p_pState,
+                        size_t p_szChunk, const char* const p_chunk)
+{
+   static const char p_marker[] = "Status";
+   static const char p_lineMarker[] = "\nStatus";
+   const unsigned p_lenMarker = sizeof(p_marker) - 1;
+   for (size_t i = 0; i < p_szChunk; i++) {
+      // the rest of a line is relevant only if the following line begins with the marker
+      if (p_pState -> p_state == P_RS_SKIP)
+         i += p_skipTo(p_szChunk - i, p_chunk + i,
+                       sizeof(p_lineMarker) - 1, p_lineMarker);
+      const char p_ch = p_chunk[i];
+      switch (p_pState -> p_state) {
+         case P_RS_LINE:   // matching the marker at the beginning of a line
+                           if (p_ch == p_marker[p_pState -> p_numMatch]) {
+                              p_pState -> p_numMatch++;
+                              if (p_pState -> p_numMatch == p_lenMarker)
+                                 p_pState -> p_state = P_RS_SEP;
+                           }
+                           else if (p_ch != '\n')
+                              p_pState -> p_state = P_RS_SKIP;
+                           else
+                              p_pState -> p_numMatch = 0;
+                           break;
+         case P_RS_SKIP:   // discarding the rest of a line
+                           if (p_ch == '\n') {
+                              p_pState -> p_numMatch = 0;
+                              p_pState -> p_state = P_RS_LINE;
+                           }
+                           break;
+         case P_RS_SEP:    // the character that follows the marker (a line made only by the marker is discarded)
+                           if (p_ch == '\n') {
+                              p_pState -> p_numMatch = 0;
+                              p_pState -> p_state = P_RS_LINE;
+                           }
+                           else
+                              p_pState -> p_state = P_RS_STAT;
+                           break;
+         case P_RS_STAT:   // the status of each relay
+                           if (p_ch == '\n') {
+                              p_pState -> p_fDone = true;
+                              return;
+                           }
+                           if (p_ch == '1')
+                              p_pState -> p_stat = p_extrStat('1' + p_pState -> p_numRel,
+                                                              p_pState -> p_stat);
+                           if (p_ch == '0' ||
+                               p_ch == '1') {
+                              p_pState -> p_numRel++;
+                              if (p_pState -> p_numRel == P_CST_NUMREL) {
+                                 p_pState -> p_fDone = true;
+                                 return;
+                              }
+                           }
       }
-      p_currPos++;
    }
-   return p_rStat;
 }
 
-static r_stat p_extrStat_KMTronic(unsigned p_szTarg, const char* const p_targ)
+void P_feedNC800Resp(P_respState* restrict p_pState,
+                     size_t p_szChunk, const char* const p_chunk)
 {
-   r_stat p_rStat = R_DEF;
-   unsigned p_currR = 0; // current relay
-   for (size_t i = 7; i < p_szTarg; i++) {
-      if (*(p_targ + i) == '1') {
-         switch (p_currR) {
-            case 0: p_rStat |= R_ON_1;
-                    break;
-            case 1: p_rStat |= R_ON_2;
-                    break;
-            case 2: p_rStat |= R_ON_3;
-                    break;
-            case 3: p_rStat |= R_ON_4;
-                    break;
-            case 4: p_rStat |= R_ON_5;
-                    break;
-            case 5: p_rStat |= R_ON_6;
-                    break;
-            case 6: p_rStat |= R_ON_7;
-                    break;
-            case 7: p_rStat |= R_ON_8;
-                    break;
-         }
-         p_currR++;
+   static const char p_marker[] = "Relay-0";
+   static const char p_offColour[] = "FF0000";
+   const unsigned p_lenMarker = sizeof(p_marker) - 1;
+   const unsigned p_lenColour = sizeof(p_offColour) - 1;
+   for (size_t i = 0; i < p_szChunk; i++) {
+      // the characters that cannot change the state of the automaton are skipped
+      if (p_pState -> p_state == P_RS_SKIP) {
+         i += K_findCh(p_szChunk - i, p_chunk + i,
+                       '#');
+         if (i == p_szChunk)
+            return;
+      }
+      else if (p_pState -> p_state == P_RS_LINE &&
+               !(p_pState -> p_numMatch))
+         i += p_skipTo(p_szChunk - i, p_chunk + i,
+                       p_lenMarker, p_marker);
+      const char p_ch = p_chunk[i];
+      switch (p_pState -> p_state) {
+         case P_RS_LINE:   // matching the marker (no proper prefix of the marker is also a suffix)
+                           if (p_ch == p_marker[p_pState -> p_numMatch]) {
+                              p_pState -> p_numMatch++;
+                              if (p_pState -> p_numMatch == p_lenMarker)
+                                 p_pState -> p_state = P_RS_SEP;
+                           }
+                           else
+                              p_pState -> p_numMatch = p_ch == p_marker[0] ? 1
+                                                                           : 0;
+                           break;
+         case P_RS_SEP:    // the identifier of the relay
+                           p_pState -> p_chID = p_ch;
+                           p_pState -> p_state = P_RS_SKIP;
+                           break;
+         case P_RS_SKIP:   // discarding everything up to the beginning of the colour
+                           if (p_ch == '#') {
+                              p_pState -> p_numMatch = 0;
+                              p_pState -> p_fDiff = false;
+                              p_pState -> p_state = P_RS_STAT;
+                           }
+                           break;
+         case P_RS_STAT:   // the colour
+                           if (p_ch != p_offColour[p_pState -> p_numMatch])
+                              p_pState -> p_fDiff = true;
+                           p_pState -> p_numMatch++;
+                           if (p_pState -> p_numMatch == p_lenColour) {
+                              if (p_pState -> p_fDiff)
+                                 p_pState -> p_stat = p_extrStat(p_pState -> p_chID,
+                                                                 p_pState -> p_stat);
+                              if (p_pState -> p_chID >= '1' &&
+                                  p_pState -> p_chID <= '8')
+                                 p_pState -> p_seen |= 1U << (p_pState -> p_chID - '1');
+                              p_pState -> p_numMatch = 0;
+                              p_pState -> p_state = P_RS_LINE;
+                              // every relay has been described
+                              if (p_pState -> p_seen == 0xFF) {
+                                 p_pState -> p_fDone = true;
+                                 return;
+                              }
+                           }
       }
-      if (*(p_targ + i) == '0')
-         p_currR++;
    }
-   return p_rStat;
 }
 
-static r_stat p_extrStat_NC800(const char p_chID,
-                               r_stat p_rStat)
+static size_t p_skipTo(size_t p_szChunk, const char* const p_chunk,
+                       size_t p_lenMarker, const char* const p_marker)
+{
+   const size_t p_pos = K_findMarker(p_szChunk, p_chunk,
+                                     p_lenMarker, p_marker);
+   if (p_pos < p_szChunk)
+      return p_pos;
+   // a truncated occurrence is handled by the automaton
+   return p_szChunk >= p_lenMarker ? p_szChunk - p_lenMarker + 1
+                                   : 0;
+}
+
+static r_stat p_extrStat(const char p_chID,
+                         r_stat p_rStat)
 {
    switch (p_chID) {
       case '1': p_rStat |= R_ON_1;
@@ -275,9 +514,11 @@ static int p_checkWord(unsigned p_wPos,
    int p_errCode = wRC_Cd_noError;
    switch (p_wPos) {
       case 0:  switch (p_checkFstW(p_pWord)) {
-                  case p_turn: break;
-                  case p_quit: p_pIntData -> p_oAct = oAct_quit;
-                               break;
+                  case p_turn:   break;
+                  case p_quit:   p_pIntData -> p_oAct = oAct_quit;
+                                 break;
+                  case p_status: p_pIntData -> p_oAct = oAct_status;
+                                 break;
                   default: p_errCode = wRC_Cd_wrI;
                }
                break;
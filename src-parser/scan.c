@@ -0,0 +1,210 @@
+/**************************************/
+/* Author: Pavlo Nykolyn              */
+/* Last modification date: 17/10/2026 */
+/**************************************/
+
+#include <string.h>
+#include "scan.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define K_X86
+#include <immintrin.h>
+#endif
+
+// the signatures of the kernels
+typedef size_t (*k_findCh_t)(size_t k_szBuf, const char* const k_buf,
+                             char k_ch);
+typedef size_t (*k_findMarker_t)(size_t k_szBuf, const char* const k_buf,
+                                 size_t k_lenMarker, const char* const k_marker);
+
+static const char* k_names[K_numKernels] = {"scalar", "sse2", "avx2"};
+
+static size_t k_findCh_scalar(size_t k_szBuf, const char* const k_buf,
+                              char k_ch);
+static size_t k_findMarker_scalar(size_t k_szBuf, const char* const k_buf,
+                                  size_t k_lenMarker, const char* const k_marker);
+#ifdef K_X86
+static size_t k_findCh_sse2(size_t k_szBuf, const char* const k_buf,
+                            char k_ch);
+static size_t k_findMarker_sse2(size_t k_szBuf, const char* const k_buf,
+                                size_t k_lenMarker, const char* const k_marker);
+static size_t k_findCh_avx2(size_t k_szBuf, const char* const k_buf,
+                            char k_ch);
+static size_t k_findMarker_avx2(size_t k_szBuf, const char* const k_buf,
+                                size_t k_lenMarker, const char* const k_marker);
+#endif
+
+// the kernels currently selected (the scalar ones until the program has been loaded)
+static enum K_kernels k_curr = K_scalar;
+static k_findCh_t k_findCh = k_findCh_scalar;
+static k_findMarker_t k_findMarker = k_findMarker_scalar;
+
+// selects the best kernel supported by the processor
+__attribute__((constructor))
+static void k_autoSelect(void)
+{
+   if (!K_select(K_avx2))
+      K_select(K_sse2);
+}
+
+bool K_select(enum K_kernels k_kern)
+{
+   switch (k_kern) {
+      case K_scalar: k_findCh = k_findCh_scalar;
+                     k_findMarker = k_findMarker_scalar;
+                     break;
+#ifdef K_X86
+      case K_sse2:   __builtin_cpu_init();
+                     if (!__builtin_cpu_supports("sse2"))
+                        return false;
+                     k_findCh = k_findCh_sse2;
+                     k_findMarker = k_findMarker_sse2;
+                     break;
+      case K_avx2:   __builtin_cpu_init();
+                     if (!__builtin_cpu_supports("avx2"))
+                        return false;
+                     k_findCh = k_findCh_avx2;
+                     k_findMarker = k_findMarker_avx2;
+                     break;
+#endif
+      default:       return false;
+   }
+   k_curr = k_kern;
+   return true;
+}
+
+enum K_kernels K_current(void)
+{
+   return k_curr;
+}
+
+const char* K_name(enum K_kernels k_kern)
+{
+   if (k_kern >= K_numKernels)
+      return (const char*) 0;
+   return k_names[k_kern];
+}
+
+size_t K_findCh(size_t k_szBuf, const char* const k_buf,
+                char k_ch)
+{
+   return k_findCh(k_szBuf, k_buf,
+                   k_ch);
+}
+
+size_t K_findMarker(size_t k_szBuf, const char* const k_buf,
+                    size_t k_lenMarker, const char* const k_marker)
+{
+   if (k_lenMarker < 2 ||
+       k_lenMarker > k_szBuf)
+      return k_szBuf;
+   return k_findMarker(k_szBuf, k_buf,
+                       k_lenMarker, k_marker);
+}
+
+static size_t k_findCh_scalar(size_t k_szBuf, const char* const k_buf,
+                              char k_ch)
+{
+   size_t i = 0;
+   while (i < k_szBuf &&
+          k_buf[i] != k_ch)
+      i++;
+   return i;
+}
+
+static size_t k_findMarker_scalar(size_t k_szBuf, const char* const k_buf,
+                                  size_t k_lenMarker, const char* const k_marker)
+{
+   for (size_t i = 0; i + k_lenMarker <= k_szBuf; i++) {
+      if (k_buf[i] == k_marker[0] &&
+          !memcmp(k_buf + i + 1, k_marker + 1, k_lenMarker - 1))
+         return i;
+   }
+   return k_szBuf;
+}
+
+#ifdef K_X86
+// the vector kernels compare the first and the last character of the marker at once
+// (as a consequence, only few candidates are verified by memcmp)
+__attribute__((target("sse2")))
+static size_t k_findCh_sse2(size_t k_szBuf, const char* const k_buf,
+                            char k_ch)
+{
+   const __m128i k_vCh = _mm_set1_epi8(k_ch);
+   size_t i = 0;
+   for (; i + 16 <= k_szBuf; i += 16) {
+      const __m128i k_vBuf = _mm_loadu_si128((const __m128i*) (k_buf + i));
+      const unsigned k_mask = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(k_vBuf, k_vCh));
+      if (k_mask)
+         return i + __builtin_ctz(k_mask);
+   }
+   return i + k_findCh_scalar(k_szBuf - i, k_buf + i,
+                              k_ch);
+}
+
+__attribute__((target("sse2")))
+static size_t k_findMarker_sse2(size_t k_szBuf, const char* const k_buf,
+                                size_t k_lenMarker, const char* const k_marker)
+{
+   const size_t k_offLast = k_lenMarker - 1;
+   const __m128i k_vFirst = _mm_set1_epi8(k_marker[0]);
+   const __m128i k_vLast = _mm_set1_epi8(k_marker[k_offLast]);
+   size_t i = 0;
+   for (; i + k_offLast + 16 <= k_szBuf; i += 16) {
+      const __m128i k_vFstBuf = _mm_loadu_si128((const __m128i*) (k_buf + i));
+      const __m128i k_vLstBuf = _mm_loadu_si128((const __m128i*) (k_buf + i + k_offLast));
+      unsigned k_mask = (unsigned) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(k_vFstBuf, k_vFirst),
+                                                                   _mm_cmpeq_epi8(k_vLstBuf, k_vLast)));
+      while (k_mask) {
+         const size_t k_pos = i + __builtin_ctz(k_mask);
+         if (!memcmp(k_buf + k_pos + 1, k_marker + 1, k_lenMarker - 2))
+            return k_pos;
+         k_mask &= k_mask - 1;
+      }
+   }
+   const size_t k_posTail = k_findMarker_scalar(k_szBuf - i, k_buf + i,
+                                                k_lenMarker, k_marker);
+   return i + k_posTail;
+}
+
+__attribute__((target("avx2")))
+static size_t k_findCh_avx2(size_t k_szBuf, const char* const k_buf,
+                            char k_ch)
+{
+   const __m256i k_vCh = _mm256_set1_epi8(k_ch);
+   size_t i = 0;
+   for (; i + 32 <= k_szBuf; i += 32) {
+      const __m256i k_vBuf = _mm256_loadu_si256((const __m256i*) (k_buf + i));
+      const unsigned k_mask = (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(k_vBuf, k_vCh));
+      if (k_mask)
+         return i + __builtin_ctz(k_mask);
+   }
+   return i + k_findCh_sse2(k_szBuf - i, k_buf + i,
+                            k_ch);
+}
+
+__attribute__((target("avx2")))
+static size_t k_findMarker_avx2(size_t k_szBuf, const char* const k_buf,
+                                size_t k_lenMarker, const char* const k_marker)
+{
+   const size_t k_offLast = k_lenMarker - 1;
+   const __m256i k_vFirst = _mm256_set1_epi8(k_marker[0]);
+   const __m256i k_vLast = _mm256_set1_epi8(k_marker[k_offLast]);
+   size_t i = 0;
+   for (; i + k_offLast + 32 <= k_szBuf; i += 32) {
+      const __m256i k_vFstBuf = _mm256_loadu_si256((const __m256i*) (k_buf + i));
+      const __m256i k_vLstBuf = _mm256_loadu_si256((const __m256i*) (k_buf + i + k_offLast));
+      unsigned k_mask = (unsigned) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(k_vFstBuf, k_vFirst),
+                                                                         _mm256_cmpeq_epi8(k_vLstBuf, k_vLast)));
+      while (k_mask) {
+         const size_t k_pos = i + __builtin_ctz(k_mask);
+         if (!memcmp(k_buf + k_pos + 1, k_marker + 1, k_lenMarker - 2))
+            return k_pos;
+         k_mask &= k_mask - 1;
+      }
+   }
+   const size_t k_posTail = k_findMarker_sse2(k_szBuf - i, k_buf + i,
+                                              k_lenMarker, k_marker);
+   return i + k_posTail;
+}
+#endif
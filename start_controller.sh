@@ -1,5 +1,5 @@
 # Author: Pavlo Nykolyn
-# starts either one or multiple (sequential) invocations of the controller
+# pulses one or multiple relays of an array through a single invocation of the controller
 # the following environment variables are expected to be defined:
 # 1) RELAY_ARRAY_CONFIGURATION
 #    the format of the value shall be:
@@ -8,6 +8,15 @@
 #    the format of the value shall be:
 #    <id>{ <id>}
 #    each identifier shall belong to the interval [1, 8]
+# the following environment variables are optional:
+# 3) METRICS_FILE
+#    path of the file that receives the metrics of the requests in the Prometheus text format
+#    (for instance, within the directory of the textfile collector of the node exporter)
+# 4) OUTPUT_FORMAT
+#    the format of the records appended to the log: text (the default), json, tsv or raw
+# 5) SCHEDULE_FILE
+#    path of a schedule: the controller runs it until it is stopped (IDS is then ignored) instead
+#    of pulsing the relays once
 # this scripts expects the existence of a logs sub-directory within the current
 # working directory
 logfile="./logs/relay_controller.txt"
@@ -27,7 +36,7 @@ then
    case "${err}"
    in
       1) msg='only three arguments shall be supplied' ;;
-      2) msg='the format of the IPv4 address is not correct' ;;
+      2) msg='the address is neither an IPv4 address, a host name nor a bracketed IPv6 address' ;;
       3) msg='either the format or the value of the port is not correct' ;;
       4) msg='the model of the web relay controller is not supported' ;;
    esac
@@ -39,12 +48,29 @@ ip_address=$(echo "${RELAY_ARRAY_CONFIGURATION}" | cut '--delimiter=;' '--fields
 port=$(echo "${RELAY_ARRAY_CONFIGURATION}" | cut '--delimiter=;' '--fields=2')
 model=$(echo "${RELAY_ARRAY_CONFIGURATION}" | cut '--delimiter=;' '--fields=3')
 # creating the configuration option list
-option_list="--behaviour=single --ipv4=${ip_address} --model=${model}"
+option_list="--behaviour=pulse --ipv4=${ip_address} --model=${model}"
 if [ "${model}" = 'NC800' ]
 then
    option_list="${option_list} --port=${port}"
 fi
+if [ -n "${METRICS_FILE}" ]
+then
+   option_list="${option_list} --metrics-file=${METRICS_FILE}"
+fi
+if [ -n "${OUTPUT_FORMAT}" ]
+then
+   option_list="${option_list} --output=${OUTPUT_FORMAT}"
+fi
+
+if [ -n "${SCHEDULE_FILE}" ]
+then
+   # the controller replaces the shell, so that it receives SIGTERM when the container is stopped
+   myLogger '[INF]' "running the schedule ${SCHEDULE_FILE} on ${ip_address} ..."
+   exec ./bin/wRCtrl ${option_list/pulse/cron} "--schedule=${SCHEDULE_FILE}" >> "${logfile}"
+fi
 
+# every relay is pulsed for ten seconds; the pulses overlap
+pulse_list=
 for id in ${IDS}
 do
    parse_id=$(echo "${id}" | sed -n '/^[1-8]$/p')
@@ -53,9 +79,7 @@ do
       myLogger '[ERR]' "${id} does not belong to the interval [1, 8]"
       exit 1
    fi
-   myLogger '[INF]' "turning on relay ${id} of ${ip_address} ..."
-   ./bin/wRCtrl ${option_list} "--mnemonic-code=t_on_${id}" >> "${logfile}"
-   sleep 10s
-   myLogger '[INF]' "turning off relay ${id} of ${ip_address} ..."
-   ./bin/wRCtrl ${option_list} "--mnemonic-code=t_off_${id}" >> "${logfile}"
+   pulse_list="${pulse_list:+${pulse_list},}${id}:10s"
 done
+myLogger '[INF]' "pulsing relays ${IDS} of ${ip_address} ..."
+./bin/wRCtrl ${option_list} "--pulse=${pulse_list}" >> "${logfile}"